@@ -0,0 +1,566 @@
+//
+//  factorial_archive.c
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Writing runs as factorial_pipeline.c does, with blocks in place of rows: the calling
+//  thread computes n! and copies it into the block being filled, a worker formats and
+//  deflates each full block, and a writer thread appends them to the file in order
+//  while it builds the index. A ring of "depth" blocks moves free -> queued -> ready ->
+//  free, and each block keeps its snapshots, text and compressed buffers for the next
+//  rows it holds. With no workers, for --memprof, every stage runs in turn in the
+//  calling thread.
+//
+//  Reading looks the block up in the index by binary search and inflates it alone.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <zlib.h>
+#include <gmp.h>
+
+#include "factorial_archive.h"
+#include "factorial_gmp.h"
+#include "factorial_stats.h"
+
+//  Text of a row beyond its digits: "n!: ", the padding of short values and '\n'.
+#define ROW_OVERHEAD 48
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct block
+enum block_state { BLOCK_FREE, BLOCK_QUEUED, BLOCK_READY, };
+
+struct block {
+  enum block_state state;
+  uint64_t         first;
+  uint64_t         rows;
+  uint64_t         capacity;
+  mpz_t *          values;
+  size_t           estimate;
+  char *           raw;
+  size_t           raw_size;
+  size_t           raw_capacity;
+  unsigned char *  packed;
+  size_t           packed_size;
+  size_t           packed_capacity;
+  bool             encoded;
+};
+typedef struct block block;
+
+//  MARK: struct archive
+//  Blocks are counted from 0. produced, claimed and written only grow; the index,
+//  offset and byte count belong to the writer.
+struct archive {
+  pthread_mutex_t lock;
+  pthread_cond_t  queued;     //  a block was produced, or the producer is done
+  pthread_cond_t  ready;      //  a block was compressed
+  pthread_cond_t  freed;      //  a block was written
+  FILE *          out;
+  block *         blocks;
+  unsigned        depth;
+  bool            threaded;
+  uint64_t        produced;
+  uint64_t        claimed;
+  uint64_t        written;
+  bool            done;
+  bool            failed;
+  archive_entry * index;
+  uint64_t        index_capacity;
+  uint64_t        offset;
+  uint64_t        raw_bytes;
+};
+typedef struct archive archive;
+
+//  MARK: - Prototypes
+static block * claim_block(archive * ar);
+static void submit_block(archive * ar, block * bk);
+static void fail_archive(archive * ar);
+static void * worker_thread(void * arg);
+static void * writer_thread(void * arg);
+static bool block_append(block * bk, mpz_srcptr pf);
+static bool block_encode(block * bk);
+static bool block_write(archive * ar, block const * bk);
+static void block_release(block * bk);
+static bool grow(void * buffer, size_t * capacity, size_t need);
+
+// MARK: - Implementation
+/*
+ *  MARK: archive_write_gmp()
+ *
+ *  Write the rows nbegin! to nend! of fact_gmp() to an archive at path, compressing
+ *  the blocks in "workers" threads. Returns false, having reported why, if the
+ *  archive could not be written.
+ */
+bool archive_write_gmp(char const * path, uint64_t nbegin, uint64_t nend, unsigned workers, archive_summary * summary) {
+
+  double start = stats_seconds();
+  archive ar = { .depth = workers > 0 ? workers * ARCHIVE_DEPTH_PER_WORKER : 1, .offset = sizeof(ARCHIVE_MAGIC) - 1, };
+  pthread_t writer;
+  pthread_t threads[ARCHIVE_WORKERS_MAX];
+  unsigned started = 0;
+  block * bk = NULL;
+  mpz_t pf;
+
+  memset(summary, 0, sizeof(*summary));
+  ar.out = fopen(path, "wb");
+  if (ar.out == NULL) {
+    perror(path);
+    return false;
+  }
+  ar.blocks = calloc(ar.depth, sizeof(*ar.blocks));
+  if (ar.blocks == NULL || fwrite(ARCHIVE_MAGIC, 1, ar.offset, ar.out) != ar.offset) {
+    perror(path);
+    free(ar.blocks);
+    fclose(ar.out);
+    return false;
+  }
+  pthread_mutex_init(&ar.lock, NULL);
+  pthread_cond_init(&ar.queued, NULL);
+  pthread_cond_init(&ar.ready, NULL);
+  pthread_cond_init(&ar.freed, NULL);
+
+  //  Without a worker the writer has nothing to wait for; it is stopped at once.
+  if (workers > 0 && pthread_create(&writer, NULL, writer_thread, &ar) == 0) {
+    while (started < workers && started < ARCHIVE_WORKERS_MAX && pthread_create(&threads[started], NULL, worker_thread, &ar) == 0) {
+      ++started;
+    }
+    ar.threaded = started > 0;
+    if (!ar.threaded) {
+      pthread_mutex_lock(&ar.lock);
+      ar.done = true;
+      pthread_cond_broadcast(&ar.ready);
+      pthread_mutex_unlock(&ar.lock);
+      pthread_join(writer, NULL);
+    }
+  }
+  summary->workers = started;
+
+  mpz_init(pf);
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    if (nb == nbegin) {
+      gmp_fact_swing(pf, nb);
+    }
+    else {
+      mpz_mul_ui(pf, pf, nb);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      STATS_COUNT(STATS_LIMB_OPS, mpz_size(pf));
+    }
+
+    if (bk == NULL && (bk = claim_block(&ar)) == NULL) {
+      break;
+    }
+    if (bk->rows == 0) {
+      bk->first = nb;
+    }
+    if (!block_append(bk, pf)) {
+      fail_archive(&ar);
+      break;
+    }
+    if (bk->estimate >= ARCHIVE_BLOCK_BYTES || nb == nend) {
+      submit_block(&ar, bk);
+      bk = NULL;
+    }
+  }
+  mpz_clear(pf);
+
+  if (ar.threaded) {
+    pthread_mutex_lock(&ar.lock);
+    ar.done = true;
+    pthread_cond_broadcast(&ar.queued);
+    pthread_cond_broadcast(&ar.ready);
+    pthread_mutex_unlock(&ar.lock);
+    for (unsigned t_ = 0; t_ < started; ++t_) {
+      pthread_join(threads[t_], NULL);
+    }
+    pthread_join(writer, NULL);
+  }
+
+  //  The index and trailer follow the last block.
+  archive_trailer trailer = { .nbegin = nbegin, .nend = nend, .blocks = ar.written, .index = ar.offset, };
+  memcpy(trailer.magic, ARCHIVE_MAGIC, sizeof(trailer.magic));
+  bool complete = !ar.failed
+               && fwrite(ar.index, sizeof(*ar.index), ar.written, ar.out) == ar.written
+               && fwrite(&trailer, sizeof(trailer), 1, ar.out) == 1;
+  complete = fclose(ar.out) == 0 && complete;
+  if (!complete) {
+    perror(path);
+  }
+  STATS_COUNT(STATS_BYTES_FORMATTED, ar.raw_bytes);
+
+  summary->rows = nend >= nbegin ? nend - nbegin + 1 : 0;
+  summary->blocks = ar.written;
+  summary->blocks_total = ar.written;
+  summary->raw_bytes = ar.raw_bytes;
+  summary->stored_bytes = ar.offset + ar.written * sizeof(*ar.index) + sizeof(trailer);
+  summary->seconds = stats_seconds() - start;
+
+  for (unsigned b_ = 0; b_ < ar.depth; ++b_) {
+    block_release(&ar.blocks[b_]);
+  }
+  free(ar.blocks);
+  free(ar.index);
+  pthread_cond_destroy(&ar.freed);
+  pthread_cond_destroy(&ar.ready);
+  pthread_cond_destroy(&ar.queued);
+  pthread_mutex_destroy(&ar.lock);
+
+  return complete;
+}
+
+/*
+ *  MARK: archive_read_rows()
+ *
+ *  Write the rows nbegin! to nend! of the archive at path to out, inflating only the
+ *  blocks that hold them. Returns false, having reported why, if the file is not an
+ *  archive holding them all or cannot be read.
+ */
+bool archive_read_rows(FILE * out, char const * path, uint64_t nbegin, uint64_t nend, archive_summary * summary) {
+
+  double start = stats_seconds();
+  FILE * in = fopen(path, "rb");
+  char magic[sizeof(ARCHIVE_MAGIC) - 1];
+  archive_trailer trailer;
+  archive_entry * index = NULL;
+  unsigned char * packed = NULL;
+  size_t packed_capacity = 0;
+  char * raw = NULL;
+  size_t raw_capacity = 0;
+  bool fine = false;
+
+  memset(summary, 0, sizeof(*summary));
+  if (in == NULL) {
+    perror(path);
+    return false;
+  }
+  if (fread(magic, 1, sizeof(magic), in) != sizeof(magic) || memcmp(magic, ARCHIVE_MAGIC, sizeof(magic)) != 0
+   || fseeko(in, -(off_t) sizeof(trailer), SEEK_END) != 0 || fread(&trailer, sizeof(trailer), 1, in) != 1
+   || memcmp(trailer.magic, ARCHIVE_MAGIC, sizeof(trailer.magic)) != 0
+   || (uint64_t) ftello(in) != trailer.index + trailer.blocks * sizeof(*index) + sizeof(trailer)) {
+    fprintf(stderr, "%s: not a factorial archive\n", path);
+  }
+  else if (nbegin < trailer.nbegin || nend > trailer.nend || nend < nbegin) {
+    fprintf(stderr, "%s: holds %" PRIu64 "! to %" PRIu64 "! only\n", path, trailer.nbegin, trailer.nend);
+  }
+  else if ((index = malloc(trailer.blocks * sizeof(*index))) == NULL
+        || fseeko(in, (off_t) trailer.index, SEEK_SET) != 0
+        || fread(index, sizeof(*index), trailer.blocks, in) != trailer.blocks) {
+    perror(path);
+  }
+  else {
+    //  The last block whose first row is not after nbegin.
+    uint64_t lo = 0;
+    uint64_t hi = trailer.blocks;
+    while (hi - lo > 1) {
+      uint64_t mid = lo + (hi - lo) / 2;
+      if (index[mid].first <= nbegin) {
+        lo = mid;
+      }
+      else {
+        hi = mid;
+      }
+    }
+
+    fine = true;
+    summary->blocks_total = trailer.blocks;
+    for (uint64_t b_ = lo; fine && b_ < trailer.blocks && index[b_].first <= nend; ++b_) {
+      archive_entry const * en = &index[b_];
+      uLongf length = (uLongf) en->raw;
+      fine = grow(&packed, &packed_capacity, en->stored) && grow(&raw, &raw_capacity, en->raw)
+          && fseeko(in, (off_t) en->offset, SEEK_SET) == 0 && fread(packed, 1, en->stored, in) == en->stored;
+      if (!fine) {
+        perror(path);
+        break;
+      }
+      if (uncompress((Bytef *) raw, &length, packed, (uLong) en->stored) != Z_OK || length != en->raw) {
+        fprintf(stderr, "%s: block %" PRIu64 " is damaged\n", path, b_);
+        fine = false;
+        break;
+      }
+      ++summary->blocks;
+      summary->raw_bytes += en->raw;
+      summary->stored_bytes += en->stored;
+
+      char const * at = raw;
+      char const * end = raw + en->raw;
+      for (uint64_t nb = en->first; fine && at < end && nb <= nend; ++nb) {
+        char const * eol = memchr(at, '\n', (size_t) (end - at));
+        size_t span = eol != NULL ? (size_t) (eol - at) + 1 : (size_t) (end - at);
+        if (nb >= nbegin) {
+          fine = fwrite(at, 1, span, out) == span;
+          ++summary->rows;
+        }
+        at += span;
+      }
+    }
+  }
+  free(raw);
+  free(packed);
+  free(index);
+  fclose(in);
+  summary->seconds = stats_seconds() - start;
+
+  return fine && summary->rows == nend - nbegin + 1;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: claim_block()
+ *
+ *  The block to fill next, once it is free, or NULL if the archive has failed.
+ */
+static block * claim_block(archive * ar) {
+
+  if (!ar->threaded) {
+    return ar->failed ? NULL : &ar->blocks[0];
+  }
+
+  pthread_mutex_lock(&ar->lock);
+  while (ar->produced - ar->written >= ar->depth && !ar->failed) {
+    pthread_cond_wait(&ar->freed, &ar->lock);
+  }
+  bool failed = ar->failed;
+  pthread_mutex_unlock(&ar->lock);
+
+  //  The block is free, and only the producer touches free blocks.
+  return failed ? NULL : &ar->blocks[ar->produced % ar->depth];
+}
+
+/*
+ *  MARK: submit_block()
+ *
+ *  Queue a filled block for the workers, or without them compress and write it here.
+ */
+static void submit_block(archive * ar, block * bk) {
+
+  if (!ar->threaded) {
+    bk->encoded = block_encode(bk);
+    ar->failed = !bk->encoded || !block_write(ar, bk);
+    bk->rows = 0;
+    bk->estimate = 0;
+    ++ar->produced;
+    ++ar->written;
+    return;
+  }
+
+  pthread_mutex_lock(&ar->lock);
+  bk->state = BLOCK_QUEUED;
+  ++ar->produced;
+  pthread_cond_signal(&ar->queued);
+  pthread_mutex_unlock(&ar->lock);
+
+  return;
+}
+
+/*
+ *  MARK: fail_archive()
+ */
+static void fail_archive(archive * ar) {
+
+  pthread_mutex_lock(&ar->lock);
+  ar->failed = true;
+  pthread_cond_broadcast(&ar->freed);
+  pthread_mutex_unlock(&ar->lock);
+
+  return;
+}
+
+/*
+ *  MARK: worker_thread()
+ */
+static void * worker_thread(void * arg) {
+
+  archive * ar = (archive *) arg;
+
+  pthread_mutex_lock(&ar->lock);
+  for (;;) {
+    while (ar->claimed == ar->produced && !ar->done) {
+      pthread_cond_wait(&ar->queued, &ar->lock);
+    }
+    if (ar->claimed == ar->produced) {
+      break;
+    }
+    block * bk = &ar->blocks[ar->claimed++ % ar->depth];
+    pthread_mutex_unlock(&ar->lock);
+
+    bool encoded = block_encode(bk);
+
+    pthread_mutex_lock(&ar->lock);
+    bk->encoded = encoded;
+    bk->state = BLOCK_READY;
+    pthread_cond_broadcast(&ar->ready);
+  }
+  pthread_mutex_unlock(&ar->lock);
+
+  return NULL;
+}
+
+/*
+ *  MARK: writer_thread()
+ *
+ *  After a failure the blocks are still taken, and dropped, so that no stage waits on
+ *  the writer.
+ */
+static void * writer_thread(void * arg) {
+
+  archive * ar = (archive *) arg;
+
+  pthread_mutex_lock(&ar->lock);
+  for (;;) {
+    block * bk = &ar->blocks[ar->written % ar->depth];
+    while ((ar->written == ar->produced || bk->state != BLOCK_READY) && !(ar->done && ar->written == ar->produced)) {
+      pthread_cond_wait(&ar->ready, &ar->lock);
+    }
+    if (ar->written == ar->produced) {
+      break;
+    }
+    bool failed = ar->failed;
+    pthread_mutex_unlock(&ar->lock);
+
+    bool written = !failed && bk->encoded && block_write(ar, bk);
+
+    pthread_mutex_lock(&ar->lock);
+    ar->failed = ar->failed || !written;
+    bk->rows = 0;
+    bk->estimate = 0;
+    bk->state = BLOCK_FREE;
+    ++ar->written;
+    pthread_cond_signal(&ar->freed);
+  }
+  pthread_mutex_unlock(&ar->lock);
+
+  return NULL;
+}
+
+/*
+ *  MARK: block_append()
+ *
+ *  Copy pf into the next snapshot of bk; mpz_set() reuses the limbs of earlier rows.
+ */
+static bool block_append(block * bk, mpz_srcptr pf) {
+
+  if (bk->rows == bk->capacity) {
+    uint64_t capacity = bk->capacity > 0 ? 2 * bk->capacity : 64;
+    mpz_t * values = realloc(bk->values, capacity * sizeof(*values));
+    if (values == NULL) {
+      return false;
+    }
+    for (uint64_t v_ = bk->capacity; v_ < capacity; ++v_) {
+      mpz_init(values[v_]);
+    }
+    bk->values = values;
+    bk->capacity = capacity;
+  }
+  mpz_set(bk->values[bk->rows++], pf);
+  bk->estimate += mpz_sizeinbase(pf, 10) + ROW_OVERHEAD;
+
+  return true;
+}
+
+/*
+ *  MARK: block_encode()
+ *
+ *  Format the rows of bk as fact_gmp() does and deflate them.
+ */
+static bool block_encode(block * bk) {
+
+  if (!grow(&bk->raw, &bk->raw_capacity, bk->estimate + 1)) {
+    return false;
+  }
+
+  char * at = bk->raw;
+  for (uint64_t r_ = 0; r_ < bk->rows; ++r_) {
+    at += snprintf(at, ROW_OVERHEAD, "%6" PRIu64 "!: ", bk->first + r_);
+    mpz_get_str(at, 10, bk->values[r_]);
+    size_t digits = strlen(at);
+    if (digits < 20) {
+      memmove(at + 20 - digits, at, digits);
+      memset(at, ' ', 20 - digits);
+      digits = 20;
+    }
+    at += digits;
+    *at++ = '\n';
+  }
+  bk->raw_size = (size_t) (at - bk->raw);
+
+  uLong bound = compressBound((uLong) bk->raw_size);
+  uLongf packed_size = bound;
+  if (!grow(&bk->packed, &bk->packed_capacity, bound)
+   || compress2(bk->packed, &packed_size, (Bytef const *) bk->raw, (uLong) bk->raw_size, Z_DEFAULT_COMPRESSION) != Z_OK) {
+    return false;
+  }
+  bk->packed_size = packed_size;
+
+  return true;
+}
+
+/*
+ *  MARK: block_write()
+ *
+ *  Append the compressed bk to the archive and its entry to the index.
+ */
+static bool block_write(archive * ar, block const * bk) {
+
+  if (ar->written == ar->index_capacity) {
+    size_t capacity = (size_t) ar->index_capacity * sizeof(*ar->index);
+    if (!grow(&ar->index, &capacity, capacity > 0 ? 2 * capacity : 64 * sizeof(*ar->index))) {
+      return false;
+    }
+    ar->index_capacity = capacity / sizeof(*ar->index);
+  }
+  if (fwrite(bk->packed, 1, bk->packed_size, ar->out) != bk->packed_size) {
+    return false;
+  }
+  ar->index[ar->written] = (archive_entry) {
+    .first = bk->first, .rows = bk->rows, .offset = ar->offset, .stored = bk->packed_size, .raw = bk->raw_size,
+  };
+  ar->offset += bk->packed_size;
+  ar->raw_bytes += bk->raw_size;
+
+  return true;
+}
+
+/*
+ *  MARK: block_release()
+ */
+static void block_release(block * bk) {
+
+  for (uint64_t v_ = 0; v_ < bk->capacity; ++v_) {
+    mpz_clear(bk->values[v_]);
+  }
+  free(bk->values);
+  free(bk->raw);
+  free(bk->packed);
+
+  return;
+}
+
+/*
+ *  MARK: grow()
+ *
+ *  Enlarge the malloc'd *buffer, of *capacity bytes, to hold need bytes.
+ */
+static bool grow(void * buffer, size_t * capacity, size_t need) {
+
+  if (need <= *capacity) {
+    return true;
+  }
+  void ** slot = (void **) buffer;
+  void * larger = realloc(*slot, need);
+  if (larger == NULL) {
+    return false;
+  }
+  *slot = larger;
+  *capacity = need;
+
+  return true;
+}
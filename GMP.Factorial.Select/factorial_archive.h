@@ -0,0 +1,81 @@
+//
+//  factorial_archive.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Compressed, indexed archives of sweeps. The rows of fact_gmp() are gathered into
+//  blocks of about ARCHIVE_BLOCK_BYTES of text, each deflated on its own by zlib in a
+//  pool of worker threads, and an index of the first n and file offset of every block
+//  follows them, so that a row is read back by inflating only the block holding it.
+//
+//  Layout, in native byte order:
+//    ARCHIVE_MAGIC                    8 bytes
+//    block 0 ... block count - 1      zlib streams of whole rows "n!: digits\n"
+//    archive_entry[count]             first n, rows, offset, stored and raw bytes
+//    archive_trailer                  nbegin, nend, count, index offset, ARCHIVE_MAGIC
+//
+
+#pragma once
+#ifndef factorial_archive_h
+#define factorial_archive_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+#define ARCHIVE_MAGIC              "FACTARC1"
+//  Text gathered into a block before it is compressed; a longer row is a block alone.
+#define ARCHIVE_BLOCK_BYTES        (1 << 20)
+#define ARCHIVE_WORKERS_MAX        64
+#define ARCHIVE_DEPTH_PER_WORKER   2
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct archive_entry
+struct archive_entry {
+  uint64_t first;
+  uint64_t rows;
+  uint64_t offset;
+  uint64_t stored;
+  uint64_t raw;
+};
+typedef struct archive_entry archive_entry;
+
+//  MARK: struct archive_trailer
+struct archive_trailer {
+  uint64_t nbegin;
+  uint64_t nend;
+  uint64_t blocks;
+  uint64_t index;
+  char     magic[8];
+};
+typedef struct archive_trailer archive_trailer;
+
+//  MARK: struct archive_summary
+//  Of a write, or of a read: blocks and bytes then count only what was inflated.
+struct archive_summary {
+  unsigned workers;
+  uint64_t rows;
+  uint64_t blocks;
+  uint64_t blocks_total;
+  uint64_t raw_bytes;
+  uint64_t stored_bytes;
+  double   seconds;
+};
+typedef struct archive_summary archive_summary;
+
+//  MARK: - Prototypes
+bool archive_write_gmp(char const * path, uint64_t nbegin, uint64_t nend, unsigned workers, archive_summary * summary);
+bool archive_read_rows(FILE * out, char const * path, uint64_t nbegin, uint64_t nend, archive_summary * summary);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_archive_h */
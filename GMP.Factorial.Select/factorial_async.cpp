@@ -0,0 +1,408 @@
+//
+//  factorial_async.cpp
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  A job runs the product tree a level at a time: first the leaf products of
+//  ASYNC_LEAF consecutive factors, then pairwise merges until one product is left,
+//  then the decimal conversion. The cancellation flag is checked and progress is
+//  reported before every leaf and every merge. Progress counts each tree level, the
+//  leaves and the conversion as equal shares of the work: every level handles about
+//  the same number of bits in all.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <gmp.h>
+#include <unistd.h>
+
+#include "factorial_async.hpp"
+#include "gfg-bignum.hpp"
+#include "factorial_gmp.h"
+
+namespace factorial {
+
+//  MARK: - Definitions
+//  Factors multiplied out at each leaf of a job's product tree.
+static uint64_t const ASYNC_LEAF = 2048;
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: class gmp_num
+//  Owning mpz_t that can live in a std::vector.
+class gmp_num {
+public:
+  gmp_num() { mpz_init(value_); }
+  gmp_num(gmp_num && other) noexcept { mpz_init(value_); mpz_swap(value_, other.value_); }
+  gmp_num & operator=(gmp_num && other) noexcept { mpz_swap(value_, other.value_); return *this; }
+  gmp_num(gmp_num const &) = delete;
+  gmp_num & operator=(gmp_num const &) = delete;
+  ~gmp_num() { mpz_clear(value_); }
+
+  mpz_ptr get() { return value_; }
+  mpz_srcptr get() const { return value_; }
+
+private:
+  mpz_t value_;
+};
+
+//  MARK: struct gmp_backend
+struct gmp_backend {
+  typedef gmp_num number;
+
+  static number leaf(uint64_t lo, uint64_t hi) {
+    number product;
+    gmp_range_product(product.get(), lo, hi);
+    return product;
+  }
+  static number mul(number & lhs, number & rhs) {
+    mpz_mul(lhs.get(), lhs.get(), rhs.get());
+    return std::move(lhs);
+  }
+  static std::string decimal(number const & num) {
+    std::string text(mpz_sizeinbase(num.get(), 10) + 1, '\0');
+    mpz_get_str(&text[0], 10, num.get());
+    text.resize(std::strlen(text.c_str()));
+    return text;
+  }
+};
+
+//  MARK: struct gfg_backend
+struct gfg_backend {
+  typedef gfg::bignum number;
+
+  static number leaf(uint64_t lo, uint64_t hi) {
+    return gfg::range_product(lo, hi);
+  }
+  static number mul(number & lhs, number & rhs) {
+    return gfg::mul(lhs, rhs);
+  }
+  static std::string decimal(number const & num) {
+    std::string text(gfg::decimal_digits(num) + 1, '\0');
+    gfg::to_decimal(num, &text[0]);
+    text.resize(text.size() - 1);
+    return text;
+  }
+};
+
+//  MARK: class tracker
+//  Turns units of work done into progress reports.
+class tracker {
+public:
+  tracker(uint64_t n_fact, double units, progress_callback const & on_progress)
+    : n_fact_(n_fact), units_(units), on_progress_(on_progress),
+      start_(std::chrono::steady_clock::now()) {}
+
+  void report(double units_done) const {
+    if (on_progress_) {
+      double fraction = std::min(1.0, units_done / units_);
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+      double eta = fraction >= 0.01 ? elapsed.count() * (1.0 - fraction) / fraction : -1.0;
+      on_progress_(progress { n_fact_, fraction, eta, });
+    }
+  }
+
+private:
+  uint64_t n_fact_;
+  double units_;
+  progress_callback const & on_progress_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+//  MARK: - Prototypes
+template <typename Backend>
+static std::string run_job(uint64_t n_fact, std::atomic<bool> const & cancel_flag,
+                           progress_callback const & on_progress);
+
+//  MARK: - Implementation
+/*
+ *  MARK: cancelled::cancelled()
+ */
+cancelled::cancelled(uint64_t n_fact)
+  : std::runtime_error("factorial of " + std::to_string(n_fact) + " cancelled") {}
+
+/*
+ *  MARK: executor::executor()
+ *
+ *  Start "threads" workers, one per hardware thread if 0.
+ */
+executor::executor(unsigned threads) : stopping_(false) {
+
+  threads = threads != 0 ? threads : std::max(1U, std::thread::hardware_concurrency());
+  for (unsigned t_ = 0; t_ < threads; ++t_) {
+    threads_.emplace_back(&executor::run, this);
+  }
+}
+
+/*
+ *  MARK: executor::~executor()
+ *
+ *  Run the tasks still queued, then stop the workers.
+ */
+executor::~executor() {
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  ready_.notify_all();
+  for (std::thread & thr : threads_) {
+    thr.join();
+  }
+}
+
+/*
+ *  MARK: executor::submit()
+ */
+void executor::submit(std::function<void ()> task) {
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  ready_.notify_one();
+
+  return;
+}
+
+/*
+ *  MARK: executor::size()
+ */
+unsigned executor::size() const {
+
+  return (unsigned) threads_.size();
+}
+
+/*
+ *  MARK: executor::shared()
+ */
+executor & executor::shared() {
+
+  static executor pool;
+
+  return pool;
+}
+
+/*
+ *  MARK: executor::run()
+ */
+void executor::run() {
+
+  for (;;) {
+    std::function<void ()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+/*
+ *  MARK: job::job()
+ */
+job::job(uint64_t n_fact, std::shared_ptr<std::atomic<bool>> cancel_flag, std::future<std::string> result)
+  : n_fact_(n_fact), cancel_(std::move(cancel_flag)), result_(std::move(result)) {}
+
+uint64_t job::n_fact() const {
+
+  return n_fact_;
+}
+
+std::future<std::string> & job::result() {
+
+  return result_;
+}
+
+/*
+ *  MARK: job::cancel()
+ *
+ *  Ask the job to stop. It does so at its next leaf or merge, and its future
+ *  then holds a factorial::cancelled exception.
+ */
+void job::cancel() {
+
+  cancel_->store(true, std::memory_order_relaxed);
+
+  return;
+}
+
+bool job::cancel_requested() const {
+
+  return cancel_->load(std::memory_order_relaxed);
+}
+
+/*
+ *  MARK: factorial_async()
+ *
+ *  Queue n_fact! on "exec" and return its job. on_progress is called from the
+ *  executor's thread.
+ */
+job factorial_async(uint64_t n_fact, engine eng, progress_callback on_progress, executor & exec) {
+
+  auto cancel_flag = std::make_shared<std::atomic<bool>>(false);
+  auto promise = std::make_shared<std::promise<std::string>>();
+  job started(n_fact, cancel_flag, promise->get_future());
+
+  exec.submit([n_fact, eng, on_progress, cancel_flag, promise] {
+    try {
+      if (eng == engine::gfg) {
+        promise->set_value(run_job<gfg_backend>(n_fact, *cancel_flag, on_progress));
+      }
+      else {
+        promise->set_value(run_job<gmp_backend>(n_fact, *cancel_flag, on_progress));
+      }
+    }
+    catch (...) {
+      promise->set_exception(std::current_exception());
+    }
+  });
+
+  return started;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: run_job()
+ */
+template <typename Backend>
+static std::string run_job(uint64_t n_fact, std::atomic<bool> const & cancel_flag,
+                           progress_callback const & on_progress) {
+
+  uint64_t leaves = n_fact < 2 ? 1 : (n_fact - 2) / ASYNC_LEAF + 1;
+  double levels = std::ceil(std::log2((double) leaves));
+  tracker track(n_fact, levels + 2.0, on_progress);
+  std::vector<typename Backend::number> products;
+
+  products.reserve(leaves);
+  for (uint64_t l_ = 0; l_ < leaves; ++l_) {
+    if (cancel_flag.load(std::memory_order_relaxed)) {
+      throw cancelled(n_fact);
+    }
+    track.report((double) l_ / (double) leaves);
+    uint64_t lo = 2 + l_ * ASYNC_LEAF;
+    products.push_back(Backend::leaf(lo, std::min(n_fact, lo + ASYNC_LEAF - 1)));
+  }
+
+  for (double level = 1.0; products.size() > 1; level += 1.0) {
+    size_t count = products.size();
+    for (size_t p_ = 0; p_ < count / 2; ++p_) {
+      if (cancel_flag.load(std::memory_order_relaxed)) {
+        throw cancelled(n_fact);
+      }
+      track.report(level + (double) p_ / (double) (count / 2));
+      products[p_] = Backend::mul(products[2 * p_], products[2 * p_ + 1]);
+    }
+    if (count % 2 != 0) {
+      products[count / 2] = std::move(products[count - 1]);
+    }
+    products.resize((count + 1) / 2);
+  }
+
+  if (cancel_flag.load(std::memory_order_relaxed)) {
+    throw cancelled(n_fact);
+  }
+  track.report(levels + 1.0);
+  std::string text = Backend::decimal(products[0]);
+  track.report(levels + 2.0);
+
+  return text;
+}
+
+} /* namespace factorial */
+
+//  MARK: - C interface
+extern "C" {
+
+/*
+ *  MARK: factorial_async_table()
+ *
+ *  Display the factorials nbegin! to nend!, all queued at once on the shared executor
+ *  and shown in order as they complete. Jobs not finished "deadline_seconds" after the
+ *  start (if positive) are cancelled. Progress of the job being waited for is shown on
+ *  standard error when that is a terminal.
+ *  Returns false if any job was cancelled.
+ */
+bool factorial_async_table(uint64_t nbegin, uint64_t nend, bool use_gfg, double deadline_seconds) {
+
+  struct status {
+    std::atomic<double> fraction;
+    std::atomic<double> eta;
+  };
+
+  bool complete = true;
+  bool show_progress = isatty(STDERR_FILENO) != 0;
+  size_t count = nend >= nbegin ? (size_t) (nend - nbegin + 1) : 0;
+  std::unique_ptr<status[]> statuses(new status[count]);
+  std::vector<factorial::job> jobs;
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double>(deadline_seconds));
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {%s, %u threads}:\n\n",
+         nbegin, nend, use_gfg ? "GMP-free arithmatic" : "multiple precision arithmatic",
+         factorial::executor::shared().size());
+  jobs.reserve(count);
+  for (size_t j_ = 0; j_ < count; ++j_) {
+    status * stat = &statuses[j_];
+    stat->fraction = 0.0;
+    stat->eta = -1.0;
+    jobs.push_back(factorial::factorial_async(nbegin + j_, use_gfg ? factorial::engine::gfg : factorial::engine::gmp,
+                                              [stat](factorial::progress const & prog) {
+                                                stat->fraction = prog.fraction;
+                                                stat->eta = prog.eta_seconds;
+                                              }));
+  }
+
+  for (size_t j_ = 0; j_ < count; ++j_) {
+    factorial::job & jb = jobs[j_];
+    while (jb.result().wait_for(std::chrono::milliseconds(200)) != std::future_status::ready) {
+      if (deadline_seconds > 0.0 && std::chrono::steady_clock::now() >= deadline) {
+        for (size_t c_ = j_; c_ < count; ++c_) {
+          jobs[c_].cancel();
+        }
+      }
+      if (show_progress) {
+        fprintf(stderr, "\r%6" PRIu64 "!: %5.1f%% ETA %8.1fs", jb.n_fact(),
+                statuses[j_].fraction * 100.0, std::max(0.0, (double) statuses[j_].eta));
+      }
+    }
+    if (show_progress) {
+      fprintf(stderr, "\r%*s\r", 30, "");
+    }
+
+    try {
+      std::string text = jb.result().get();
+      printf("%6" PRIu64 "!: %20s\n", jb.n_fact(), text.c_str());
+    }
+    catch (factorial::cancelled const &) {
+      printf("%6" PRIu64 "!: %20s\n", jb.n_fact(), "*- cancelled -*");
+      complete = false;
+    }
+  }
+
+  return complete;
+}
+
+/*
+ *  MARK: factorial_async_threads()
+ *
+ *  Threads in the shared executor.
+ */
+unsigned factorial_async_threads(void) {
+
+  return factorial::executor::shared().size();
+}
+
+} /* extern "C" */
@@ -0,0 +1,118 @@
+//
+//  factorial_async.hpp
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Asynchronous, cancellable factorials for embedding the engines.
+//  factorial_async() queues n! on a shared thread pool and returns at once with a
+//  job holding a std::future for the decimal string. The computation checks for
+//  cancellation between the multiplications of its product tree and reports the
+//  fraction complete and an ETA through an optional callback.
+//
+
+#pragma once
+#ifndef factorial_async_hpp
+#define factorial_async_hpp
+
+#ifdef __cplusplus
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace factorial {
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: class cancelled
+//  Thrown from job::result().get() when the job was cancelled before it finished.
+class cancelled : public std::runtime_error {
+public:
+  explicit cancelled(uint64_t n_fact);
+};
+
+//  MARK: struct progress
+struct progress {
+  uint64_t n_fact;
+  double   fraction;     //  0.0 to 1.0
+  double   eta_seconds;  //  negative until there is enough to go on
+};
+typedef std::function<void (progress const &)> progress_callback;
+
+//  MARK: enum class engine
+enum class engine {
+  gmp,
+  gfg,
+};
+
+//  MARK: class executor
+//  A fixed pool of worker threads shared by every job, so that many concurrent
+//  requests do not each start a thread.
+class executor {
+public:
+  explicit executor(unsigned threads = 0);
+  ~executor();
+  executor(executor const &) = delete;
+  executor & operator=(executor const &) = delete;
+
+  void submit(std::function<void ()> task);
+  unsigned size() const;
+  static executor & shared();
+
+private:
+  void run();
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<std::function<void ()>> tasks_;
+  std::vector<std::thread> threads_;
+  bool stopping_;
+};
+
+//  MARK: class job
+class job {
+public:
+  job(uint64_t n_fact, std::shared_ptr<std::atomic<bool>> cancel_flag, std::future<std::string> result);
+
+  uint64_t n_fact() const;
+  std::future<std::string> & result();
+  void cancel();
+  bool cancel_requested() const;
+
+private:
+  uint64_t n_fact_;
+  std::shared_ptr<std::atomic<bool>> cancel_;
+  std::future<std::string> result_;
+};
+
+//  MARK: - Prototypes
+job factorial_async(uint64_t n_fact, engine eng = engine::gmp,
+                    progress_callback on_progress = nullptr,
+                    executor & exec = executor::shared());
+
+} /* namespace factorial */
+
+extern "C" {
+#else
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+//  MARK: - C interface for the command line
+bool factorial_async_table(uint64_t nbegin, uint64_t nend, bool use_gfg, double deadline_seconds);
+unsigned factorial_async_threads(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_async_hpp */
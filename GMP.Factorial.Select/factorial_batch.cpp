@@ -0,0 +1,327 @@
+//
+//  factorial_batch.cpp
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  The table for a width holds 0! ... Z! wrapped to the width, Z being the first n
+//  with n! = 0 mod 2^Bits (34, 66 and 130 for 32, 64 and 128 bits). An argument is
+//  clamped to Z with one vector minimum (AVX-512) or compare and blend (AVX2), and
+//  the results are gathered 8 or 4 lanes at a time, a 128-bit result as two 64-bit
+//  gathers interleaved. The overflow bits come from a vector compare with the
+//  largest exact n, 64 arguments to a mask word. Without AVX2 the same clamp and
+//  table load is a plain loop.
+//
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "factorial_batch.h"
+#include "factorial_fixed.hpp"
+#include "factorial_stats.h"
+
+namespace batch {
+
+//  MARK: - Definitions
+#if defined(__AVX512F__)
+#define BATCH_LANES 8
+#elif defined(__AVX2__)
+#define BATCH_LANES 4
+#else
+#define BATCH_LANES 1
+#endif
+
+//  MARK: - Helpers
+/*
+ *  MARK: zero_n()
+ *
+ *  Smallest n with at least "bits" factors of two in n!.
+ */
+constexpr uint64_t zero_n(unsigned bits) {
+
+  uint64_t n_ = 0;
+  unsigned twos = 0;
+
+  while (twos < bits) {
+    ++n_;
+    for (uint64_t m_ = n_; m_ % 2 == 0; m_ /= 2) {
+      ++twos;
+    }
+  }
+
+  return n_;
+}
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct wrapped_table
+//  value[i] = i! mod 2^Bits for 0 <= i <= ZERO_N, the last being 0.
+template <unsigned Bits>
+struct wrapped_table {
+  typedef typename std::conditional<Bits == 32, uint32_t,
+          typename std::conditional<Bits == 64, uint64_t, unsigned __int128>::type>::type value_type;
+
+  static constexpr uint64_t ZERO_N = zero_n(Bits);
+
+  alignas(64) value_type value[ZERO_N + 1];
+
+  constexpr wrapped_table() : value {} {
+    value_type fv = 1;
+    for (uint64_t i_ = 0; i_ <= ZERO_N; ++i_) {
+      value[i_] = fv;
+      fv = (value_type) (fv * (value_type) (i_ + 1));
+    }
+  }
+};
+
+template <unsigned Bits>
+static constexpr wrapped_table<Bits> TABLE {};
+
+static_assert(wrapped_table<32>::ZERO_N == 34 && TABLE<32>.value[34] == 0 && TABLE<32>.value[33] != 0, "34! is the first 0 mod 2^32");
+static_assert(wrapped_table<64>::ZERO_N == 66 && TABLE<64>.value[66] == 0 && TABLE<64>.value[65] != 0, "66! is the first 0 mod 2^64");
+static_assert(wrapped_table<128>::ZERO_N == 130 && TABLE<128>.value[130] == 0 && TABLE<128>.value[129] != 0, "130! is the first 0 mod 2^128");
+
+//  MARK: - Implementation
+/*
+ *  MARK: gather_word()
+ *
+ *  out[i] = n[i]! wrapped to Bits for i < count <= 64; returns the overflow mask,
+ *  bit i set when n[i] > exact.
+ */
+template <unsigned Bits>
+static uint64_t gather_word(uint64_t const n[], typename wrapped_table<Bits>::value_type out[], size_t count, uint64_t exact) {
+
+  typedef typename wrapped_table<Bits>::value_type value_type;
+  constexpr uint64_t zero = wrapped_table<Bits>::ZERO_N;
+  value_type const * table = TABLE<Bits>.value;
+  uint64_t mask = 0;
+  size_t i_ = 0;
+
+#if defined(__AVX512F__)
+  __m512i const zero_v = _mm512_set1_epi64((long long) zero);
+  __m512i const exact_v = _mm512_set1_epi64((long long) exact);
+  for (; i_ + BATCH_LANES <= count; i_ += BATCH_LANES) {
+    __m512i n_v = _mm512_loadu_si512(n + i_);
+    __m512i index = _mm512_min_epu64(n_v, zero_v);
+    if constexpr (Bits == 32) {
+      _mm256_storeu_si256((__m256i *) (out + i_), _mm512_i64gather_epi32(index, table, 4));
+    }
+    else if constexpr (Bits == 64) {
+      _mm512_storeu_si512(out + i_, _mm512_i64gather_epi64(index, table, 8));
+    }
+    else {
+      __m512i low_index = _mm512_add_epi64(index, index);
+      __m512i low = _mm512_i64gather_epi64(low_index, table, 8);
+      __m512i high = _mm512_i64gather_epi64(_mm512_add_epi64(low_index, _mm512_set1_epi64(1)), table, 8);
+      _mm512_storeu_si512(out + i_, _mm512_permutex2var_epi64(low, _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11), high));
+      _mm512_storeu_si512(out + i_ + 4, _mm512_permutex2var_epi64(low, _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15), high));
+    }
+    mask |= (uint64_t) _mm512_cmpgt_epu64_mask(n_v, exact_v) << i_;
+  }
+#elif defined(__AVX2__)
+  //  AVX2 compares signed lanes only: flipping the top bit orders unsigned values.
+  __m256i const bias = _mm256_set1_epi64x(INT64_MIN);
+  __m256i const zero_v = _mm256_set1_epi64x((long long) zero);
+  __m256i const zero_b = _mm256_xor_si256(zero_v, bias);
+  __m256i const exact_b = _mm256_set1_epi64x((long long) (exact ^ (uint64_t) INT64_MIN));
+  for (; i_ + BATCH_LANES <= count; i_ += BATCH_LANES) {
+    __m256i n_v = _mm256_loadu_si256((__m256i const *) (n + i_));
+    __m256i n_b = _mm256_xor_si256(n_v, bias);
+    __m256i index = _mm256_blendv_epi8(zero_v, n_v, _mm256_cmpgt_epi64(zero_b, n_b));
+    if constexpr (Bits == 32) {
+      _mm_storeu_si128((__m128i *) (out + i_), _mm256_i64gather_epi32((int const *) table, index, 4));
+    }
+    else if constexpr (Bits == 64) {
+      _mm256_storeu_si256((__m256i *) (out + i_), _mm256_i64gather_epi64((long long const *) table, index, 8));
+    }
+    else {
+      __m256i low_index = _mm256_add_epi64(index, index);
+      __m256i low = _mm256_i64gather_epi64((long long const *) table, low_index, 8);
+      __m256i high = _mm256_i64gather_epi64((long long const *) table, _mm256_add_epi64(low_index, _mm256_set1_epi64x(1)), 8);
+      __m256i pairs_02 = _mm256_unpacklo_epi64(low, high);
+      __m256i pairs_13 = _mm256_unpackhi_epi64(low, high);
+      _mm256_storeu_si256((__m256i *) (out + i_), _mm256_permute2x128_si256(pairs_02, pairs_13, 0x20));
+      _mm256_storeu_si256((__m256i *) (out + i_ + 2), _mm256_permute2x128_si256(pairs_02, pairs_13, 0x31));
+    }
+    uint64_t over = (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(n_b, exact_b)));
+    mask |= over << i_;
+  }
+#endif
+  for (; i_ < count; ++i_) {
+    out[i_] = table[n[i_] < zero ? n[i_] : zero];
+    mask |= (uint64_t) (n[i_] > exact) << i_;
+  }
+
+  return mask;
+}
+
+/*
+ *  MARK: fact_batch()
+ *
+ *  out[i] = n[i]! wrapped to Bits and the overflow bits of the Bits, Signed engine.
+ */
+template <unsigned Bits, bool Signed>
+static void fact_batch(uint64_t const n[], typename wrapped_table<Bits>::value_type out[], uint64_t overflow[], size_t count) {
+
+  uint64_t exact = fixed::FixedWidthFactorial<Bits, Signed>::MAX_EXACT_N;
+
+  for (size_t w_ = 0; w_ < BATCH_MASK_WORDS(count); ++w_) {
+    size_t first = w_ * 64;
+    overflow[w_] = gather_word<Bits>(n + first, out + first, count - first < 64 ? count - first : 64, exact);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: check_width()
+ *
+ *  Compare fact_batch<Bits, Signed>() with FixedWidthFactorial::compute() for every
+ *  n in the range; returns the number of differences and adds the time of each to
+ *  batch_ns and loop_ns.
+ */
+template <unsigned Bits, bool Signed>
+static uint64_t check_width(uint64_t const n[], size_t count, double & batch_ns, double & loop_ns) {
+
+  typedef typename wrapped_table<Bits>::value_type value_type;
+  typedef typename fixed::FixedWidthFactorial<Bits, Signed>::value_type engine_type;
+  value_type * out = new value_type[count];
+  engine_type * expect = new engine_type[count];
+  bool * expect_over = new bool[count];
+  uint64_t * overflow = new uint64_t[BATCH_MASK_WORDS(count)];
+  uint64_t differences = 0;
+
+  double t0 = stats_seconds();
+  fact_batch<Bits, Signed>(n, out, overflow, count);
+  double t1 = stats_seconds();
+  for (size_t i_ = 0; i_ < count; ++i_) {
+    expect[i_] = fixed::FixedWidthFactorial<Bits, Signed>::compute(n[i_], expect_over[i_]);
+  }
+  double t2 = stats_seconds();
+
+  for (size_t i_ = 0; i_ < count; ++i_) {
+    bool over = ((overflow[i_ / 64] >> (i_ % 64)) & 1) != 0;
+    differences += out[i_] != (value_type) expect[i_] || over != expect_over[i_];
+  }
+  batch_ns += (t1 - t0) * 1.0e9;
+  loop_ns += (t2 - t1) * 1.0e9;
+  delete [] out;
+  delete [] expect;
+  delete [] expect_over;
+  delete [] overflow;
+
+  return differences;
+}
+
+} /* namespace batch */
+
+//  MARK: - C interface
+extern "C" {
+
+/*
+ *  MARK: fact_u32_batch() ... fact_s128_batch()
+ *
+ *  out[i] = n[i]! wrapped to the width, as the u32 ... s128 engines display it, and
+ *  bit i % 64 of overflow[i / 64] set when it overflowed. overflow must hold
+ *  BATCH_MASK_WORDS(count) words. A signed result is the unsigned one read as
+ *  two's complement; only the overflow bound differs.
+ */
+void fact_u32_batch(uint64_t const n[], uint32_t out[], uint64_t overflow[], size_t count) {
+
+  batch::fact_batch<32, false>(n, out, overflow, count);
+
+  return;
+}
+
+void fact_s32_batch(uint64_t const n[], int32_t out[], uint64_t overflow[], size_t count) {
+
+  batch::fact_batch<32, true>(n, (uint32_t *) out, overflow, count);
+
+  return;
+}
+
+void fact_u64_batch(uint64_t const n[], uint64_t out[], uint64_t overflow[], size_t count) {
+
+  batch::fact_batch<64, false>(n, out, overflow, count);
+
+  return;
+}
+
+void fact_s64_batch(uint64_t const n[], int64_t out[], uint64_t overflow[], size_t count) {
+
+  batch::fact_batch<64, true>(n, (uint64_t *) out, overflow, count);
+
+  return;
+}
+
+void fact_u128_batch(uint64_t const n[], unsigned __int128 out[], uint64_t overflow[], size_t count) {
+
+  batch::fact_batch<128, false>(n, out, overflow, count);
+
+  return;
+}
+
+void fact_s128_batch(uint64_t const n[], __int128 out[], uint64_t overflow[], size_t count) {
+
+  batch::fact_batch<128, true>(n, (unsigned __int128 *) out, overflow, count);
+
+  return;
+}
+
+/*
+ *  MARK: batch_check()
+ *
+ *  Compare the batched functions of every width with FixedWidthFactorial::compute()
+ *  for nbegin <= n <= nend, in a shuffled order, and display the time per argument
+ *  of each. Returns true when every value and overflow bit agrees.
+ */
+bool batch_check(uint64_t nbegin, uint64_t nend) {
+
+  size_t count = nend >= nbegin ? (size_t) (nend - nbegin + 1) : 0;
+  uint64_t * n = new uint64_t[count + 1];
+  uint64_t differences = 0;
+  double batch_ns[6] = { 0.0, };
+  double loop_ns[6] = { 0.0, };
+  char const * names[6] = { "u32", "s32", "u64", "s64", "u128", "s128", };
+  uint64_t state = UINT64_C(0x9E3779B97F4A7C15);
+
+  for (size_t i_ = 0; i_ < count; ++i_) {
+    n[i_] = nbegin + i_;
+  }
+  for (size_t i_ = count; i_ > 1; --i_) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    size_t j_ = (size_t) (state % i_);
+    uint64_t swap = n[i_ - 1];
+    n[i_ - 1] = n[j_];
+    n[j_] = swap;
+  }
+
+  differences += batch::check_width<32, false>(n, count, batch_ns[0], loop_ns[0]);
+  differences += batch::check_width<32, true>(n, count, batch_ns[1], loop_ns[1]);
+  differences += batch::check_width<64, false>(n, count, batch_ns[2], loop_ns[2]);
+  differences += batch::check_width<64, true>(n, count, batch_ns[3], loop_ns[3]);
+  differences += batch::check_width<128, false>(n, count, batch_ns[4], loop_ns[4]);
+  differences += batch::check_width<128, true>(n, count, batch_ns[5], loop_ns[5]);
+  delete [] n;
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {batched table gather, %d %s, vs FixedWidthFactorial}:\n\n",
+         nbegin, nend, BATCH_LANES, BATCH_LANES == 1 ? "lane" : "lanes");
+  for (int w_ = 0; w_ < 6 && count > 0; ++w_) {
+    printf("%6s: %14.3f ns/arg batched %14.3f ns/arg iterative\n", names[w_], batch_ns[w_] / (double) count, loop_ns[w_] / (double) count);
+  }
+  printf("\n%s\n", differences == 0 ? "All values and overflow bits agree." : "*- Batched values differ -*");
+
+  return differences == 0;
+}
+
+} /* extern "C" */
@@ -0,0 +1,46 @@
+//
+//  factorial_batch.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Batched fixed width factorials.
+//  fact_u32_batch() ... fact_s128_batch() set out[i] to n[i]! wrapped to the width,
+//  the value the u32 ... s128 engines display, for a whole array of arguments, and
+//  set bit i % 64 of overflow[i / 64] when n[i]! does not fit. n! mod 2^Bits is zero
+//  once n! has Bits factors of two, so every result comes from a table of at most
+//  131 entries: the arguments are clamped and the table gathered several lanes to
+//  a vector register, with no loop over the factors and no branches.
+//
+
+#pragma once
+#ifndef factorial_batch_h
+#define factorial_batch_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Words of the overflow mask for count arguments.
+#define BATCH_MASK_WORDS(count) (((count) + 63) / 64)
+
+//  MARK: - Prototypes
+void fact_u32_batch(uint64_t const n[], uint32_t out[], uint64_t overflow[], size_t count);
+void fact_s32_batch(uint64_t const n[], int32_t out[], uint64_t overflow[], size_t count);
+void fact_u64_batch(uint64_t const n[], uint64_t out[], uint64_t overflow[], size_t count);
+void fact_s64_batch(uint64_t const n[], int64_t out[], uint64_t overflow[], size_t count);
+void fact_u128_batch(uint64_t const n[], unsigned __int128 out[], uint64_t overflow[], size_t count);
+void fact_s128_batch(uint64_t const n[], __int128 out[], uint64_t overflow[], size_t count);
+bool batch_check(uint64_t nbegin, uint64_t nend);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_batch_h */
@@ -0,0 +1,190 @@
+//
+//  factorial_calibrate.c
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include <gmp.h>
+
+#include "factorial_calibrate.h"
+#include "factorial_gmp.h"
+
+//  Calibration sizes are 2^CAL_FIRST .. 2^CAL_LAST, each timed as the best of CAL_REPS.
+#define CAL_FIRST 5
+#define CAL_LAST 16
+#define CAL_REPS 3
+
+//  MARK: - Prototypes
+static char const * cache_path(void);
+static double time_engine(void (* engine)(mpz_t, uint64_t), uint64_t val);
+
+//  MARK: - Implementation
+/*
+ *  MARK: calibrate_defaults()
+ *
+ *  Crossovers measured on a typical x86-64 host with GMP 6.2. The prime swing
+ *  engine was faster than the product tree at every size timed, so the defaults
+ *  leave the tree tier empty: linear below 32, prime swing from there on.
+ */
+crossovers calibrate_defaults(void) {
+
+  crossovers xo = {
+    .linear_to_tree = 32,
+    .tree_to_swing  = 32,
+  };
+
+  return xo;
+}
+
+/*
+ *  MARK: calibrate_load()
+ *
+ *  Read cached crossovers. Returns false, leaving *xo untouched, if there is no
+ *  usable cache file; crossovers out of order are not usable.
+ */
+bool calibrate_load(crossovers * xo) {
+
+  bool loaded = false;
+  FILE * cache = fopen(cache_path(), "r");
+
+  if (cache != NULL) {
+    crossovers read = *xo;
+    int fields = fscanf(cache, "linear_to_tree=%" SCNu64 " tree_to_swing=%" SCNu64,
+                        &read.linear_to_tree, &read.tree_to_swing);
+    if (fields == 2 && read.linear_to_tree <= read.tree_to_swing) {
+      *xo = read;
+      loaded = true;
+    }
+    fclose(cache);
+  }
+
+  return loaded;
+}
+
+/*
+ *  MARK: calibrate_run()
+ *
+ *  Time the linear, product tree and prime swing engines at powers of two.
+ *  linear_to_tree is the first size at which linear is not the fastest, and
+ *  tree_to_swing the first size from there on at which prime swing is; if prime
+ *  swing is already the fastest at linear_to_tree there is no tree tier.
+ */
+bool calibrate_run(crossovers * xo, FILE * report) {
+
+  bool tree_found = false;
+  bool swing_found = false;
+  crossovers found = {
+    .linear_to_tree = UINT64_MAX,
+    .tree_to_swing  = UINT64_MAX,
+  };
+
+  if (report != NULL) {
+    fprintf(report, "Calibration {seconds, best of %d}:\n\n", CAL_REPS);
+    fprintf(report, "%10s %14s %14s %14s\n", "n", "linear", "tree", "swing");
+  }
+  for (int e_ = CAL_FIRST; e_ <= CAL_LAST; ++e_) {
+    uint64_t val = (uint64_t) 1 << e_;
+    double linear = time_engine(gmp_fact_linear, val);
+    double tree = time_engine(gmp_fact_tree, val);
+    double swing = time_engine(gmp_fact_swing, val);
+
+    if (report != NULL) {
+      fprintf(report, "%10" PRIu64 " %14.9f %14.9f %14.9f\n", val, linear, tree, swing);
+    }
+    if (!tree_found && (tree < linear || swing < linear)) {
+      found.linear_to_tree = val;
+      tree_found = true;
+    }
+    if (tree_found && !swing_found && swing < tree && swing < linear) {
+      found.tree_to_swing = val;
+      swing_found = true;
+    }
+  }
+
+  *xo = found;
+  if (report != NULL) {
+    fprintf(report, "\nlinear_to_tree=%" PRIu64 " tree_to_swing=%" PRIu64 "\n\n",
+            xo->linear_to_tree, xo->tree_to_swing);
+  }
+
+  return tree_found || swing_found;
+}
+
+/*
+ *  MARK: calibrate_save()
+ */
+bool calibrate_save(crossovers const * xo) {
+
+  bool saved = false;
+  char const * path = cache_path();
+  FILE * cache = fopen(path, "w");
+
+  if (cache == NULL) {
+    perror(path);
+  }
+  else {
+    fprintf(cache, "linear_to_tree=%" PRIu64 "\ntree_to_swing=%" PRIu64 "\n",
+            xo->linear_to_tree, xo->tree_to_swing);
+    saved = fclose(cache) == 0;
+  }
+
+  return saved;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: cache_path()
+ */
+static char const * cache_path(void) {
+
+  static char path[4096] = { 0, };
+
+  if (path[0] == '\0') {
+    char const * env = getenv("FACTORIAL_SELECT_CALIBRATION");
+    char const * home = getenv("HOME");
+    if (env != NULL && env[0] != '\0') {
+      snprintf(path, sizeof(path), "%s", env);
+    }
+    else {
+      snprintf(path, sizeof(path), "%s/.factorial_select.cal", home != NULL ? home : ".");
+    }
+  }
+
+  return path;
+}
+
+/*
+ *  MARK: time_engine()
+ */
+static double time_engine(void (* engine)(mpz_t, uint64_t), uint64_t val) {
+
+  double best = 0.0;
+  mpz_t result;
+
+  mpz_init(result);
+  for (int r_ = 0; r_ < CAL_REPS; ++r_) {
+    struct timespec start;
+    struct timespec stop;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    engine(result, val);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    double elapsed = (double) (stop.tv_sec - start.tv_sec) + (double) (stop.tv_nsec - start.tv_nsec) * 1e-9;
+    best = (r_ == 0 || elapsed < best) ? elapsed : best;
+  }
+  mpz_clear(result);
+
+  return best;
+}
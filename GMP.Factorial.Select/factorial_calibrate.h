@@ -0,0 +1,47 @@
+//
+//  factorial_calibrate.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Crossover points between the GMP engines for --engine auto.
+//  A short calibration run on the host measures them and caches them in a file
+//  ($FACTORIAL_SELECT_CALIBRATION, or ~/.factorial_select.cal); without a cache
+//  the built-in defaults are used.
+//
+
+#pragma once
+#ifndef factorial_calibrate_h
+#define factorial_calibrate_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct crossovers
+//  From-scratch GMP engine for n: linear below linear_to_tree,
+//  product tree below tree_to_swing, prime swing from there on.
+//  linear_to_tree <= tree_to_swing; when they are equal there is no tree tier.
+struct crossovers {
+  uint64_t linear_to_tree;
+  uint64_t tree_to_swing;
+};
+typedef struct crossovers crossovers;
+
+//  MARK: - Prototypes
+crossovers calibrate_defaults(void);
+bool calibrate_load(crossovers * xo);
+bool calibrate_run(crossovers * xo, FILE * report);
+bool calibrate_save(crossovers const * xo);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_calibrate_h */
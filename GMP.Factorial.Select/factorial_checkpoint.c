@@ -0,0 +1,459 @@
+//
+//  factorial_checkpoint.c
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <gmp.h>
+
+#include "factorial_checkpoint.h"
+#include "factorial_gmp.h"
+#include "factorial_stats.h"
+
+//  Levels of the product tree over CHECKPOINT_CHUNKS leaves.
+#define TREE_LEVELS 7
+//  Checksum modulus, the Mersenne prime 2^61 - 1.
+#define CHECK_PRIME ((UINT64_C(1) << 61) - 1)
+#define MANIFEST_MAGIC "factorial_checkpoint 1"
+
+//  MARK: struct saved
+//  A subproduct on disk: its size in limbs and its residue mod CHECK_PRIME.
+struct saved {
+  bool done;
+  size_t limbs;
+  uint64_t checksum;
+};
+typedef struct saved saved;
+
+//  MARK: struct checkpoint
+struct checkpoint {
+  char const * dir;
+  uint64_t val;
+  checkpoint_mode mode;
+  uint64_t bounds[CHECKPOINT_CHUNKS];
+  saved nodes[TREE_LEVELS][CHECKPOINT_CHUNKS];  //  CHECKPOINT_TREE: level, index
+  uint64_t running_hi;                          //  CHECKPOINT_LINEAR: running product of 2..running_hi
+  saved running;
+};
+typedef struct checkpoint checkpoint;
+
+//  MARK: - Prototypes
+static uint64_t mul_mod(uint64_t lhs, uint64_t rhs);
+static uint64_t range_checksum(uint64_t lo, uint64_t hi);
+static char const * file_path(checkpoint const * cp, char * path, size_t path_l, int level, int index);
+static bool save_limbs(char const * path, mpz_srcptr num);
+static bool load_limbs(char const * path, mpz_t num, saved const * expect);
+static void read_manifest(checkpoint * cp);
+static bool write_manifest(checkpoint const * cp);
+static void remove_checkpoint(checkpoint * cp);
+static void tree_node(checkpoint * cp, int level, int index, mpz_t product, uint64_t * checksum);
+static void linear_product(checkpoint * cp, mpz_t product);
+
+//  MARK: - Implementation
+/*
+ *  MARK: checkpoint_fact()
+ *
+ *  result = val!, checkpointed in directory "dir" (created if need be).
+ *
+ *  2..val is cut into CHECKPOINT_CHUNKS subranges of equal log-size. In CHECKPOINT_TREE
+ *  mode each completed node of the product tree over them is saved, and its children
+ *  deleted; in CHECKPOINT_LINEAR mode the running product is saved after each subrange.
+ *  A failure to save a checkpoint is reported but does not stop the computation.
+ *  The checkpoint files are removed once val! is complete.
+ *  Returns false only if "dir" cannot be used.
+ */
+bool checkpoint_fact(mpz_t result, uint64_t val, char const * dir, checkpoint_mode mode) {
+
+  bool computed = true;
+
+  if (val < CHECKPOINT_MIN_N) {
+    if (mode == CHECKPOINT_TREE) {
+      gmp_fact_tree(result, val);
+    }
+    else {
+      gmp_fact_linear(result, val);
+    }
+  }
+  else if (mkdir(dir, 0777) != 0 && errno != EEXIST) {
+    perror(dir);
+    computed = false;
+  }
+  else {
+    checkpoint * cp = calloc(1, sizeof(checkpoint));
+    if (cp == NULL) {
+      perror("checkpoint");
+      computed = false;
+    }
+    else {
+      cp->dir = dir;
+      cp->val = val;
+      cp->mode = mode;
+      gmp_split_range(2, val, CHECKPOINT_CHUNKS, cp->bounds);
+      read_manifest(cp);
+
+      if (mode == CHECKPOINT_TREE) {
+        uint64_t checksum;
+        tree_node(cp, TREE_LEVELS - 1, 0, result, &checksum);
+      }
+      else {
+        linear_product(cp, result);
+      }
+      remove_checkpoint(cp);
+      free(cp);
+    }
+  }
+
+  return computed;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: mul_mod()
+ *
+ *  lhs * rhs mod 2^61 - 1, for lhs, rhs < 2^61 - 1.
+ */
+static uint64_t mul_mod(uint64_t lhs, uint64_t rhs) {
+
+  unsigned __int128 prod = (unsigned __int128) lhs * rhs;
+  uint64_t folded = (uint64_t) (prod & CHECK_PRIME) + (uint64_t) (prod >> 61);
+  folded = (folded & CHECK_PRIME) + (folded >> 61);
+
+  return folded >= CHECK_PRIME ? folded - CHECK_PRIME : folded;
+}
+
+/*
+ *  MARK: range_checksum()
+ *
+ *  lo * (lo + 1) * ... * hi mod 2^61 - 1, computed without the big product.
+ */
+static uint64_t range_checksum(uint64_t lo, uint64_t hi) {
+
+  uint64_t checksum = 1;
+
+  for (uint64_t i_ = lo; i_ <= hi; ++i_) {
+    checksum = mul_mod(checksum, i_ % CHECK_PRIME);
+  }
+
+  return checksum;
+}
+
+/*
+ *  MARK: file_path()
+ *
+ *  The limb file of tree node (level, index), of the running product (level < 0),
+ *  or of the manifest (index < 0).
+ */
+static char const * file_path(checkpoint const * cp, char * path, size_t path_l, int level, int index) {
+
+  if (index < 0) {
+    snprintf(path, path_l, "%s/manifest", cp->dir);
+  }
+  else if (level < 0) {
+    snprintf(path, path_l, "%s/running.limbs", cp->dir);
+  }
+  else {
+    snprintf(path, path_l, "%s/node_%d_%d.limbs", cp->dir, level, index);
+  }
+
+  return path;
+}
+
+/*
+ *  MARK: save_limbs()
+ *
+ *  Write the limbs of num to "path" atomically: to a temporary file, synced, then renamed.
+ */
+static bool save_limbs(char const * path, mpz_srcptr num) {
+
+  char tmp_path[4096];
+  bool saved_ok = false;
+  size_t length = mpz_size(num) * sizeof(mp_limb_t);
+  char const * next = (char const *) mpz_limbs_read(num);
+
+  snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+  int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if (fd >= 0) {
+    saved_ok = true;
+    while (saved_ok && length > 0) {
+      ssize_t wrote = write(fd, next, length);
+      if (wrote < 0 && errno == EINTR) {
+        continue;
+      }
+      saved_ok = wrote > 0;
+      next += saved_ok ? wrote : 0;
+      length -= saved_ok ? (size_t) wrote : 0;
+    }
+    saved_ok = fsync(fd) == 0 && saved_ok;
+    saved_ok = close(fd) == 0 && saved_ok;
+    saved_ok = saved_ok && rename(tmp_path, path) == 0;
+  }
+  if (!saved_ok) {
+    perror(path);
+    unlink(tmp_path);
+  }
+
+  return saved_ok;
+}
+
+/*
+ *  MARK: load_limbs()
+ *
+ *  Read num from "path" and check it against the size and checksum in the manifest.
+ */
+static bool load_limbs(char const * path, mpz_t num, saved const * expect) {
+
+  bool loaded = false;
+  int fd = open(path, O_RDONLY);
+
+  if (fd >= 0) {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && (size_t) st.st_size == expect->limbs * sizeof(mp_limb_t) && expect->limbs > 0) {
+      char * next = (char *) mpz_limbs_write(num, (mp_size_t) expect->limbs);
+      size_t length = (size_t) st.st_size;
+      loaded = true;
+      while (loaded && length > 0) {
+        ssize_t got = read(fd, next, length);
+        if (got < 0 && errno == EINTR) {
+          continue;
+        }
+        loaded = got > 0;
+        next += loaded ? got : 0;
+        length -= loaded ? (size_t) got : 0;
+      }
+      mpz_limbs_finish(num, loaded ? (mp_size_t) expect->limbs : 0);
+      loaded = loaded && mpz_fdiv_ui(num, CHECK_PRIME) == expect->checksum;
+    }
+    close(fd);
+  }
+  if (!loaded) {
+    fprintf(stderr, "checkpoint %s is missing or damaged, recomputing\n", path);
+  }
+
+  return loaded;
+}
+
+/*
+ *  MARK: read_manifest()
+ *
+ *  Mark the subproducts listed in the manifest as done. A manifest for another
+ *  n, mode or limb size is ignored.
+ */
+static void read_manifest(checkpoint * cp) {
+
+  char path[4096];
+  char line[256];
+  FILE * manifest = fopen(file_path(cp, path, sizeof(path), 0, -1), "r");
+
+  if (manifest != NULL) {
+    uint64_t val = 0;
+    int mode = -1;
+    size_t limb_bytes = 0;
+    int chunks = 0;
+    bool matches = fgets(line, sizeof(line), manifest) != NULL && strncmp(line, MANIFEST_MAGIC, strlen(MANIFEST_MAGIC)) == 0
+                && fscanf(manifest, " n %" SCNu64 " mode %d limb_bytes %zu chunks %d", &val, &mode, &limb_bytes, &chunks) == 4
+                && val == cp->val && mode == (int) cp->mode && limb_bytes == sizeof(mp_limb_t) && chunks == CHECKPOINT_CHUNKS;
+
+    while (matches && fgets(line, sizeof(line), manifest) != NULL) {
+      int level;
+      int index;
+      uint64_t hi;
+      saved entry = { true, 0, 0, };
+      if (sscanf(line, "node %d %d %zu %" SCNu64, &level, &index, &entry.limbs, &entry.checksum) == 4
+          && level >= 0 && level < TREE_LEVELS && index >= 0 && index < (CHECKPOINT_CHUNKS >> level)) {
+        cp->nodes[level][index] = entry;
+      }
+      else if (sscanf(line, "running %" SCNu64 " %zu %" SCNu64, &hi, &entry.limbs, &entry.checksum) == 3
+               && hi <= cp->val) {
+        cp->running_hi = hi;
+        cp->running = entry;
+      }
+    }
+    fclose(manifest);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: write_manifest()
+ *
+ *  Replace the manifest, atomically, with the list of saved subproducts.
+ */
+static bool write_manifest(checkpoint const * cp) {
+
+  char path[4096];
+  char tmp_path[4096 + 8];
+  bool written = false;
+
+  file_path(cp, path, sizeof(path), 0, -1);
+  snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+  FILE * manifest = fopen(tmp_path, "w");
+  if (manifest != NULL) {
+    fprintf(manifest, "%s\n", MANIFEST_MAGIC);
+    fprintf(manifest, "n %" PRIu64 "\nmode %d\nlimb_bytes %zu\nchunks %d\n",
+            cp->val, (int) cp->mode, sizeof(mp_limb_t), CHECKPOINT_CHUNKS);
+    for (int l_ = 0; l_ < TREE_LEVELS; ++l_) {
+      for (int i_ = 0; i_ < (CHECKPOINT_CHUNKS >> l_); ++i_) {
+        saved const * node = &cp->nodes[l_][i_];
+        if (node->done) {
+          fprintf(manifest, "node %d %d %zu %" PRIu64 "\n", l_, i_, node->limbs, node->checksum);
+        }
+      }
+    }
+    if (cp->running.done) {
+      fprintf(manifest, "running %" PRIu64 " %zu %" PRIu64 "\n", cp->running_hi, cp->running.limbs, cp->running.checksum);
+    }
+    written = fflush(manifest) == 0 && fsync(fileno(manifest)) == 0;
+    written = fclose(manifest) == 0 && written;
+    written = written && rename(tmp_path, path) == 0;
+  }
+  if (!written) {
+    perror(path);
+  }
+
+  return written;
+}
+
+/*
+ *  MARK: remove_checkpoint()
+ */
+static void remove_checkpoint(checkpoint * cp) {
+
+  char path[4096];
+
+  //  Every node file, not just those in the manifest: a run stopped between saving
+  //  a node and deleting its children leaves the children behind.
+  for (int l_ = 0; l_ < TREE_LEVELS; ++l_) {
+    for (int i_ = 0; i_ < (CHECKPOINT_CHUNKS >> l_); ++i_) {
+      unlink(file_path(cp, path, sizeof(path), l_, i_));
+      cp->nodes[l_][i_].done = false;
+    }
+  }
+  unlink(file_path(cp, path, sizeof(path), -1, 0));
+  cp->running.done = false;
+  unlink(file_path(cp, path, sizeof(path), 0, -1));
+
+  return;
+}
+
+/*
+ *  MARK: tree_node()
+ *
+ *  product = the product of the leaves under node (level, index), from its checkpoint
+ *  if it has a sound one. A node other than the root is saved once computed and
+ *  replaces its children in the manifest.
+ */
+static void tree_node(checkpoint * cp, int level, int index, mpz_t product, uint64_t * checksum) {
+
+  char path[4096];
+  saved * node = &cp->nodes[level][index];
+
+  file_path(cp, path, sizeof(path), level, index);
+  if (node->done) {
+    if (load_limbs(path, product, node)) {
+      *checksum = node->checksum;
+      return;
+    }
+    node->done = false;
+    unlink(path);
+  }
+
+  if (level == 0) {
+    uint64_t lo = index == 0 ? 2 : cp->bounds[index - 1] + 1;
+    uint64_t hi = cp->bounds[index];
+    gmp_range_product(product, lo, hi);
+    *checksum = range_checksum(lo, hi);
+  }
+  else {
+    mpz_t upper;
+    uint64_t upper_checksum;
+
+    mpz_init(upper);
+    tree_node(cp, level - 1, 2 * index, product, checksum);
+    tree_node(cp, level - 1, 2 * index + 1, upper, &upper_checksum);
+    mpz_mul(product, product, upper);
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+    STATS_COUNT(STATS_LIMB_OPS, mpz_size(product));
+    mpz_clear(upper);
+    *checksum = mul_mod(*checksum, upper_checksum);
+  }
+
+  if (level < TREE_LEVELS - 1 && save_limbs(path, product)) {
+    node->done = true;
+    node->limbs = mpz_size(product);
+    node->checksum = *checksum;
+    bool had_children = level > 0 && (cp->nodes[level - 1][2 * index].done || cp->nodes[level - 1][2 * index + 1].done);
+    for (int c_ = 0; level > 0 && c_ < 2; ++c_) {
+      cp->nodes[level - 1][2 * index + c_].done = false;
+    }
+    if (write_manifest(cp) && had_children) {
+      for (int c_ = 0; c_ < 2; ++c_) {
+        unlink(file_path(cp, path, sizeof(path), level - 1, 2 * index + c_));
+      }
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: linear_product()
+ *
+ *  product = val! one factor at a time, resuming from the saved running product
+ *  if it is sound and saving it after every subrange.
+ */
+static void linear_product(checkpoint * cp, mpz_t product) {
+
+  char path[4096];
+  uint64_t checksum = 1;
+  uint64_t hi = 1;
+
+  file_path(cp, path, sizeof(path), -1, 0);
+  mpz_set_ui(product, 1);
+  if (cp->running.done) {
+    if (load_limbs(path, product, &cp->running)) {
+      hi = cp->running_hi;
+      checksum = cp->running.checksum;
+    }
+    else {
+      mpz_set_ui(product, 1);
+      cp->running.done = false;
+    }
+  }
+
+  for (int c_ = 0; c_ < CHECKPOINT_CHUNKS; ++c_) {
+    if (cp->bounds[c_] <= hi) {
+      continue;
+    }
+    gmp_mul_range(product, hi + 1, cp->bounds[c_], false);
+    for (uint64_t i_ = hi + 1; i_ <= cp->bounds[c_]; ++i_) {
+      checksum = mul_mod(checksum, i_ % CHECK_PRIME);
+    }
+    hi = cp->bounds[c_];
+
+    if (c_ + 1 < CHECKPOINT_CHUNKS && save_limbs(path, product)) {
+      cp->running_hi = hi;
+      cp->running.done = true;
+      cp->running.limbs = mpz_size(product);
+      cp->running.checksum = checksum;
+      write_manifest(cp);
+    }
+  }
+
+  return;
+}
@@ -0,0 +1,47 @@
+//
+//  factorial_checkpoint.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Checkpoint and resume for long single-n GMP factorials.
+//  Completed subproducts are saved as raw limb files in a checkpoint directory
+//  together with a small text manifest. A restarted run picks up the subproducts
+//  whose files still match the checksum (the subproduct mod 2^61 - 1) recorded
+//  in the manifest.
+//
+
+#pragma once
+#ifndef factorial_checkpoint_h
+#define factorial_checkpoint_h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Below this n a factorial is computed without checkpoints.
+#define CHECKPOINT_MIN_N 100000
+//  Number of subranges (and checkpoints) for a factorial; a power of two.
+#define CHECKPOINT_CHUNKS 64
+
+//  MARK: enum checkpoint_mode
+enum checkpoint_mode {
+  CHECKPOINT_LINEAR = 0,  //  a running product, saved after each subrange
+  CHECKPOINT_TREE,        //  a product tree, every completed node saved
+};
+typedef enum checkpoint_mode checkpoint_mode;
+
+//  MARK: - Prototypes
+bool checkpoint_fact(mpz_t result, uint64_t val, char const * dir, checkpoint_mode mode);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_checkpoint_h */
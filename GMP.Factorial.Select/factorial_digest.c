@@ -0,0 +1,395 @@
+//
+//  factorial_digest.c
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  The conversion follows write_level() in factorial_stream.c: num is split by
+//  10^(STREAM_LEAF_DIGITS * 2^k), and each leaf is converted into a buffer on the
+//  stack and reduced there. Every reduction can be appended: the histograms add,
+//  and the hash of a text followed by a tail of length L is hash * B^L + tail hash.
+//  So at the top levels the padded remainder is reduced by a new thread into a
+//  digest of its own while this thread does the quotient, and the two are joined.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <pthread.h>
+#include <gmp.h>
+
+#include "factorial_digest.h"
+#include "factorial_stream.h"
+#include "factorial_gmp.h"
+#include "factorial_stats.h"
+#include "factorial_memprof.h"
+
+//  Lowest level whose remainder is handed to another thread: 2^2 leaves and up.
+#define THREAD_LEVEL_MIN 2
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct level_job
+//  A padded remainder reduced by its own thread.
+struct level_job {
+  digest          dg;
+  mpz_srcptr      num;
+  mpz_t const *   powers;
+  size_t          level;
+  unsigned        threads;
+};
+
+//  MARK: - Prototypes
+static uint64_t mod_mul(uint64_t lhs, uint64_t rhs);
+static uint64_t mod_pow(uint64_t base, uint64_t exponent);
+static void digest_leaf(digest * dg, mpz_srcptr num, bool pad);
+static void digest_level(digest * dg, mpz_srcptr num, mpz_t const powers[], size_t level, bool pad, unsigned threads);
+static void * digest_level_thread(void * arg);
+
+//  MARK: - Implementation
+/*
+ *  MARK: digest_init()
+ */
+void digest_init(digest * dg, unsigned fields) {
+
+  memset(dg, 0, sizeof(*dg));
+  dg->fields = fields;
+
+  return;
+}
+
+/*
+ *  MARK: digest_chars()
+ *
+ *  Append length decimal digits to the digest.
+ */
+void digest_chars(digest * dg, char const * text, size_t length) {
+
+  uint64_t histogram[10] = { 0, };
+
+  for (size_t c_ = 0; c_ < length; ++c_) {
+    ++histogram[text[c_] - '0'];
+  }
+  for (size_t d_ = 0; d_ < 10; ++d_) {
+    dg->histogram[d_] += histogram[d_];
+  }
+  if ((dg->fields & DIGEST_HASH) != 0) {
+    uint64_t hash = dg->hash;
+    for (size_t c_ = 0; c_ < length; ++c_) {
+      hash = mod_mul(hash, DIGEST_HASH_BASE) + (uint64_t) (unsigned char) text[c_];
+      hash = hash >= DIGEST_HASH_MOD ? hash - DIGEST_HASH_MOD : hash;
+    }
+    dg->hash = hash;
+  }
+
+  return;
+}
+
+/*
+ *  MARK: digest_append()
+ *
+ *  dg becomes the digest of its text followed by the text of tail.
+ */
+void digest_append(digest * dg, digest const * tail) {
+
+  if ((dg->fields & DIGEST_HASH) != 0) {
+    dg->hash = mod_mul(dg->hash, mod_pow(DIGEST_HASH_BASE, digest_digits(tail))) + tail->hash;
+    dg->hash = dg->hash >= DIGEST_HASH_MOD ? dg->hash - DIGEST_HASH_MOD : dg->hash;
+  }
+  for (size_t d_ = 0; d_ < 10; ++d_) {
+    dg->histogram[d_] += tail->histogram[d_];
+  }
+
+  return;
+}
+
+/*
+ *  MARK: digest_digits() / digest_sum()
+ */
+uint64_t digest_digits(digest const * dg) {
+
+  uint64_t digits = 0;
+  for (size_t d_ = 0; d_ < 10; ++d_) {
+    digits += dg->histogram[d_];
+  }
+
+  return digits;
+}
+
+uint64_t digest_sum(digest const * dg) {
+
+  uint64_t sum = 0;
+  for (size_t d_ = 1; d_ < 10; ++d_) {
+    sum += d_ * dg->histogram[d_];
+  }
+
+  return sum;
+}
+
+/*
+ *  MARK: digest_fields()
+ *
+ *  Parse "sum,histogram,hash" (any of them, in any order) into DIGEST_ flags.
+ *  NULL selects all of them. Returns 0 for an unknown name.
+ */
+unsigned digest_fields(char const * spec) {
+
+  static struct {
+    char const * name;
+    unsigned     field;
+  } const names[] = {
+    { "sum",       DIGEST_SUM,       },
+    { "histogram", DIGEST_HISTOGRAM, },
+    { "hash",      DIGEST_HASH,      },
+  };
+  unsigned fields = 0;
+
+  if (spec == NULL) {
+    return DIGEST_ALL;
+  }
+  for (char const * next = spec; *next != '\0'; ) {
+    size_t length = strcspn(next, ",");
+    unsigned field = 0;
+    for (size_t n_ = 0; n_ < sizeof(names) / sizeof(*names); ++n_) {
+      if (strlen(names[n_].name) == length && strncmp(next, names[n_].name, length) == 0) {
+        field = names[n_].field;
+      }
+    }
+    if (field == 0) {
+      fprintf(stderr, "--digest: unknown reduction \"%.*s\" (sum, histogram, hash)\n", (int) length, next);
+      return 0;
+    }
+    fields |= field;
+    next += length + (next[length] == ',');
+  }
+
+  return fields;
+}
+
+/*
+ *  MARK: digest_mpz()
+ *
+ *  Append the decimal expansion of num (>= 0) to dg, using up to "threads" threads.
+ */
+void digest_mpz(digest * dg, mpz_srcptr num, unsigned threads) {
+
+  mpz_t powers[STREAM_POWERS_MAX];
+  size_t powers_c = stream_powers(powers, num);
+
+  //  The allocation counters of --memprof are not shared between threads.
+  threads = memprof_enabled() ? 1 : threads;
+  if (powers_c == 0) {
+    digest_leaf(dg, num, false);
+  }
+  else {
+    digest_level(dg, num, (mpz_t const *) powers, powers_c - 1, false, threads);
+  }
+  for (size_t p_ = 0; p_ < powers_c; ++p_) {
+    mpz_clear(powers[p_]);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: digest_header()
+ */
+void digest_header(FILE * out, unsigned fields) {
+
+  fprintf(out, "......>: %20s", "digits");
+  if ((fields & DIGEST_SUM) != 0) {
+    fprintf(out, " %20s", "digit sum");
+  }
+  if ((fields & DIGEST_HASH) != 0) {
+    fprintf(out, " %20s", "hash");
+  }
+  if ((fields & DIGEST_HISTOGRAM) != 0) {
+    for (unsigned d_ = 0; d_ < 10; ++d_) {
+      fprintf(out, " %10u", d_);
+    }
+  }
+  fputc('\n', out);
+
+  return;
+}
+
+/*
+ *  MARK: digest_row()
+ */
+void digest_row(FILE * out, uint64_t val, digest const * dg) {
+
+  int pc = fprintf(out, "%6" PRIu64 "!: %20" PRIu64, val, digest_digits(dg));
+  if ((dg->fields & DIGEST_SUM) != 0) {
+    pc += fprintf(out, " %20" PRIu64, digest_sum(dg));
+  }
+  if ((dg->fields & DIGEST_HASH) != 0) {
+    pc += fprintf(out, " %20" PRIu64, dg->hash);
+  }
+  if ((dg->fields & DIGEST_HISTOGRAM) != 0) {
+    for (size_t d_ = 0; d_ < 10; ++d_) {
+      pc += fprintf(out, " %10" PRIu64, dg->histogram[d_]);
+    }
+  }
+  pc += fputc('\n', out) != EOF;
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+
+  return;
+}
+
+/*
+ *  MARK: digest_factorials_gmp()
+ *
+ *  Write a digest row for each of the factorials nbegin! to nend!. The first is
+ *  computed by prime swing and the rest incrementally, as with --output. Returns
+ *  false if writing to out failed.
+ */
+bool digest_factorials_gmp(FILE * out, uint64_t nbegin, uint64_t nend, unsigned fields, unsigned threads) {
+
+  mpz_t pf;
+
+  mpz_init(pf);
+  for (uint64_t nb = nbegin; !ferror(out) && nb <= nend; ++nb) {
+    memprof_row(nb);
+    if (nb == nbegin) {
+      gmp_fact_swing(pf, nb);
+    }
+    else {
+      mpz_mul_ui(pf, pf, nb);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      STATS_COUNT(STATS_LIMB_OPS, mpz_size(pf));
+    }
+
+    digest dg;
+    digest_init(&dg, fields);
+    digest_mpz(&dg, pf, threads);
+    digest_row(out, nb, &dg);
+  }
+  mpz_clear(pf);
+
+  return !ferror(out);
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: mod_mul() / mod_pow()
+ *
+ *  Arithmetic mod 2^61 - 1 on reduced operands.
+ */
+static uint64_t mod_mul(uint64_t lhs, uint64_t rhs) {
+
+  unsigned __int128 product = (unsigned __int128) lhs * rhs;
+  uint64_t folded = (uint64_t) (product & DIGEST_HASH_MOD) + (uint64_t) (product >> 61);
+
+  return folded >= DIGEST_HASH_MOD ? folded - DIGEST_HASH_MOD : folded;
+}
+
+static uint64_t mod_pow(uint64_t base, uint64_t exponent) {
+
+  uint64_t power = 1;
+  while (exponent != 0) {
+    if ((exponent & 1) != 0) {
+      power = mod_mul(power, base);
+    }
+    base = mod_mul(base, base);
+    exponent >>= 1;
+  }
+
+  return power;
+}
+
+/*
+ *  MARK: digest_leaf()
+ *
+ *  Append num (< 10^STREAM_LEAF_DIGITS), zero-padded to STREAM_LEAF_DIGITS digits if pad is set.
+ */
+static void digest_leaf(digest * dg, mpz_srcptr num, bool pad) {
+
+  char buffer[STREAM_LEAF_DIGITS + 2];
+  size_t digits = 0;
+
+  if (mpz_sgn(num) != 0 || !pad) {
+    mpz_get_str(buffer, 10, num);
+    digits = strlen(buffer);
+  }
+  if (pad) {
+    memmove(buffer + STREAM_LEAF_DIGITS - digits, buffer, digits);
+    memset(buffer, '0', STREAM_LEAF_DIGITS - digits);
+    digits = STREAM_LEAF_DIGITS;
+  }
+  digest_chars(dg, buffer, digits);
+
+  return;
+}
+
+/*
+ *  MARK: digest_level()
+ *
+ *  Append num (< powers[level]^2), zero-padded to STREAM_LEAF_DIGITS * 2^(level + 1)
+ *  digits if pad is set. With more than one thread, from THREAD_LEVEL_MIN up, the
+ *  remainder goes to a new thread with half of them.
+ */
+static void digest_level(digest * dg, mpz_srcptr num, mpz_t const powers[], size_t level, bool pad, unsigned threads) {
+
+  if (!pad && mpz_cmp(num, powers[level]) < 0) {
+    if (level == 0) {
+      digest_leaf(dg, num, false);
+    }
+    else {
+      digest_level(dg, num, powers, level - 1, false, threads);
+    }
+  }
+  else {
+    mpz_t quotient;
+    mpz_t remainder;
+
+    mpz_init(quotient);
+    mpz_init(remainder);
+    mpz_tdiv_qr(quotient, remainder, num, powers[level]);
+
+    pthread_t thread;
+    struct level_job job = { .num = remainder, .powers = powers, .level = level, .threads = threads / 2, };
+    digest_init(&job.dg, dg->fields);
+    bool threaded = threads > 1 && level >= THREAD_LEVEL_MIN
+                 && pthread_create(&thread, NULL, digest_level_thread, &job) == 0;
+    unsigned here = threaded ? threads - threads / 2 : threads;
+
+    if (level == 0) {
+      digest_leaf(dg, quotient, pad);
+    }
+    else {
+      digest_level(dg, quotient, powers, level - 1, pad, here);
+    }
+    mpz_clear(quotient);
+
+    if (threaded) {
+      pthread_join(thread, NULL);
+      digest_append(dg, &job.dg);
+    }
+    else if (level == 0) {
+      digest_leaf(dg, remainder, true);
+    }
+    else {
+      digest_level(dg, remainder, powers, level - 1, true, here);
+    }
+    mpz_clear(remainder);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: digest_level_thread()
+ */
+static void * digest_level_thread(void * arg) {
+
+  struct level_job * job = (struct level_job *) arg;
+
+  digest_level(&job->dg, job->num, job->powers, job->level - 1, true, job->threads);
+
+  return NULL;
+}
@@ -0,0 +1,71 @@
+//
+//  factorial_digest.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Reductions of the decimal expansion of a number: digit count, digit sum,
+//  histogram of the digits and a polynomial hash of the text. They are taken
+//  leaf by leaf during the divide-and-conquer conversion of factorial_stream.c,
+//  with the halves of the top levels in separate threads, so the text is never
+//  held in memory or written out.
+//
+
+#pragma once
+#ifndef factorial_digest_h
+#define factorial_digest_h
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Reductions, for digest_init() and --digest.
+#define DIGEST_SUM       0x1
+#define DIGEST_HISTOGRAM 0x2
+#define DIGEST_HASH      0x4
+#define DIGEST_ALL       (DIGEST_SUM | DIGEST_HISTOGRAM | DIGEST_HASH)
+
+//  hash = sum of c[i] * DIGEST_HASH_BASE^(length - 1 - i) mod 2^61 - 1 over the
+//  characters c[i] of the text, as ASCII codes.
+#define DIGEST_HASH_BASE 1000003ULL
+#define DIGEST_HASH_MOD  ((1ULL << 61) - 1)
+
+//  Most threads for one conversion.
+#define DIGEST_THREADS_MAX 64
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct digest
+//  The digit count and sum are taken from the histogram, which is always kept.
+struct digest {
+  unsigned fields;
+  uint64_t histogram[10];
+  uint64_t hash;
+};
+typedef struct digest digest;
+
+//  MARK: - Prototypes
+void digest_init(digest * dg, unsigned fields);
+void digest_chars(digest * dg, char const * text, size_t length);
+void digest_append(digest * dg, digest const * tail);
+uint64_t digest_digits(digest const * dg);
+uint64_t digest_sum(digest const * dg);
+unsigned digest_fields(char const * spec);
+void digest_mpz(digest * dg, mpz_srcptr num, unsigned threads);
+void digest_header(FILE * out, unsigned fields);
+void digest_row(FILE * out, uint64_t val, digest const * dg);
+bool digest_factorials_gmp(FILE * out, uint64_t nbegin, uint64_t nend, unsigned fields, unsigned threads);
+bool digest_factorials_gfg(FILE * out, uint64_t nbegin, uint64_t nend, unsigned fields);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_digest_h */
@@ -0,0 +1,306 @@
+//
+//  factorial_digits.c
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Low window: n! = 2^a * 5^z * r with r prime to 10, z the number of trailing zeros
+//  and a >= z, so n! = 10^z * 2^(a - z) * r. r is the product of 1 to n with their
+//  factors of 2 and 5 taken out, built in a product tree whose nodes are reduced
+//  mod 10^(pos + count - z) once they grow past it; no node is longer than twice
+//  the window.
+//
+//  High window: the running product is cut back to "precision" bits whenever it is
+//  64 bits longer, once rounding down and once rounding up, so n! lies between the
+//  two. The window is accepted when both bounds give the same leading digits and the
+//  same digit count, and otherwise computed again at twice the precision.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <gmp.h>
+
+#include "factorial_digits.h"
+#include "factorial_stats.h"
+
+//  Factors per leaf of the stripped product tree.
+#define DIGITS_LEAF 32
+
+//  Digits converted beyond the window, and the most times the precision is doubled.
+#define DIGITS_GUARD 10
+#define DIGITS_RETRIES_MAX 8
+
+//  MARK: - Prototypes
+static uint64_t strip_2_5(uint64_t val);
+static void stripped_product(mpz_ptr result, uint64_t lo, uint64_t hi, mpz_srcptr modulus);
+static void truncated_product(mpz_ptr mantissa, uint64_t * exponent, uint64_t n, mp_bitcnt_t precision, bool upward);
+static void cut_back(mpz_ptr mantissa, uint64_t * exponent, mp_bitcnt_t precision, bool upward);
+static char * leading_digits(mpz_srcptr mantissa, uint64_t exponent, size_t count, long * digits);
+
+// MARK: - Implementation
+/*
+ *  MARK: digits_trailing_zeros()
+ *
+ *  The number of trailing decimal zeros of n!, its exponent of 5 (Legendre's formula).
+ */
+uint64_t digits_trailing_zeros(uint64_t n) {
+
+  uint64_t zeros = 0;
+  for (uint64_t q_ = n / 5; q_ > 0; q_ /= 5) {
+    zeros += q_;
+  }
+
+  return zeros;
+}
+
+/*
+ *  MARK: digits_low()
+ *
+ *  window = floor(n! / 10^pos) mod 10^count, the digits pos to pos + count - 1 from the
+ *  least significant. Positions beyond the most significant digit read as zeros.
+ */
+void digits_low(mpz_ptr window, uint64_t n, uint64_t pos, uint64_t count) {
+
+  uint64_t zeros = digits_trailing_zeros(n);
+  if (pos + count <= zeros) {
+    mpz_set_ui(window, 0);
+    return;
+  }
+
+  uint64_t kept = pos + count - zeros;
+  uint64_t twos = n - (uint64_t) __builtin_popcountll(n) - zeros;
+  mpz_t modulus;
+  mpz_t scale;
+
+  mpz_init(modulus);
+  mpz_init(scale);
+  mpz_ui_pow_ui(modulus, 10, kept);
+  stripped_product(window, 1, n + 1, modulus);
+  mpz_set_ui(scale, 2);
+  mpz_powm_ui(scale, scale, twos, modulus);
+  mpz_mul(window, window, scale);
+  mpz_mod(window, window, modulus);
+  STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+  STATS_COUNT(STATS_LIMB_OPS, mpz_size(modulus));
+
+  //  window is now (n! / 10^zeros) mod 10^kept.
+  if (zeros > pos) {
+    mpz_ui_pow_ui(scale, 10, zeros - pos);
+    mpz_mul(window, window, scale);
+  }
+  else {
+    mpz_ui_pow_ui(scale, 10, pos - zeros);
+    mpz_tdiv_q(window, window, scale);
+  }
+  mpz_clear(scale);
+  mpz_clear(modulus);
+
+  return;
+}
+
+/*
+ *  MARK: digits_high()
+ *
+ *  Set text (count + 1 chars) to the leading count digits of n!, or all of them when
+ *  it has fewer, and *digits to its number of digits. Returns false, having reported
+ *  why, when the bounds still disagree at the largest precision tried.
+ */
+bool digits_high(char * text, uint64_t * digits, uint64_t n, size_t count) {
+
+  //  log2(10) < 3.33; the extra bits cover the rounding of every multiplication.
+  mp_bitcnt_t precision = (mp_bitcnt_t) (count + DIGITS_GUARD) * 333 / 100 + 2 * 64 + 64;
+  bool agreed = false;
+  mpz_t lower;
+  mpz_t upper;
+
+  mpz_init(lower);
+  mpz_init(upper);
+  for (unsigned try_ = 0; !agreed && try_ < DIGITS_RETRIES_MAX; ++try_, precision *= 2) {
+    uint64_t lower_exp;
+    uint64_t upper_exp;
+    long lower_digits;
+    long upper_digits;
+
+    truncated_product(lower, &lower_exp, n, precision, false);
+    truncated_product(upper, &upper_exp, n, precision, true);
+    char * lo_text = leading_digits(lower, lower_exp, count, &lower_digits);
+    char * hi_text = leading_digits(upper, upper_exp, count, &upper_digits);
+    size_t shown = lower_digits < (long) count ? (size_t) lower_digits : count;
+
+    //  A lower bound whose guard digits are all 0 may have been rounded up across a
+    //  digit of the window; unless it is exact, look closer.
+    bool exact = lower_exp == 0 && mpz_cmp(lower, upper) == 0;
+    agreed = lower_digits == upper_digits && memcmp(lo_text, hi_text, shown) == 0
+          && (exact || strspn(lo_text + shown, "0") < strlen(lo_text + shown));
+    if (agreed) {
+      memcpy(text, lo_text, shown);
+      text[shown] = '\0';
+      *digits = (uint64_t) lower_digits;
+    }
+    free(lo_text);
+    free(hi_text);
+  }
+  mpz_clear(upper);
+  mpz_clear(lower);
+
+  if (!agreed) {
+    fprintf(stderr, "digits_high: the leading %zu digits of %" PRIu64 "! are not resolved at %lu bits\n",
+            count, n, (unsigned long) precision / 2);
+  }
+
+  return agreed;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: strip_2_5()
+ */
+static uint64_t strip_2_5(uint64_t val) {
+
+  val >>= __builtin_ctzll(val);
+  while (val % 5 == 0) {
+    val /= 5;
+  }
+
+  return val;
+}
+
+/*
+ *  MARK: stripped_product()
+ *
+ *  result = product of lo to hi - 1 with their factors of 2 and 5 removed, reduced mod
+ *  modulus whenever it is longer.
+ */
+static void stripped_product(mpz_ptr result, uint64_t lo, uint64_t hi, mpz_srcptr modulus) {
+
+  if (hi - lo <= DIGITS_LEAF) {
+    uint64_t acc = 1;
+
+    mpz_set_ui(result, 1);
+    for (uint64_t i_ = lo; i_ < hi; ++i_) {
+      uint64_t factor = strip_2_5(i_);
+      if (acc > UINT64_MAX / factor) {
+        mpz_mul_ui(result, result, acc);
+        STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+        STATS_COUNT(STATS_LIMB_OPS, mpz_size(result));
+        acc = factor;
+      }
+      else {
+        acc *= factor;
+      }
+    }
+    mpz_mul_ui(result, result, acc);
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+    STATS_COUNT(STATS_LIMB_OPS, mpz_size(result));
+  }
+  else {
+    uint64_t mid = lo + (hi - lo) / 2;
+    mpz_t right;
+
+    mpz_init(right);
+    stripped_product(result, lo, mid, modulus);
+    stripped_product(right, mid, hi, modulus);
+    mpz_mul(result, result, right);
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+    STATS_COUNT(STATS_LIMB_OPS, mpz_size(result));
+    mpz_clear(right);
+  }
+
+  if (mpz_size(result) > mpz_size(modulus)) {
+    mpz_tdiv_r(result, result, modulus);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: truncated_product()
+ *
+ *  mantissa * 2^exponent = n!, rounded down or up to at least "precision" bits
+ *  whenever the product grows 64 bits past it.
+ */
+static void truncated_product(mpz_ptr mantissa, uint64_t * exponent, uint64_t n, mp_bitcnt_t precision, bool upward) {
+
+  uint64_t acc = 1;
+
+  mpz_set_ui(mantissa, 1);
+  *exponent = 0;
+  for (uint64_t i_ = 2; i_ <= n; ++i_) {
+    if (acc > UINT64_MAX / i_) {
+      mpz_mul_ui(mantissa, mantissa, acc);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      STATS_COUNT(STATS_LIMB_OPS, mpz_size(mantissa));
+      cut_back(mantissa, exponent, precision, upward);
+      acc = i_;
+    }
+    else {
+      acc *= i_;
+    }
+  }
+  mpz_mul_ui(mantissa, mantissa, acc);
+  STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+  STATS_COUNT(STATS_LIMB_OPS, mpz_size(mantissa));
+  cut_back(mantissa, exponent, precision, upward);
+
+  return;
+}
+
+/*
+ *  MARK: cut_back()
+ */
+static void cut_back(mpz_ptr mantissa, uint64_t * exponent, mp_bitcnt_t precision, bool upward) {
+
+  size_t bits = mpz_sizeinbase(mantissa, 2);
+  if (bits > precision + 64) {
+    mp_bitcnt_t shift = bits - precision;
+    if (upward) {
+      mpz_cdiv_q_2exp(mantissa, mantissa, shift);
+    }
+    else {
+      mpz_fdiv_q_2exp(mantissa, mantissa, shift);
+    }
+    *exponent += shift;
+  }
+
+  return;
+}
+
+/*
+ *  MARK: leading_digits()
+ *
+ *  The leading count + DIGITS_GUARD digits of mantissa * 2^exponent, zero-padded, as
+ *  a string to be freed, and the number of digits of its integer part in *digits.
+ */
+static char * leading_digits(mpz_srcptr mantissa, uint64_t exponent, size_t count, long * digits) {
+
+  size_t length = count + DIGITS_GUARD;
+  char * text = malloc(length + 1);
+  mp_exp_t point;
+  mpf_t value;
+
+  mpf_init2(value, (mp_bitcnt_t) mpz_sizeinbase(mantissa, 2) + 64);
+  mpf_set_z(value, mantissa);
+  mpf_mul_2exp(value, value, exponent);
+  char * leading = mpf_get_str(NULL, &point, 10, length, value);
+  mpf_clear(value);
+
+  //  mpf_get_str() leaves off trailing zeros.
+  size_t got = strlen(leading);
+  memcpy(text, leading, got);
+  memset(text + got, '0', length - got);
+  text[length] = '\0';
+  *digits = (long) point;
+
+  void (* free_fn)(void *, size_t);
+  mp_get_memory_functions(NULL, NULL, &free_fn);
+  free_fn(leading, got + 1);
+
+  return text;
+}
@@ -0,0 +1,42 @@
+//
+//  factorial_digits.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Windows of the decimal digits of n! without computing or converting n!.
+//  digits_low() gives the digits at positions pos to pos + count - 1, counted from
+//  the least significant (position 0, the units), from n! mod 10^(pos + count) with
+//  its trailing zeros counted rather than multiplied. digits_high() gives the leading
+//  digits, and the number of digits, from products of n! truncated to a few more
+//  bits than the window needs, one rounded down and one rounded up.
+//
+
+#pragma once
+#ifndef factorial_digits_h
+#define factorial_digits_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Window length when --low-digits is given a position alone.
+#define DIGITS_WINDOW_DEFAULT 50
+
+//  MARK: - Prototypes
+void digits_low(mpz_ptr window, uint64_t n, uint64_t pos, uint64_t count);
+bool digits_high(char * text, uint64_t * digits, uint64_t n, size_t count);
+uint64_t digits_trailing_zeros(uint64_t n);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_digits_h */
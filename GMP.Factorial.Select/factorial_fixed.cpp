@@ -0,0 +1,414 @@
+//
+//  factorial_fixed.cpp
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://gcc.gnu.org/onlinedocs/gcc/Integer-Overflow-Builtins.html
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  The native widths multiply with __builtin_mul_overflow(), which stores the
+//  product wrapped to the width as the original engines did. The wide widths
+//  wrap the same way: the unsigned product mod 2^Bits, read as two's complement
+//  when signed. Nothing is allocated; every buffer is on the stack.
+//
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#include "factorial_fixed.hpp"
+#include "factorial_stats.h"
+#include "factorial_memprof.h"
+
+namespace fixed {
+
+static_assert(FixedWidthFactorial<32, false>::MAX_EXACT_N == 12, "12! is the largest unsigned 32-bit factorial");
+static_assert(FixedWidthFactorial<32, true>::MAX_EXACT_N == 12, "12! is the largest signed 32-bit factorial");
+static_assert(FixedWidthFactorial<64, false>::MAX_EXACT_N == 20, "20! is the largest unsigned 64-bit factorial");
+static_assert(FixedWidthFactorial<64, true>::MAX_EXACT_N == 20, "20! is the largest signed 64-bit factorial");
+static_assert(FixedWidthFactorial<128, false>::MAX_EXACT_N == 34, "34! is the largest unsigned 128-bit factorial");
+static_assert(FixedWidthFactorial<128, true>::MAX_EXACT_N == 33, "33! is the largest signed 128-bit factorial");
+static_assert(FixedWidthFactorial<256, false>::MAX_EXACT_N == 57, "57! is the largest unsigned 256-bit factorial");
+static_assert(FixedWidthFactorial<512, false>::MAX_EXACT_N == 98, "98! is the largest unsigned 512-bit factorial");
+static_assert(FixedWidthFactorial<1024, false>::MAX_EXACT_N == 170, "170! is the largest unsigned 1024-bit factorial");
+
+//  MARK: - Prototypes
+template <unsigned Bits>
+static bool mul_overflow(wide_uint<Bits> & value, uint64_t multiplier, bool is_signed);
+template <typename Native>
+static char * native_to_decimal(Native value, char * buffp);
+template <unsigned Bits>
+static char * wide_to_decimal(wide_uint<Bits> value, bool is_signed, char * buffp);
+
+//  MARK: - Implementation
+/*
+ *  MARK: FixedWidthFactorial::compute()
+ *
+ *  val! by the iterative method, wrapped to the width; overflowed is set if any
+ *  step overflowed.
+ */
+template <unsigned Bits, bool Signed>
+typename FixedWidthFactorial<Bits, Signed>::value_type
+FixedWidthFactorial<Bits, Signed>::compute(uint64_t val, bool & overflowed) {
+
+  value_type fv = value_type(1);
+
+  overflowed = false;
+  for (uint64_t i_ = 1; i_ <= val; ++i_) {
+    bool overflow;
+    if constexpr (Bits <= 128) {
+      overflow = __builtin_mul_overflow(fv, (value_type) i_, &fv);
+    }
+    else {
+      overflow = mul_overflow(fv, i_, Signed);
+    }
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+    STATS_COUNT(STATS_LIMB_OPS, Bits <= 64 ? 1 : Bits / 64);
+    overflowed = overflowed ? overflowed : overflow;
+  }
+
+  return fv;
+}
+
+/*
+ *  MARK: FixedWidthFactorial::to_decimal()
+ *
+ *  buffp must hold DIGITS_MAX + 1 characters.
+ */
+template <unsigned Bits, bool Signed>
+char * FixedWidthFactorial<Bits, Signed>::to_decimal(value_type value, char * buffp) {
+
+  if constexpr (Bits <= 128) {
+    return native_to_decimal(value, buffp);
+  }
+  else {
+    return wide_to_decimal(value, Signed, buffp);
+  }
+}
+
+/*
+ *  MARK: FixedWidthFactorial::print()
+ *
+ *  Calculate and display val!
+ *  Returns the number of characters displayed.
+ */
+template <unsigned Bits, bool Signed>
+int FixedWidthFactorial<Bits, Signed>::print(uint64_t val) {
+
+  bool overflowed;
+  value_type fv = compute(val, overflowed);
+
+  return print_value(val, fv, overflowed);
+}
+
+/*
+ *  MARK: FixedWidthFactorial::print_value()
+ *
+ *  Display the row for val! = fv, wrapped.
+ *  32 and 64 bits are right aligned in 20 columns. From 128 bits on, each value is
+ *  right aligned to the widest value this engine has displayed so far.
+ *  Returns the number of characters displayed.
+ */
+template <unsigned Bits, bool Signed>
+int FixedWidthFactorial<Bits, Signed>::print_value(uint64_t val, value_type fv, bool overflowed) {
+
+  static size_t pwidth_max = 0;
+
+  char const * flag = overflowed ? "*- overflow -*" : "";
+  int pc;
+
+  if constexpr (Bits == 32 && Signed) {
+    pc = printf("%6" PRIu64 "!: %20" PRId32 " %s\n", val, fv, flag);
+  }
+  else if constexpr (Bits == 32) {
+    pc = printf("%6" PRIu64 "!: %20" PRIu32 " %s\n", val, fv, flag);
+  }
+  else if constexpr (Bits == 64 && Signed) {
+    pc = printf("%6" PRIu64 "!: %20" PRId64 " %s\n", val, fv, flag);
+  }
+  else if constexpr (Bits == 64) {
+    pc = printf("%6" PRIu64 "!: %20" PRIu64 " %s\n", val, fv, flag);
+  }
+  else {
+    char nrstr[DIGITS_MAX + 1];
+    char padded[DIGITS_MAX + 1];
+    size_t pwidth_next = std::strlen(to_decimal(fv, nrstr));
+    size_t pad = pwidth_next < pwidth_max ? pwidth_max - pwidth_next : 0;
+
+    std::memset(padded, ' ', pad);
+    std::strcpy(padded + pad, nrstr);
+    pwidth_max = pwidth_next + pad;
+    pc = printf("%6" PRIu64 "!: %20s %s\n", val, padded, flag);
+  }
+
+  return pc;
+}
+
+/*
+ *  MARK: FixedWidthFactorial::table()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ */
+template <unsigned Bits, bool Signed>
+void FixedWidthFactorial<Bits, Signed>::table(char const * name, uint64_t nbegin, uint64_t nend) {
+
+  char pbuff[DIGITS_MAX + 1];
+  wide_uint<Bits> max_value;
+
+  for (unsigned l_ = 0; l_ < wide_uint<Bits>::LIMBS; ++l_) {
+    max_value.limb[l_] = ~(uint64_t) 0;
+  }
+  if (Signed) {
+    max_value.limb[wide_uint<Bits>::LIMBS - 1] >>= 1;
+  }
+  wide_to_decimal(max_value, false, pbuff);
+
+  printf("Function: %s\n", name);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {%u-bit values}:\n\n", nbegin, nend, Bits);
+  printf("......>: %s <-- Max %s %u-bit integer\n", pbuff, Signed ? "signed" : "unsigned", Bits);
+  printf("......>: %20" PRIu64 " <-- %s\n", MAX_EXACT_N, "largest exact n");
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    memprof_row(nb);
+    STATS_COUNT(STATS_BYTES_FORMATTED, print(nb));
+  }
+
+  return;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: mul_overflow()
+ *
+ *  value *= multiplier (>= 1) mod 2^Bits; returns true if the exact product does not
+ *  fit, as unsigned or as two's complement.
+ */
+template <unsigned Bits>
+static bool mul_overflow(wide_uint<Bits> & value, uint64_t multiplier, bool is_signed) {
+
+  bool overflow;
+
+  if (!is_signed) {
+    overflow = value.mul_small(multiplier) != 0;
+  }
+  else {
+    bool negative = value.top_bit();
+    wide_uint<Bits> magnitude = negative ? value.negated() : value;
+    overflow = magnitude.mul_small(multiplier) != 0;
+    if (!overflow && magnitude.top_bit()) {
+      //  Only -2^(Bits - 1) has its top bit set and still fits.
+      wide_uint<Bits> min_value;
+      min_value.limb[wide_uint<Bits>::LIMBS - 1] = (uint64_t) 1 << 63;
+      overflow = !negative || std::memcmp(magnitude.limb, min_value.limb, sizeof(magnitude.limb)) != 0;
+    }
+    value.mul_small(multiplier);
+  }
+
+  return overflow;
+}
+
+/*
+ *  MARK: native_to_decimal()
+ */
+template <typename Native>
+static char * native_to_decimal(Native value, char * buffp) {
+
+  char digits[48];
+  char * next = digits + sizeof(digits);
+  bool negative = value < 0;
+  unsigned __int128 magnitude = negative ? ~(unsigned __int128) value + 1 : (unsigned __int128) value;
+
+  *--next = '\0';
+  do {
+    *--next = (char) ('0' + (int) (magnitude % 10));
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (negative) {
+    *--next = '-';
+  }
+
+  return std::strcpy(buffp, next);
+}
+
+/*
+ *  MARK: wide_to_decimal()
+ *
+ *  Convert 19 digits at a time, from the right.
+ */
+template <unsigned Bits>
+static char * wide_to_decimal(wide_uint<Bits> value, bool is_signed, char * buffp) {
+
+  static uint64_t const CHUNK = UINT64_C(10000000000000000000);
+  char digits[Bits * 30103 / 100000 + 24];
+  char * next = digits + sizeof(digits);
+  bool negative = is_signed && value.top_bit();
+
+  value = negative ? value.negated() : value;
+  *--next = '\0';
+  do {
+    uint64_t chunk = value.div_small(CHUNK);
+    bool last = value.is_zero();
+    for (int d_ = 0; d_ < 19 && (!last || chunk != 0 || d_ == 0); ++d_) {
+      *--next = (char) ('0' + chunk % 10);
+      chunk /= 10;
+    }
+  } while (!value.is_zero());
+  if (negative) {
+    *--next = '-';
+  }
+
+  return std::strcpy(buffp, next);
+}
+
+//  compute() for the native widths is also used to check factorial_batch.cpp.
+template FixedWidthFactorial<32, false>::value_type FixedWidthFactorial<32, false>::compute(uint64_t, bool &);
+template FixedWidthFactorial<32, true>::value_type FixedWidthFactorial<32, true>::compute(uint64_t, bool &);
+template FixedWidthFactorial<64, false>::value_type FixedWidthFactorial<64, false>::compute(uint64_t, bool &);
+template FixedWidthFactorial<64, true>::value_type FixedWidthFactorial<64, true>::compute(uint64_t, bool &);
+template FixedWidthFactorial<128, false>::value_type FixedWidthFactorial<128, false>::compute(uint64_t, bool &);
+template FixedWidthFactorial<128, true>::value_type FixedWidthFactorial<128, true>::compute(uint64_t, bool &);
+
+} /* namespace fixed */
+
+//  MARK: - C interface
+extern "C" {
+
+/*
+ *  MARK: fact_u32() ... fact_u1024()
+ *
+ *  Calculate and display val! with FixedWidthFactorial.
+ */
+void fact_u32(uint64_t val) {
+
+  STATS_COUNT(STATS_BYTES_FORMATTED, (fixed::FixedWidthFactorial<32, false>::print(val)));
+
+  return;
+}
+
+void fact_s32(uint64_t val) {
+
+  STATS_COUNT(STATS_BYTES_FORMATTED, (fixed::FixedWidthFactorial<32, true>::print(val)));
+
+  return;
+}
+
+void fact_u64(uint64_t val) {
+
+  STATS_COUNT(STATS_BYTES_FORMATTED, (fixed::FixedWidthFactorial<64, false>::print(val)));
+
+  return;
+}
+
+void fact_s64(uint64_t val) {
+
+  STATS_COUNT(STATS_BYTES_FORMATTED, (fixed::FixedWidthFactorial<64, true>::print(val)));
+
+  return;
+}
+
+void fact_u128(uint64_t val) {
+
+  STATS_COUNT(STATS_BYTES_FORMATTED, (fixed::FixedWidthFactorial<128, false>::print(val)));
+
+  return;
+}
+
+void fact_s128(uint64_t val) {
+
+  STATS_COUNT(STATS_BYTES_FORMATTED, (fixed::FixedWidthFactorial<128, true>::print(val)));
+
+  return;
+}
+
+void fact_u256(uint64_t val) {
+
+  STATS_COUNT(STATS_BYTES_FORMATTED, (fixed::FixedWidthFactorial<256, false>::print(val)));
+
+  return;
+}
+
+void fact_u512(uint64_t val) {
+
+  STATS_COUNT(STATS_BYTES_FORMATTED, (fixed::FixedWidthFactorial<512, false>::print(val)));
+
+  return;
+}
+
+void fact_u1024(uint64_t val) {
+
+  STATS_COUNT(STATS_BYTES_FORMATTED, (fixed::FixedWidthFactorial<1024, false>::print(val)));
+
+  return;
+}
+
+/*
+ *  MARK: fact_fixed_row()
+ *
+ *  Display the row of the native width engine "bits", is_signed for val! given its
+ *  value wrapped to 128 bits and whether it overflowed the width.
+ */
+void fact_fixed_row(unsigned bits, bool is_signed, uint64_t val, unsigned __int128 wrapped, bool overflowed) {
+
+  int pc = 0;
+
+  switch (bits * 2 + (is_signed ? 1 : 0)) {
+    case 64:
+      pc = fixed::FixedWidthFactorial<32, false>::print_value(val, (uint32_t) wrapped, overflowed);
+      break;
+
+    case 65:
+      pc = fixed::FixedWidthFactorial<32, true>::print_value(val, (int32_t) (uint32_t) wrapped, overflowed);
+      break;
+
+    case 128:
+      pc = fixed::FixedWidthFactorial<64, false>::print_value(val, (uint64_t) wrapped, overflowed);
+      break;
+
+    case 129:
+      pc = fixed::FixedWidthFactorial<64, true>::print_value(val, (int64_t) (uint64_t) wrapped, overflowed);
+      break;
+
+    case 256:
+      pc = fixed::FixedWidthFactorial<128, false>::print_value(val, wrapped, overflowed);
+      break;
+
+    case 257:
+      pc = fixed::FixedWidthFactorial<128, true>::print_value(val, (__int128) wrapped, overflowed);
+      break;
+
+    default:
+      break;
+  }
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+
+  return;
+}
+
+/*
+ *  MARK: factorial_u256() ... factorial_u1024()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ */
+void factorial_u256(uint64_t nbegin, uint64_t nend) {
+
+  fixed::FixedWidthFactorial<256, false>::table(__func__, nbegin, nend);
+
+  return;
+}
+
+void factorial_u512(uint64_t nbegin, uint64_t nend) {
+
+  fixed::FixedWidthFactorial<512, false>::table(__func__, nbegin, nend);
+
+  return;
+}
+
+void factorial_u1024(uint64_t nbegin, uint64_t nend) {
+
+  fixed::FixedWidthFactorial<1024, false>::table(__func__, nbegin, nend);
+
+  return;
+}
+
+} /* extern "C" */
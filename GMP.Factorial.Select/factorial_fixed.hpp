@@ -0,0 +1,168 @@
+//
+//  factorial_fixed.hpp
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Fixed width factorial engines.
+//  FixedWidthFactorial<Bits, Signed> computes val! by the iterative method in a
+//  Bits wide integer, flagging overflow, and prints it in the format of the
+//  original u32 ... s128 engines. 32, 64 and 128 bits use the native types;
+//  256, 512 and 1024 bits use wide_uint, a fixed array of 64-bit limbs on the
+//  stack. The largest exact n for each width is known at compile time.
+//
+
+#pragma once
+#ifndef factorial_fixed_hpp
+#define factorial_fixed_hpp
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace fixed {
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct wide_uint
+//  Bits wide unsigned integer, little-endian 64-bit limbs, arithmetic mod 2^Bits.
+template <unsigned Bits>
+struct wide_uint {
+  static_assert(Bits % 64 == 0 && Bits >= 64, "wide_uint is a whole number of 64-bit limbs");
+  static constexpr unsigned LIMBS = Bits / 64;
+
+  uint64_t limb[LIMBS];
+
+  constexpr wide_uint() : limb {} {}
+  constexpr explicit wide_uint(uint64_t value) : limb {} { limb[0] = value; }
+
+  constexpr bool is_zero() const {
+    for (unsigned l_ = 0; l_ < LIMBS; ++l_) {
+      if (limb[l_] != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  constexpr bool top_bit() const {
+    return (limb[LIMBS - 1] >> 63) != 0;
+  }
+
+  //  *this *= multiplier mod 2^Bits; returns the part of the product above 2^Bits.
+  constexpr uint64_t mul_small(uint64_t multiplier) {
+    uint64_t carry = 0;
+    for (unsigned l_ = 0; l_ < LIMBS; ++l_) {
+      unsigned __int128 prod = (unsigned __int128) limb[l_] * multiplier + carry;
+      limb[l_] = (uint64_t) prod;
+      carry = (uint64_t) (prod >> 64);
+    }
+    return carry;
+  }
+
+  //  *this /= divisor; returns the remainder.
+  constexpr uint64_t div_small(uint64_t divisor) {
+    unsigned __int128 rem = 0;
+    for (unsigned l_ = LIMBS; l_ > 0; --l_) {
+      unsigned __int128 cur = (rem << 64) | limb[l_ - 1];
+      limb[l_ - 1] = (uint64_t) (cur / divisor);
+      rem = cur % divisor;
+    }
+    return (uint64_t) rem;
+  }
+
+  //  Two's complement negation.
+  constexpr wide_uint negated() const {
+    wide_uint neg;
+    uint64_t carry = 1;
+    for (unsigned l_ = 0; l_ < LIMBS; ++l_) {
+      neg.limb[l_] = ~limb[l_] + carry;
+      carry = (carry != 0 && neg.limb[l_] == 0) ? 1 : 0;
+    }
+    return neg;
+  }
+};
+
+//  MARK: - Prototypes
+constexpr uint64_t max_exact_n(unsigned value_bits);
+
+//  MARK: class FixedWidthFactorial
+template <unsigned Bits, bool Signed>
+class FixedWidthFactorial {
+public:
+  typedef typename std::conditional<Bits == 32, typename std::conditional<Signed, int32_t, uint32_t>::type,
+          typename std::conditional<Bits == 64, typename std::conditional<Signed, int64_t, uint64_t>::type,
+          typename std::conditional<Bits == 128, typename std::conditional<Signed, __int128, unsigned __int128>::type,
+          wide_uint<Bits>>::type>::type>::type value_type;
+
+  //  Largest n for which n! is held exactly.
+  static constexpr uint64_t MAX_EXACT_N = max_exact_n(Signed ? Bits - 1 : Bits);
+  //  Decimal digits of the widest value, plus a sign.
+  static constexpr size_t DIGITS_MAX = (size_t) Bits * 30103 / 100000 + 2;
+
+  static value_type compute(uint64_t val, bool & overflowed);
+  static char * to_decimal(value_type value, char * buffp);
+  static int print(uint64_t val);
+  static int print_value(uint64_t val, value_type fv, bool overflowed);
+  static void table(char const * name, uint64_t nbegin, uint64_t nend);
+};
+
+//  MARK: - Implementation
+/*
+ *  MARK: max_exact_n()
+ *
+ *  Largest n with n! < 2^value_bits (value_bits <= 1024).
+ */
+constexpr uint64_t max_exact_n(unsigned value_bits) {
+
+  wide_uint<1088> fact(1);
+  uint64_t n_fact = 0;
+
+  for (;;) {
+    wide_uint<1088> next = fact;
+    next.mul_small(n_fact + 1);
+    unsigned bits = 0;
+    for (unsigned l_ = wide_uint<1088>::LIMBS; l_ > 0 && bits == 0; --l_) {
+      for (unsigned b_ = 64; b_ > 0 && bits == 0; --b_) {
+        if (((next.limb[l_ - 1] >> (b_ - 1)) & 1) != 0) {
+          bits = (l_ - 1) * 64 + b_;
+        }
+      }
+    }
+    if (bits > value_bits) {
+      return n_fact;
+    }
+    fact = next;
+    ++n_fact;
+  }
+}
+
+} /* namespace fixed */
+
+extern "C" {
+#else
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+//  MARK: - C interface
+void fact_u32(uint64_t val);
+void fact_s32(uint64_t val);
+void fact_u64(uint64_t val);
+void fact_s64(uint64_t val);
+void fact_u128(uint64_t val);
+void fact_s128(uint64_t val);
+void fact_u256(uint64_t val);
+void fact_u512(uint64_t val);
+void fact_u1024(uint64_t val);
+void fact_fixed_row(unsigned bits, bool is_signed, uint64_t val, unsigned __int128 wrapped, bool overflowed);
+void factorial_u256(uint64_t nbegin, uint64_t nend);
+void factorial_u512(uint64_t nbegin, uint64_t nend);
+void factorial_u1024(uint64_t nbegin, uint64_t nend);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_fixed_hpp */
@@ -0,0 +1,242 @@
+//
+//  factorial_fused.c
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  The sweep multiplies nbegin! up to nend! one factor at a time, so every n costs
+//  one mpz_mul_ui() however many tables show it. Only the running product is held,
+//  not the exact value of every row: fused_exact() rebuilds those for the GMP and
+//  GMP-free tables from a cursor that follows them, one mpz_mul_ui() per row shown
+//  in order, so the sweep holds one value the size of nend! at a time.
+//
+//  Rounding: the value is cut to its leading "digits" bits and rounded to nearest,
+//  ties to even, from the next bit and whether any bit below it is set; the result
+//  is then scaled by a power of two, which is exact, or overflows to infinity.
+//  Casting the mpz (mpz_get_d()) would truncate instead.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <float.h>
+#include <math.h>
+#include <gmp.h>
+
+#include "factorial_fused.h"
+#include "factorial_stats.h"
+#include "factorial_memprof.h"
+
+//  MARK: - Prototypes
+static unsigned __int128 round_mantissa(mpz_srcptr num, unsigned digits, long * exponent);
+
+//  MARK: - Sweep state
+static fused_row * rows = NULL;
+static uint64_t rows_first = 0;
+static size_t rows_c = 0;
+static mpz_t cursor;                  //  cursor_n! once cursor_init
+static uint64_t cursor_n = 0;
+static bool cursor_init = false;
+
+// MARK: - Implementation
+/*
+ *  MARK: fused_sweep()
+ *
+ *  Compute the rows for nbegin! to nend!, replacing any earlier sweep.
+ *  Returns false, having reported why, when they do not fit in memory.
+ */
+bool fused_sweep(uint64_t nbegin, uint64_t nend) {
+
+  fused_release();
+  if (nend < nbegin) {
+    return true;
+  }
+
+  size_t count = (size_t) (nend - nbegin + 1);
+  rows = memprof_calloc(count, sizeof(*rows));
+  if (rows == NULL) {
+    fprintf(stderr, "fused: no memory for %zu rows\n", count);
+    return false;
+  }
+  rows_first = nbegin;
+  rows_c = count;
+
+  float flt = 1;
+  double dbl = 1;
+  long double ldbl = 1;
+  for (uint64_t i_ = 1; i_ < nbegin; ++i_) {
+    flt = flt * i_;
+    dbl = dbl * i_;
+    ldbl = ldbl * i_;
+  }
+
+  mpz_t exact;
+  mpz_init(exact);
+  for (size_t r_ = 0; r_ < count; ++r_) {
+    uint64_t nb = nbegin + r_;
+    fused_row * row = &rows[r_];
+
+    memprof_row(nb);
+    if (r_ == 0) {
+      mpz_fac_ui(exact, nb);
+    }
+    else {
+      mpz_mul_ui(exact, exact, nb);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      STATS_COUNT(STATS_LIMB_OPS, mpz_size(exact));
+    }
+    row->wrapped = (unsigned __int128) mpz_getlimbn(exact, 1) << 64 | mpz_getlimbn(exact, 0);
+    row->bits = mpz_sizeinbase(exact, 2);
+    row->flt = fused_round_float(exact);
+    row->dbl = fused_round_double(exact);
+    row->ldbl = fused_round_longdouble(exact);
+
+    if (nb > 0) {
+      flt = flt * nb;
+      dbl = dbl * nb;
+      ldbl = ldbl * nb;
+    }
+    row->flt_iterative = flt;
+    row->dbl_iterative = dbl;
+    row->ldbl_iterative = ldbl;
+  }
+  mpz_clear(exact);
+
+  return true;
+}
+
+/*
+ *  MARK: fused_lookup()
+ *
+ *  The row for val! from the current sweep, or NULL if there is none.
+ */
+fused_row const * fused_lookup(uint64_t val) {
+
+  if (rows == NULL || val < rows_first || val - rows_first >= rows_c) {
+    return NULL;
+  }
+
+  return &rows[val - rows_first];
+}
+
+/*
+ *  MARK: fused_exact()
+ *
+ *  val! for a row of the current sweep, or NULL if there is none. The value is
+ *  carried forward from the previous call, so a table walking the sweep in order
+ *  costs one mpz_mul_ui() per row; any other step starts again from mpz_fac_ui().
+ *  It stays valid until the next call or fused_release().
+ */
+mpz_srcptr fused_exact(uint64_t val) {
+
+  if (fused_lookup(val) == NULL) {
+    return NULL;
+  }
+
+  if (!cursor_init) {
+    mpz_init(cursor);
+    cursor_init = true;
+    mpz_fac_ui(cursor, val);
+  }
+  else if (val == cursor_n + 1) {
+    mpz_mul_ui(cursor, cursor, val);
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+    STATS_COUNT(STATS_LIMB_OPS, mpz_size(cursor));
+  }
+  else if (val != cursor_n) {
+    mpz_fac_ui(cursor, val);
+  }
+  cursor_n = val;
+
+  return cursor;
+}
+
+/*
+ *  MARK: fused_release()
+ */
+void fused_release(void) {
+
+  if (cursor_init) {
+    mpz_clear(cursor);
+    cursor_init = false;
+  }
+  cursor_n = 0;
+  memprof_free(rows);
+  rows = NULL;
+  rows_first = 0;
+  rows_c = 0;
+
+  return;
+}
+
+/*
+ *  MARK: fused_round_float() ... fused_round_longdouble()
+ *
+ *  num (> 0) correctly rounded, to nearest with ties to even.
+ */
+float fused_round_float(mpz_srcptr num) {
+
+  long exponent;
+  unsigned __int128 mantissa = round_mantissa(num, FLT_MANT_DIG, &exponent);
+
+  return exponent > FLT_MAX_EXP ? INFINITY : ldexpf((float) mantissa, (int) exponent);
+}
+
+double fused_round_double(mpz_srcptr num) {
+
+  long exponent;
+  unsigned __int128 mantissa = round_mantissa(num, DBL_MANT_DIG, &exponent);
+
+  return exponent > DBL_MAX_EXP ? INFINITY : ldexp((double) mantissa, (int) exponent);
+}
+
+long double fused_round_longdouble(mpz_srcptr num) {
+
+  long exponent;
+  unsigned __int128 mantissa = round_mantissa(num, LDBL_MANT_DIG, &exponent);
+
+  return exponent > LDBL_MAX_EXP ? (long double) INFINITY : ldexpl((long double) mantissa, (int) exponent);
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: round_mantissa()
+ *
+ *  num = mantissa * 2^exponent after rounding num to "digits" (<= 64) bits.
+ */
+static unsigned __int128 round_mantissa(mpz_srcptr num, unsigned digits, long * exponent) {
+
+  size_t bits = mpz_sizeinbase(num, 2);
+  unsigned __int128 mantissa;
+
+  if (bits <= digits) {
+    *exponent = 0;
+    return (unsigned __int128) mpz_getlimbn(num, 1) << 64 | mpz_getlimbn(num, 0);
+  }
+
+  mpz_t top;
+  mp_bitcnt_t shift = bits - digits;
+
+  mpz_init(top);
+  mpz_tdiv_q_2exp(top, num, shift);
+  mantissa = mpz_get_ui(top);
+  mpz_clear(top);
+
+  bool round = mpz_tstbit(num, shift - 1) != 0;
+  bool sticky = shift > 1 && mpz_scan1(num, 0) < shift - 1;
+  if (round && (sticky || (mantissa & 1) != 0)) {
+    ++mantissa;
+    if (mantissa >> digits != 0) {
+      mantissa >>= 1;
+      ++shift;
+    }
+  }
+  *exponent = (long) shift;
+
+  return mantissa;
+}
@@ -0,0 +1,57 @@
+//
+//  factorial_fused.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Single-pass computation for the default drivers.
+//  fused_sweep() computes nbegin! to nend! once, exactly, with GMP and keeps what
+//  the fixed width and floating point tables show: the low 128 bits of each value
+//  (the value of every fixed width engine, wrapped), its length in bits (which says
+//  whether it overflowed) and its correctly rounded float, double and long double,
+//  alongside the iterative products the floating point engines display.
+//  fused_exact() gives the exact value of a swept row back to the GMP tables.
+//
+
+#pragma once
+#ifndef factorial_fused_h
+#define factorial_fused_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct fused_row
+struct fused_row {
+  unsigned __int128 wrapped;    //  exact mod 2^128
+  size_t            bits;       //  length of exact in bits
+  float             flt;        //  exact, correctly rounded
+  double            dbl;
+  long double       ldbl;
+  float             flt_iterative;   //  1 * 2 * ... * n in the type
+  double            dbl_iterative;
+  long double       ldbl_iterative;
+};
+typedef struct fused_row fused_row;
+
+//  MARK: - Prototypes
+bool fused_sweep(uint64_t nbegin, uint64_t nend);
+fused_row const * fused_lookup(uint64_t val);
+mpz_srcptr fused_exact(uint64_t val);
+void fused_release(void);
+float fused_round_float(mpz_srcptr num);
+double fused_round_double(mpz_srcptr num);
+long double fused_round_longdouble(mpz_srcptr num);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_fused_h */
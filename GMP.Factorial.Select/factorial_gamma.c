@@ -0,0 +1,464 @@
+//
+//  factorial_gamma.c
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://dlmf.nist.gov/5.11 (Stirling's series)
+//  @see: https://dlmf.nist.gov/5.5 (recurrence, reflection)
+//  @see: https://gcc.gnu.org/onlinedocs/gcc/Vector-Extensions.html
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  For w >= 10, ln Γ(w) = (w − ½) ln w − w + ln √(2π) + Σ B₂ₖ / (2k (2k − 1) w^(2k−1)),
+//  Stirling's series to k = 8, whose truncation error there is below 10^-17.
+//  Smaller arguments are shifted up by the recurrence, ln Γ(x) = ln Γ(x + 10) −
+//  ln x (x + 1) ... (x + 9), which costs nine multiplications and a logarithm.
+//  The arguments are taken GAMMA_LANES at a time in GCC/Clang vector types, and
+//  every lane follows the same instructions: the logarithm and exponential are
+//  evaluated here from their bit patterns and polynomials rather than by calls to
+//  log() and exp(), which would stop the compiler from keeping the lanes together,
+//  and special arguments are patched afterwards with masks instead of branches.
+//  The float entry points compute in double and round once at the end.
+//  Negative arguments are reflected: the block evaluates 1 − x, and Γ(x) Γ(1 − x) =
+//  π / sin πx is applied to those lanes afterwards one at a time.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "factorial_gamma.h"
+#include "factorial_stats.h"
+
+//  MARK: - Definitions
+//  Doubles in the widest vector register the target is compiled for: two for SSE2
+//  and NEON, which every target has.
+#if defined(__AVX512F__)
+#define GAMMA_LANES 8
+#elif defined(__AVX__)
+#define GAMMA_LANES 4
+#else
+#define GAMMA_LANES 2
+#endif
+//  Vectors evaluated a stage at a time.
+#define GAMMA_BLOCK 32
+//  Arguments evaluated at a time by gamma_check().
+#define CHECK_BATCH 4096
+
+//  MARK: - Definition of typedef, union, structure, etc.
+typedef double  vdouble __attribute__((vector_size(GAMMA_LANES * sizeof(double))));
+typedef int64_t vint    __attribute__((vector_size(GAMMA_LANES * sizeof(int64_t))));
+typedef uint64_t vuint  __attribute__((vector_size(GAMMA_LANES * sizeof(uint64_t))));
+
+//  MARK: struct gamma_worst
+//  Largest errors found by gamma_check(), and where.
+struct gamma_worst {
+  long double lg;
+  long double tg;
+  double      lg_x;
+  double      tg_x;
+};
+typedef struct gamma_worst gamma_worst;
+
+//  MARK: - Constants
+//  Arguments below stirling_min are shifted up by stirling_min.
+static double const stirling_min = 10.0;
+//  B(2k) / (2k (2k − 1)) for 1 <= k <= 8.
+static double const stirling_c[] = {
+  1.0 / 12, -1.0 / 360, 1.0 / 1260, -1.0 / 1680, 1.0 / 1188, -691.0 / 360360, 1.0 / 156, -3617.0 / 122400,
+};
+
+static double const ln_sqrt_2pi = 0.91893853320467274178;
+//  ln 2 split so that k * ln2_hi is exact for |k| < 2^11.
+static double const ln2_hi = 6.93147180369123816490e-01;
+static double const ln2_lo = 1.90821492927058770002e-10;
+static double const log2_e = 1.44269504088896338700;
+//  Largest and smallest arguments for which exp() is finite and normal.
+static double const exp_max = 709.782712893383973096;
+static double const exp_min = -708.396418532264106224;
+
+//  Minimax polynomials for the logarithm and the exponential, from fdlibm's e_log.c
+//  and e_exp.c.
+static double const log_c[] = {
+  6.666666666666735130e-01, 3.999999999940941908e-01, 2.857142874366239149e-01,
+  2.222219843214978396e-01, 1.818357216161805012e-01, 1.531383769920937332e-01,
+  1.479819860511658591e-01,
+};
+static double const exp_c[] = {
+  1.66666666666666019037e-01, -2.77777777770155933842e-03, 6.61375632143793436117e-05,
+  -1.65339022054652515390e-06, 4.13813679705723846039e-08,
+};
+
+//  MARK: - Prototypes
+static double reflect(double x, double value, bool gamma);
+static void check_points(double const x[], size_t count, gamma_worst * worst);
+
+//  MARK: - Implementation
+/*
+ *  MARK: vsplat()
+ *
+ *  value in every lane.
+ */
+static inline vdouble vsplat(double value) {
+
+  vdouble v = { 0, };
+
+  return v + value;
+}
+
+/*
+ *  MARK: vselect()
+ *
+ *  Lanes of a where mask is set, of b elsewhere.
+ */
+static inline vdouble vselect(vint mask, vdouble a, vdouble b) {
+
+  return (vdouble) ((vint) b ^ (((vint) a ^ (vint) b) & mask));
+}
+
+/*
+ *  MARK: vlog_reduce() / vlog_finish() / vlog()
+ *
+ *  Natural logarithm of positive lanes, subnormals scaled up first. x = 2^k (1 + f)
+ *  with √½ <= 1 + f < √2, and ln(1 + f) = 2 atanh s for s = f / (2 + f), the odd
+ *  part of which is a degree 7 polynomial in s². Infinite and NaN lanes are passed
+ *  through. The division for s is left to the caller of vlog_finish(), which can
+ *  share it with another.
+ */
+static inline vdouble vlog_reduce(vdouble x, vdouble * kd) {
+
+  vint subnormal = x < DBL_MIN;
+  vuint bits = (vuint) vselect(subnormal, x * 0x1p54, x);
+  vint k = (vint) ((bits >> 52) & 0x7ff) - 1023 - (subnormal & 54);
+  vdouble m = (vdouble) ((bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL);
+
+  vint big = m > 1.41421356237309504880;
+  m = vselect(big, m * 0.5, m);
+  //  k + 1.5 * 2^52 in the bits of a double: subtracting 1.5 * 2^52 converts it exactly.
+  *kd = (vdouble) ((k - big) + 0x4338000000000000LL) - 6755399441055744.0;
+
+  return m - 1.0;
+}
+
+static inline vdouble vlog_finish(vdouble x, vdouble kd, vdouble f, vdouble s) {
+
+  vdouble z = s * s;
+  vdouble r = z * (log_c[0] + z * (log_c[1] + z * (log_c[2] + z * (log_c[3] + z * (log_c[4] + z * (log_c[5] + z * log_c[6]))))));
+  vdouble hfsq = 0.5 * f * f;
+  vdouble ln = kd * ln2_hi - ((hfsq - (s * (hfsq + r) + kd * ln2_lo)) - f);
+
+  vint special = (x == __builtin_inf()) | (x != x);
+
+  return vselect(special, x, ln);
+}
+
+static inline vdouble vlog(vdouble x) {
+
+  vdouble kd;
+  vdouble f = vlog_reduce(x, &kd);
+
+  return vlog_finish(x, kd, f, f / (2.0 + f));
+}
+
+/*
+ *  MARK: vexp()
+ *
+ *  Exponential. y = k ln 2 + r with |r| <= ½ ln 2, e^r from a rational function of r,
+ *  scaled by 2^k built in the exponent field. +∞ above exp_max, 0 below exp_min.
+ *  Up to exp_max k reaches 1024, which has no exponent field of its own, so there
+ *  the scaling is 2^1023 and then 2.
+ */
+static inline vdouble vexp(vdouble y) {
+
+  vdouble shifter = vsplat(6755399441055744.0);    // 1.5 * 2^52: adding it rounds to an integer
+  vdouble kd = (y * log2_e + shifter) - shifter;
+  vdouble hi = y - kd * ln2_hi;
+  vdouble lo = kd * ln2_lo;
+  vdouble r = hi - lo;
+  vdouble t = r * r;
+  vdouble c = r - t * (exp_c[0] + t * (exp_c[1] + t * (exp_c[2] + t * (exp_c[3] + t * exp_c[4]))));
+  vdouble er = 1.0 - ((lo - (r * c) / (2.0 - c)) - hi);
+
+  vint over = y > exp_max;
+  vint under = y < exp_min;
+  vint k = (vint) (vselect(over | under, vsplat(0.0), kd) + shifter) - (vint) shifter;
+  vint top = (k > 1023) & 1;
+  vdouble ex = er * (vdouble) ((k - top + 1023) << 52) * (vdouble) ((top + 1023) << 52);
+  ex = vselect(over, vsplat(__builtin_inf()), ex);
+  ex = vselect(under, vsplat(0.0), ex);
+
+  return ex;
+}
+
+/*
+ *  MARK: lgamma_block()
+ *
+ *  v[i] = ln Γ(v[i]) for 0 <= i < vc <= GAMMA_BLOCK, or Γ(v[i]) when gamma is set:
+ *  +∞ where v = 0 or +∞, NaN where v < 0 or NaN. Each stage is a loop over the
+ *  block, so the evaluations of different vectors are independent and overlap in
+ *  the pipeline. Lanes below stirling_min use w = x + 10 and subtract ln x (x + 1)
+ *  ... (x + 9); the second logarithm is skipped for a block without such lanes.
+ */
+static void lgamma_block(vdouble v[], size_t vc, bool gamma) {
+
+  vdouble w[GAMMA_BLOCK];
+  vdouble product[GAMMA_BLOCK];
+  vint shifted = { 0, };
+
+  for (size_t i_ = 0; i_ < vc; ++i_) {
+    vint shift = v[i_] < stirling_min;
+    vdouble p = v[i_];
+    for (int j_ = 1; j_ < (int) stirling_min; ++j_) {
+      p *= v[i_] + (double) j_;
+    }
+    product[i_] = vselect(shift, p, vsplat(1.0));
+    w[i_] = vselect(shift, v[i_] + stirling_min, v[i_]);
+    shifted |= shift;
+  }
+
+  bool any_shifted = false;
+  for (size_t l_ = 0; l_ < GAMMA_LANES; ++l_) {
+    any_shifted = any_shifted || shifted[l_] != 0;
+  }
+  if (any_shifted) {
+    for (size_t i_ = 0; i_ < vc; ++i_) {
+      product[i_] = vlog(product[i_]);
+    }
+  }
+
+  for (size_t i_ = 0; i_ < vc; ++i_) {
+    vdouble x = v[i_];
+    //  One division for both 1/w and s = f / (2 + f) of ln w.
+    vdouble kd;
+    vdouble f = vlog_reduce(w[i_], &kd);
+    vdouble q = 1.0 / ((2.0 + f) * w[i_]);
+    vdouble u = (2.0 + f) * q;
+    vdouble u2 = u * u;
+    vdouble series = stirling_c[0] + u2 * (stirling_c[1] + u2 * (stirling_c[2] + u2 * (stirling_c[3]
+                   + u2 * (stirling_c[4] + u2 * (stirling_c[5] + u2 * (stirling_c[6] + u2 * stirling_c[7]))))));
+    vdouble lg = (w[i_] - 0.5) * (vlog_finish(w[i_], kd, f, f * w[i_] * q) - 1.0) - 0.5 + ln_sqrt_2pi + series * u;
+    if (any_shifted) {
+      lg -= product[i_];
+    }
+
+    lg = vselect(x == __builtin_inf(), x, lg);
+    lg = vselect(x == 0.0, vsplat(__builtin_inf()), lg);
+    v[i_] = vselect((x < 0.0) | (x != x), vsplat(__builtin_nan("")), lg);
+  }
+
+  if (gamma) {
+    for (size_t i_ = 0; i_ < vc; ++i_) {
+      v[i_] = vexp(v[i_]);
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: gamma_batch() / gamma_batchf()
+ *
+ *  Run lgamma_block() over the arrays a block at a time, the last vector padded with 1
+ *  and negative arguments x replaced by 1 − x, then reflected.
+ */
+static void gamma_batch(double const x[], double y[], size_t count, bool gamma) {
+
+  vdouble block[GAMMA_BLOCK];
+
+  for (size_t i_ = 0; i_ < count; i_ += GAMMA_BLOCK * GAMMA_LANES) {
+    size_t n = count - i_ < GAMMA_BLOCK * GAMMA_LANES ? count - i_ : GAMMA_BLOCK * GAMMA_LANES;
+    size_t vc = (n + GAMMA_LANES - 1) / GAMMA_LANES;
+    bool negative = false;
+    block[vc - 1] = vsplat(1.0);
+    for (size_t j_ = 0; j_ < n; ++j_) {
+      block[j_ / GAMMA_LANES][j_ % GAMMA_LANES] = x[i_ + j_] < 0.0 ? 1.0 - x[i_ + j_] : x[i_ + j_];
+      negative = negative || x[i_ + j_] < 0.0;
+    }
+    lgamma_block(block, vc, gamma);
+    for (size_t j_ = 0; negative && j_ < n; ++j_) {
+      if (x[i_ + j_] < 0.0) {
+        block[j_ / GAMMA_LANES][j_ % GAMMA_LANES] = reflect(x[i_ + j_], block[j_ / GAMMA_LANES][j_ % GAMMA_LANES], gamma);
+      }
+    }
+    memcpy(y + i_, block, n * sizeof(*y));
+  }
+  STATS_COUNT(STATS_MULTIPLICATIONS, count);
+
+  return;
+}
+
+static void gamma_batchf(float const x[], float y[], size_t count, bool gamma) {
+
+  vdouble block[GAMMA_BLOCK];
+
+  for (size_t i_ = 0; i_ < count; i_ += GAMMA_BLOCK * GAMMA_LANES) {
+    size_t n = count - i_ < GAMMA_BLOCK * GAMMA_LANES ? count - i_ : GAMMA_BLOCK * GAMMA_LANES;
+    size_t vc = (n + GAMMA_LANES - 1) / GAMMA_LANES;
+    block[vc - 1] = vsplat(1.0);
+    for (size_t j_ = 0; j_ < n; ++j_) {
+      block[j_ / GAMMA_LANES][j_ % GAMMA_LANES] = x[i_ + j_] < 0.0f ? 1.0 - (double) x[i_ + j_] : (double) x[i_ + j_];
+    }
+    lgamma_block(block, vc, gamma);
+    for (size_t j_ = 0; j_ < n; ++j_) {
+      double value = block[j_ / GAMMA_LANES][j_ % GAMMA_LANES];
+      y[i_ + j_] = (float) (x[i_ + j_] < 0.0f ? reflect((double) x[i_ + j_], value, gamma) : value);
+    }
+  }
+  STATS_COUNT(STATS_MULTIPLICATIONS, count);
+
+  return;
+}
+
+/*
+ *  MARK: gamma_lgamma_batch() / gamma_tgamma_batch()
+ *
+ *  y[i] = ln |Γ(x[i])| or Γ(x[i]) for 0 <= i < count; Γ is +∞ beyond about 171.62.
+ *  At 0 and the negative integers ln |Γ| is +∞ and Γ is NaN (+∞ at 0). y may be x.
+ */
+void gamma_lgamma_batch(double const x[], double y[], size_t count) {
+
+  gamma_batch(x, y, count, false);
+
+  return;
+}
+
+void gamma_tgamma_batch(double const x[], double y[], size_t count) {
+
+  gamma_batch(x, y, count, true);
+
+  return;
+}
+
+/*
+ *  MARK: gamma_lgammaf_batch() / gamma_tgammaf_batch()
+ *
+ *  Single precision: evaluated in double, rounded once.
+ */
+void gamma_lgammaf_batch(float const x[], float y[], size_t count) {
+
+  gamma_batchf(x, y, count, false);
+
+  return;
+}
+
+void gamma_tgammaf_batch(float const x[], float y[], size_t count) {
+
+  gamma_batchf(x, y, count, true);
+
+  return;
+}
+
+/*
+ *  MARK: gamma_check()
+ *
+ *  Compare the batched functions with lgammal() and tgammal() at x = n + j/16,
+ *  1 <= j <= 16, for nbegin <= n <= nend, i.e. the factorials of nbegin − 15/16 ...
+ *  nend in steps of 1/16; then in steps of 1/1024 across the overflow of Γ near
+ *  171.62, and at the non-integers from −20 to 0 in steps of 1/16. Where Γ(x) is
+ *  beyond DBL_MAX the result must be +∞. Returns true when every error is within
+ *  the documented bounds.
+ */
+bool gamma_check(uint64_t nbegin, uint64_t nend) {
+
+  double x[CHECK_BATCH];
+  gamma_worst worst = { 0.0L, 0.0L, 0.0, 0.0, };
+
+  printf("Function: %s\n", __func__);
+  printf("Log-factorials from %" PRIu64 " to %" PRIu64 " in steps of 1/16 {batched Stirling series vs lgammal}:\n\n", nbegin, nend);
+  uint64_t steps = (nend - nbegin + 1) * 16;
+  for (uint64_t s_ = 0; nend >= nbegin && s_ < steps; s_ += CHECK_BATCH) {
+    size_t count = steps - s_ < CHECK_BATCH ? (size_t) (steps - s_) : CHECK_BATCH;
+    for (size_t i_ = 0; i_ < count; ++i_) {
+      x[i_] = (double) nbegin + (double) (s_ + i_ + 1) / 16.0;
+    }
+    check_points(x, count, &worst);
+  }
+
+  size_t edges = 0;
+  for (int j_ = 0; j_ < 160; ++j_) {
+    x[edges++] = 171.5 + (double) j_ / 1024.0;
+  }
+  for (int j_ = 1; j_ <= 20 * 16; ++j_) {
+    if (j_ % 16 != 0) {
+      x[edges++] = -(double) j_ / 16.0;
+    }
+  }
+  check_points(x, edges, &worst);
+
+  bool within = worst.lg <= GAMMA_LGAMMA_ERROR && worst.tg <= GAMMA_TGAMMA_ERROR;
+  printf("......>: %20.3e <-- %s\n", GAMMA_LGAMMA_ERROR, "GAMMA_LGAMMA_ERROR");
+  printf("......>: %20.3e <-- %s\n", GAMMA_TGAMMA_ERROR, "GAMMA_TGAMMA_ERROR");
+  printf("lgamma: %20.3Le at x = %.4f\n", worst.lg, worst.lg_x);
+  printf("tgamma: %20.3Le at x = %.4f\n", worst.tg, worst.tg_x);
+  printf("\n%s\n", within ? "All values within the bounds." : "*- Errors exceed the bounds -*");
+
+  return within;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: reflect()
+ *
+ *  ln |Γ(x)| or Γ(x) for x < 0 from value = ln Γ(1 − x) or Γ(1 − x), by
+ *  Γ(x) Γ(1 − x) = π / sin πx. sin πx is taken from the fraction of x, which is
+ *  exact, rather than from πx, which is not.
+ */
+static double reflect(double x, double value, bool gamma) {
+
+  double whole = floor(x);
+  if (x == whole) {
+    return gamma ? __builtin_nan("") : __builtin_inf();
+  }
+
+  double fraction = x - whole;
+  double s = sin(M_PI * (fraction < 0.5 ? fraction : 1.0 - fraction));
+  if (fmod(whole, 2.0) != 0.0) {
+    s = -s;
+  }
+
+  return gamma ? M_PI / (s * value) : log(M_PI / fabs(s)) - value;
+}
+
+/*
+ *  MARK: check_points()
+ *
+ *  Fold the errors of the batched functions at x[0 .. count − 1], count <= CHECK_BATCH,
+ *  into worst.
+ */
+static void check_points(double const x[], size_t count, gamma_worst * worst) {
+
+  double lg[CHECK_BATCH];
+  double tg[CHECK_BATCH];
+
+  gamma_lgamma_batch(x, lg, count);
+  gamma_tgamma_batch(x, tg, count);
+  for (size_t i_ = 0; i_ < count; ++i_) {
+    long double ref = lgammal((long double) x[i_]);
+    long double scale = fabsl(ref) > 1.0L ? fabsl(ref) : 1.0L;
+    long double err = fabsl((long double) lg[i_] - ref) / scale;
+    if (err > worst->lg) {
+      worst->lg = err;
+      worst->lg_x = x[i_];
+    }
+
+    long double tref = tgammal((long double) x[i_]);
+    if (fabsl(tref) > (long double) DBL_MAX) {
+      err = tg[i_] == __builtin_inf() ? 0.0L : 1.0L;
+    }
+    else {
+      err = fabsl((long double) tg[i_] - tref) / (fabsl(tref) * scale);
+    }
+    if (err > worst->tg) {
+      worst->tg = err;
+      worst->tg_x = x[i_];
+    }
+  }
+
+  return;
+}
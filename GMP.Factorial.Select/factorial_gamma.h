@@ -0,0 +1,46 @@
+//
+//  factorial_gamma.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Batched log-gamma and gamma functions.
+//  gamma_lgamma_batch() and gamma_tgamma_batch() evaluate ln Γ(x) and Γ(x), so
+//  ln x! and x! for x + 1, for a whole array of real arguments at once, several
+//  lanes to a vector register, with Stirling's series. Negative arguments are
+//  reflected; ln Γ(x) is then ln |Γ(x)|.
+//
+
+#pragma once
+#ifndef factorial_gamma_h
+#define factorial_gamma_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Bounds on the error of the double results for x other than 0 and the negative
+//  integers, where Γ has poles, checked by gamma_check():
+//  |lgamma - ln Γ(x)| <= GAMMA_LGAMMA_ERROR * max(1, |ln Γ(x)|) and
+//  |tgamma - Γ(x)| <= GAMMA_TGAMMA_ERROR * max(1, |ln Γ(x)|) * Γ(x).
+#define GAMMA_LGAMMA_ERROR 8.0e-15
+#define GAMMA_TGAMMA_ERROR 8.0e-15
+
+//  MARK: - Prototypes
+void gamma_lgamma_batch(double const x[], double y[], size_t count);
+void gamma_tgamma_batch(double const x[], double y[], size_t count);
+void gamma_lgammaf_batch(float const x[], float y[], size_t count);
+void gamma_tgammaf_batch(float const x[], float y[], size_t count);
+bool gamma_check(uint64_t nbegin, uint64_t nend);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_gamma_h */
@@ -0,0 +1,269 @@
+//
+//  factorial_gmp.c
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://gmplib.org/manual/Factorial-Algorithm
+//  @see: http://www.luschny.de/math/factorial/FastFactorialFunctions.htm
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+
+//  MARK: - Definitions
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <gmp.h>
+
+#include "factorial_gmp.h"
+#include "factorial_stats.h"
+
+//  Ranges at most this long are multiplied out directly at the leaves of the tree.
+#define RANGE_LEAF 16
+
+//  MARK: - Prototypes
+static double log_fact_integral(double x_);
+static void odd_range_product(mpz_t result, uint64_t lo, uint64_t hi);
+
+//  MARK: - Implementation
+/*
+ *  MARK: gmp_fact_linear()
+ *
+ *  val! one word of factors at a time, as fact_gmp() does.
+ */
+void gmp_fact_linear(mpz_t result, uint64_t val) {
+
+  mpz_set_ui(result, 1);
+  gmp_mul_range(result, 2, val, false);
+
+  return;
+}
+
+/*
+ *  MARK: gmp_mul_range()
+ *
+ *  result *= lo * (lo + 1) * ... * hi, or the product of their odd parts when
+ *  odd_parts is set. Consecutive factors are packed into one machine word until
+ *  the next would overflow it (__builtin_mul_overflow), so each pass over result
+ *  absorbs a full word rather than the log2(i) bits of a single factor.
+ */
+void gmp_mul_range(mpz_t result, uint64_t lo, uint64_t hi, bool odd_parts) {
+
+  unsigned long word = 1;
+
+  for (uint64_t i_ = lo; i_ <= hi; ++i_) {
+    unsigned long factor = (unsigned long) (odd_parts ? i_ >> __builtin_ctzll(i_) : i_);
+    unsigned long packed;
+    if (__builtin_mul_overflow(word, factor, &packed)) {
+      mpz_mul_ui(result, result, word);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      STATS_COUNT(STATS_LIMB_OPS, mpz_size(result));
+      packed = factor;
+    }
+    word = packed;
+  }
+  if (word != 1) {
+    mpz_mul_ui(result, result, word);
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+    STATS_COUNT(STATS_LIMB_OPS, mpz_size(result));
+  }
+
+  return;
+}
+
+/*
+ *  MARK: gmp_range_product()
+ *
+ *  result = lo * (lo + 1) * ... * hi (1 for an empty range) using a balanced
+ *  product tree, so the large multiplications are between operands of equal
+ *  size and GMP's subquadratic algorithms apply.
+ */
+void gmp_range_product(mpz_t result, uint64_t lo, uint64_t hi) {
+
+  if (lo > hi) {
+    mpz_set_ui(result, 1);
+  }
+  else if (hi - lo < RANGE_LEAF) {
+    mpz_set_ui(result, 1);
+    gmp_mul_range(result, lo, hi, false);
+  }
+  else {
+    uint64_t mid = lo + (hi - lo) / 2;
+    mpz_t upper;
+
+    mpz_init(upper);
+    gmp_range_product(result, lo, mid);
+    gmp_range_product(upper, mid + 1, hi);
+    mpz_mul(result, result, upper);
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+    STATS_COUNT(STATS_LIMB_OPS, mpz_size(result));
+    mpz_clear(upper);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: gmp_fact_tree()
+ */
+void gmp_fact_tree(mpz_t result, uint64_t val) {
+
+  gmp_range_product(result, 2, val);
+
+  return;
+}
+
+/*
+ *  MARK: gmp_fact_swing()
+ *
+ *  GMP's own mpz_fac_ui(): the odd part of val! by prime swing (Luschny),
+ *  shifted by the power of two at the end.
+ */
+void gmp_fact_swing(mpz_t result, uint64_t val) {
+
+  mpz_fac_ui(result, val);
+  STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+
+  return;
+}
+
+/*
+ *  MARK: gmp_fact_odd_linear()
+ *
+ *  val! one word of factors at a time, multiplying only the odd part of each factor
+ *  and shifting by the power of two once at the end. By the last factor the running
+ *  product is about val bits shorter than in gmp_fact_linear().
+ */
+void gmp_fact_odd_linear(mpz_t result, uint64_t val) {
+
+  mpz_set_ui(result, 1);
+  gmp_mul_range(result, 3, val, true);
+  mpz_mul_2exp(result, result, gmp_legendre(val, 2));
+
+  return;
+}
+
+/*
+ *  MARK: gmp_fact_odd_tree()
+ *
+ *  val! by the balanced product tree of the odd parts of the factors, shifted by
+ *  the power of two at the end.
+ */
+void gmp_fact_odd_tree(mpz_t result, uint64_t val) {
+
+  if (val < 3) {
+    mpz_set_ui(result, 1);
+  }
+  else {
+    odd_range_product(result, 3, val);
+  }
+  mpz_mul_2exp(result, result, gmp_legendre(val, 2));
+
+  return;
+}
+
+/*
+ *  MARK: gmp_legendre()
+ *
+ *  Exponent of "prime" in val! by Legendre's formula: the sum of val / prime^k.
+ *  For 2 this is val less the number of ones in its binary representation.
+ */
+uint64_t gmp_legendre(uint64_t val, uint64_t prime) {
+
+  uint64_t exponent = 0;
+
+  if (prime == 2) {
+    exponent = val - (uint64_t) __builtin_popcountll(val);
+  }
+  else {
+    for (uint64_t quot = val / prime; quot != 0; quot /= prime) {
+      exponent += quot;
+    }
+  }
+
+  return exponent;
+}
+
+/*
+ *  MARK: gmp_split_range()
+ *
+ *  Cut lo..hi (2 <= lo <= hi) into "parts" consecutive subranges whose products are
+ *  of about equal size (equal shares of ln(hi! / (lo - 1)!)). bounds[p_] is the last
+ *  factor of subrange p_; a subrange may be empty when the range is short.
+ */
+void gmp_split_range(uint64_t lo, uint64_t hi, unsigned parts, uint64_t bounds[]) {
+
+  double base = log_fact_integral((double) (lo - 1));
+  double share = (log_fact_integral((double) hi) - base) / parts;
+
+  for (unsigned p_ = 0; p_ + 1 < parts; ++p_) {
+    double target = base + share * (p_ + 1);
+    uint64_t low = p_ == 0 ? lo - 1 : bounds[p_ - 1];
+    uint64_t high = hi;
+    while (low < high) {
+      uint64_t mid = low + (high - low) / 2;
+      if (log_fact_integral((double) mid) < target) {
+        low = mid + 1;
+      }
+      else {
+        high = mid;
+      }
+    }
+    bounds[p_] = low;
+  }
+  bounds[parts - 1] = hi;
+
+  return;
+}
+
+/*
+ *  MARK: gmp_log_range()
+ *
+ *  ln(lo * (lo + 1) * ... * hi) for lo <= hi, near enough to size a product.
+ */
+double gmp_log_range(uint64_t lo, uint64_t hi) {
+
+  lo = lo < 2 ? 2 : lo;
+
+  return hi < lo ? 0.0 : log_fact_integral((double) hi) - log_fact_integral((double) (lo - 1));
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: log_fact_integral()
+ *
+ *  Antiderivative of ln x, so ln(hi! / lo!) ~ F(hi) - F(lo).
+ */
+static double log_fact_integral(double x_) {
+
+  return x_ * log(x_) - x_;
+}
+
+/*
+ *  MARK: odd_range_product()
+ *
+ *  Product of the odd parts of lo .. hi (lo <= hi), as gmp_range_product().
+ */
+static void odd_range_product(mpz_t result, uint64_t lo, uint64_t hi) {
+
+  if (hi - lo < RANGE_LEAF) {
+    mpz_set_ui(result, 1);
+    gmp_mul_range(result, lo, hi, true);
+  }
+  else {
+    uint64_t mid = lo + (hi - lo) / 2;
+    mpz_t upper;
+
+    mpz_init(upper);
+    odd_range_product(result, lo, mid);
+    odd_range_product(upper, mid + 1, hi);
+    mpz_mul(result, result, upper);
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+    STATS_COUNT(STATS_LIMB_OPS, mpz_size(result));
+    mpz_clear(upper);
+  }
+
+  return;
+}
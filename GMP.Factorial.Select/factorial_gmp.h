@@ -0,0 +1,40 @@
+//
+//  factorial_gmp.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  GMP factorial kernels. These compute into an mpz_t and print nothing;
+//  the fact_ and factorial_ functions in factorial_select.c do the displaying.
+//
+
+#pragma once
+#ifndef factorial_gmp_h
+#define factorial_gmp_h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Prototypes
+void gmp_fact_linear(mpz_t result, uint64_t val);
+void gmp_mul_range(mpz_t result, uint64_t lo, uint64_t hi, bool odd_parts);
+void gmp_range_product(mpz_t result, uint64_t lo, uint64_t hi);
+void gmp_fact_tree(mpz_t result, uint64_t val);
+void gmp_fact_swing(mpz_t result, uint64_t val);
+void gmp_fact_odd_linear(mpz_t result, uint64_t val);
+void gmp_fact_odd_tree(mpz_t result, uint64_t val);
+uint64_t gmp_legendre(uint64_t val, uint64_t prime);
+void gmp_split_range(uint64_t lo, uint64_t hi, unsigned parts, uint64_t bounds[]);
+double gmp_log_range(uint64_t lo, uint64_t hi);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_gmp_h */
@@ -0,0 +1,401 @@
+//
+//  factorial_leading.c
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: R. P. Brent and D. Harvey, "Fast computation of Bernoulli, Tangent and Secant
+//        numbers", arXiv:1108.0286 (2011), algorithm TangentNumbers.
+//  @see: R. P. Brent, "Fast multiple-precision evaluation of elementary functions",
+//        Journal of the ACM 23 (1976), for ln by the arithmetic-geometric mean.
+//  @see: https://dlmf.nist.gov/5.11 (Stirling's series and the bound on its remainder)
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  ln n! = (n + 1/2) ln n - n + ln(2 pi) / 2 + sum for k = 1 to K of
+//  B(2k) / (2k (2k - 1) n^(2k - 1)), and for real n > 0 the remainder has the sign and
+//  at most the size of the first term left out. B(2k) = (-1)^(k - 1) 2k T(k) /
+//  (4^k (4^k - 1)) with T(k) the tangent numbers, which are integers computed exactly
+//  in K^2 / 2 small multiplications. K is estimated in double precision and the first
+//  omitted term is then checked against the target, so the series contributes no more
+//  than 10^-(precision + guard) to ln n!.
+//
+//  pi comes from the Gauss-Legendre iteration and ln x from pi / (2 AGM(1, 4 / s)) with
+//  s = x 2^m > 2^(bits / 2); exp(y) from its Taylor series at y / 2^r squared r times.
+//  These carry 128 guard bits beyond the 2^70 size of ln n! and the target. The
+//  mantissa is 10^(frac(log10 n!)), converted with guard digits that must not be all
+//  0 or all 9, or the whole is recomputed with more. The exponent, floor(log10 n!),
+//  reaches 3.5 * 10^20 for n near 2^64, past int64_t, so it is kept in an mpz_t.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <math.h>
+#include <gmp.h>
+
+#include "factorial_leading.h"
+#include "factorial_digits.h"
+#include "factorial_stats.h"
+
+//  Below LEADING_PRODUCT_FACTOR * precision the truncated product is the cheaper.
+#define LEADING_PRODUCT_FACTOR 100
+
+//  Digits converted beyond the precision, the most times their number is doubled and
+//  the most terms of the series.
+#define LEADING_GUARD       10
+#define LEADING_RETRIES_MAX 4
+#define LEADING_TERMS_MAX   100000
+
+//  MARK: - Prototypes
+static bool stirling(char * text, mpz_ptr exponent, uint64_t n, size_t digits);
+static unsigned series_terms(uint64_t n, size_t digits);
+static void tangent_numbers(mpz_t tangent[], unsigned count);
+static void agm(mpf_ptr result, mpf_srcptr a0, mpf_srcptr b0);
+static void pi_agm(mpf_ptr pi);
+static void log_agm(mpf_ptr result, mpf_srcptr val, mpf_srcptr pi, mpf_srcptr ln2, mp_bitcnt_t bits);
+static void exp_taylor(mpf_ptr result, mpf_srcptr val, mp_bitcnt_t bits);
+
+// MARK: - Implementation
+/*
+ *  MARK: leading_factorial()
+ *
+ *  Set text (precision + 1 chars) to the leading "precision" digits of n!, or all of
+ *  them when it has fewer, so that n! = text[0].text[1]... * 10^exponent, and set
+ *  *stirling to whether the series was used. The digits are truncated, not rounded.
+ *  Returns false, having reported why, when they could not be resolved.
+ */
+bool leading_factorial(char * text, mpz_ptr exponent, bool * stirling_used, uint64_t n, size_t precision) {
+
+  *stirling_used = n / LEADING_PRODUCT_FACTOR >= precision && series_terms(n, precision + LEADING_GUARD) > 0;
+  if (!*stirling_used) {
+    uint64_t digits;
+    bool resolved = digits_high(text, &digits, n, precision);
+    mpz_set_ui(exponent, digits - 1);
+    return resolved;
+  }
+
+  bool resolved = false;
+  size_t guard = LEADING_GUARD;
+  for (unsigned try_ = 0; !resolved && try_ < LEADING_RETRIES_MAX; ++try_, guard *= 2) {
+    size_t length = precision + guard;
+    char * leading = malloc(length + 1);
+
+    if (leading == NULL || !stirling(leading, exponent, n, length)) {
+      free(leading);
+      return false;
+    }
+    char const * tail = leading + precision;
+    resolved = strspn(tail, "0") < guard && strspn(tail, "9") < guard;
+    if (resolved) {
+      memcpy(text, leading, precision);
+      text[precision] = '\0';
+    }
+    free(leading);
+  }
+
+  if (!resolved) {
+    fprintf(stderr, "leading_factorial: the leading %zu digits of %" PRIu64 "! are not resolved\n", precision, n);
+  }
+
+  return resolved;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: stirling()
+ *
+ *  The leading "digits" digits of n!, rounded at the last, and its decimal exponent.
+ */
+static bool stirling(char * text, mpz_ptr exponent, uint64_t n, size_t digits) {
+
+  //  log2(10) < 3.33; ln n! < 2^70 for n < 2^64.
+  mp_bitcnt_t target = (mp_bitcnt_t) digits * 333 / 100 + 1;
+  mp_bitcnt_t bits = target + 70 + 128;
+  unsigned terms = series_terms(n, digits);
+  bool bounded;
+  mpz_t * tangent;
+  mpf_t pi, ln2, ln10, lnn, sum, term, npow, nsq, scratch;
+
+  tangent = malloc((terms + 1) * sizeof(*tangent));
+  if (tangent == NULL) {
+    fprintf(stderr, "leading_factorial: no memory for %u tangent numbers\n", terms + 1);
+    return false;
+  }
+  tangent_numbers(tangent, terms + 1);
+
+  mp_bitcnt_t default_prec = mpf_get_default_prec();
+  mpf_set_default_prec(bits);
+  mpf_inits(pi, ln2, ln10, lnn, sum, term, npow, nsq, scratch, NULL);
+
+  //  ln 2 = ln(2^m) / m, and the logarithms of n, 10 and 2 pi.
+  pi_agm(pi);
+  mpf_set_ui(ln2, 1);
+  log_agm(ln2, ln2, pi, NULL, bits);
+  mpf_set_ui(scratch, (unsigned long) n);
+  log_agm(lnn, scratch, pi, ln2, bits);
+  mpf_set_ui(scratch, 10);
+  log_agm(ln10, scratch, pi, ln2, bits);
+
+  //  sum = (n + 1/2) ln n - n + ln(2 pi) / 2.
+  mpf_set(sum, lnn);
+  mpf_mul_ui(sum, sum, (unsigned long) n);
+  mpf_div_2exp(scratch, lnn, 1);
+  mpf_add(sum, sum, scratch);
+  mpf_set_ui(scratch, (unsigned long) n);
+  mpf_sub(sum, sum, scratch);
+  mpf_mul_2exp(scratch, pi, 1);
+  log_agm(scratch, scratch, pi, ln2, bits);
+  mpf_div_2exp(scratch, scratch, 1);
+  mpf_add(sum, sum, scratch);
+
+  //  The series; term k = T(k) / (4^k (4^k - 1) (2k - 1) n^(2k - 1)).
+  mpz_t four_k;
+  mpz_init_set_ui(four_k, 1);
+  mpf_set_ui(npow, (unsigned long) n);
+  mpf_mul(nsq, npow, npow);
+  for (unsigned k_ = 1; k_ <= terms + 1; ++k_) {
+    mpz_mul_2exp(four_k, four_k, 2);
+    mpf_set_z(term, tangent[k_ - 1]);
+    mpf_div_2exp(term, term, 2 * k_);
+    mpz_sub_ui(four_k, four_k, 1);
+    mpf_set_z(scratch, four_k);
+    mpz_add_ui(four_k, four_k, 1);
+    mpf_div(term, term, scratch);
+    mpf_div_ui(term, term, 2 * k_ - 1);
+    mpf_div(term, term, npow);
+    mpf_mul(npow, npow, nsq);
+    STATS_COUNT(STATS_MULTIPLICATIONS, 4);
+    STATS_COUNT(STATS_LIMB_OPS, 4 * (bits / GMP_NUMB_BITS));
+    if (k_ <= terms) {
+      if (k_ % 2 == 1) {
+        mpf_add(sum, sum, term);
+      }
+      else {
+        mpf_sub(sum, sum, term);
+      }
+    }
+  }
+
+  //  term is now the first left out, which bounds the remainder.
+  long term_exp;
+  mpf_get_d_2exp(&term_exp, term);
+  bounded = term_exp < -(long) target;
+  mpz_clear(four_k);
+  for (unsigned k_ = 0; k_ <= terms; ++k_) {
+    mpz_clear(tangent[k_]);
+  }
+  free(tangent);
+
+  if (bounded) {
+    //  log10 n! = e + f, 0 <= f < 1; the mantissa is exp(f ln 10).
+    mpf_div(sum, sum, ln10);
+    mpf_floor(scratch, sum);
+    mpz_set_f(exponent, scratch);
+    mpf_sub(sum, sum, scratch);
+    mpf_mul(sum, sum, ln10);
+    exp_taylor(scratch, sum, bits);
+
+    mp_exp_t point;
+    char * leading = mpf_get_str(NULL, &point, 10, digits, scratch);
+    size_t got = strlen(leading);
+    memcpy(text, leading, got);
+    memset(text + got, '0', digits - got);
+    text[digits] = '\0';
+    if (point >= 1) {
+      mpz_add_ui(exponent, exponent, (unsigned long) (point - 1));
+    }
+    else {
+      mpz_sub_ui(exponent, exponent, (unsigned long) (1 - point));
+    }
+
+    void (* free_fn)(void *, size_t);
+    mp_get_memory_functions(NULL, NULL, &free_fn);
+    free_fn(leading, got + 1);
+  }
+  else {
+    fprintf(stderr, "leading_factorial: %u terms of the series do not bound ln %" PRIu64 "! to 2^-%lu\n",
+            terms, n, (unsigned long) target);
+  }
+  mpf_clears(pi, ln2, ln10, lnn, sum, term, npow, nsq, scratch, NULL);
+  mpf_set_default_prec(default_prec);
+
+  return bounded;
+}
+
+/*
+ *  MARK: series_terms()
+ *
+ *  The number of terms of Stirling's series that bring the remainder under the
+ *  2^-target of stirling(), with 8 bits to spare, or 0 if the terms stop falling first.
+ */
+static unsigned series_terms(uint64_t n, size_t digits) {
+
+  //  |term k| = 2 (2k - 2)! zeta(2k) / ((2 pi)^2k n^(2k - 1)), zeta(2k) <= 2.
+  double log_n = log((double) n);
+  double limit = -((double) (digits * 333 / 100 + 1) + 8) * log(2.0);
+  for (unsigned k_ = 1; k_ < LEADING_TERMS_MAX && (double) k_ < M_PI * (double) n; ++k_) {
+    double k2 = 2.0 * (k_ + 1);
+    double log_next = log(4.0) + lgamma(k2 - 1) - k2 * log(2 * M_PI) - (k2 - 1) * log_n;
+    if (log_next < limit) {
+      return k_;
+    }
+  }
+
+  return 0;
+}
+
+/*
+ *  MARK: tangent_numbers()
+ *
+ *  tangent[k - 1] = T(k) for k = 1 to count, initialised here.
+ */
+static void tangent_numbers(mpz_t tangent[], unsigned count) {
+
+  mpz_init_set_ui(tangent[0], 1);
+  for (unsigned k_ = 1; k_ < count; ++k_) {
+    mpz_init(tangent[k_]);
+    mpz_mul_ui(tangent[k_], tangent[k_ - 1], k_);
+  }
+  for (unsigned k_ = 1; k_ < count; ++k_) {
+    for (unsigned j_ = k_; j_ < count; ++j_) {
+      mpz_mul_ui(tangent[j_], tangent[j_], j_ - k_ + 2);
+      mpz_addmul_ui(tangent[j_], tangent[j_ - 1], j_ - k_);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 2);
+      STATS_COUNT(STATS_LIMB_OPS, 2 * mpz_size(tangent[j_]));
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: agm()
+ *
+ *  The arithmetic-geometric mean of a0 and b0 (> 0) at the default precision.
+ */
+static void agm(mpf_ptr result, mpf_srcptr a0, mpf_srcptr b0) {
+
+  mpf_t a_, b_, sum;
+  mpf_inits(a_, b_, sum, NULL);
+  mpf_set(a_, a0);
+  mpf_set(b_, b0);
+  while (!mpf_eq(a_, b_, mpf_get_default_prec() - 16)) {
+    mpf_add(sum, a_, b_);
+    mpf_mul(b_, a_, b_);
+    mpf_sqrt(b_, b_);
+    mpf_div_2exp(a_, sum, 1);
+  }
+  mpf_set(result, a_);
+  mpf_clears(a_, b_, sum, NULL);
+
+  return;
+}
+
+/*
+ *  MARK: pi_agm()
+ *
+ *  pi by the Gauss-Legendre iteration.
+ */
+static void pi_agm(mpf_ptr pi) {
+
+  mpf_t a_, b_, t_, next, diff;
+  mpf_inits(a_, b_, t_, next, diff, NULL);
+  mpf_set_ui(a_, 1);
+  mpf_set_ui(b_, 2);
+  mpf_sqrt(b_, b_);
+  mpf_ui_div(b_, 1, b_);
+  mpf_set_d(t_, 0.25);
+  for (unsigned long p_ = 1; !mpf_eq(a_, b_, mpf_get_default_prec() - 16); p_ *= 2) {
+    mpf_add(next, a_, b_);
+    mpf_div_2exp(next, next, 1);
+    mpf_mul(b_, a_, b_);
+    mpf_sqrt(b_, b_);
+    mpf_sub(diff, a_, next);
+    mpf_mul(diff, diff, diff);
+    mpf_mul_ui(diff, diff, p_);
+    mpf_sub(t_, t_, diff);
+    mpf_set(a_, next);
+  }
+  mpf_add(pi, a_, b_);
+  mpf_mul(pi, pi, pi);
+  mpf_mul_2exp(t_, t_, 2);
+  mpf_div(pi, pi, t_);
+  mpf_clears(a_, b_, t_, next, diff, NULL);
+
+  return;
+}
+
+/*
+ *  MARK: log_agm()
+ *
+ *  result = ln(val) for val >= 1 = pi / (2 AGM(1, 4 / s)) - m ln 2 with s = val 2^m.
+ *  With ln2 NULL, val must be 1 and result is ln 2 itself, ln(2^m) / m.
+ */
+static void log_agm(mpf_ptr result, mpf_srcptr val, mpf_srcptr pi, mpf_srcptr ln2, mp_bitcnt_t bits) {
+
+  unsigned long shift = bits / 2 + 16;
+  mpf_t one, scaled;
+
+  mpf_inits(one, scaled, NULL);
+  mpf_set_ui(one, 1);
+  mpf_mul_2exp(scaled, val, shift);
+  mpf_ui_div(scaled, 4, scaled);
+  agm(scaled, one, scaled);
+  mpf_mul_2exp(scaled, scaled, 1);
+  mpf_div(scaled, pi, scaled);
+  if (ln2 == NULL) {
+    mpf_div_ui(result, scaled, shift);
+  }
+  else {
+    mpf_mul_ui(one, ln2, shift);
+    mpf_sub(result, scaled, one);
+  }
+  mpf_clears(one, scaled, NULL);
+
+  return;
+}
+
+/*
+ *  MARK: exp_taylor()
+ *
+ *  result = exp(val) for 0 <= val < 4, the series at val / 2^r squared r times, with r
+ *  guard bits more for the squarings.
+ */
+static void exp_taylor(mpf_ptr result, mpf_srcptr val, mp_bitcnt_t bits) {
+
+  unsigned long halvings = (unsigned long) sqrt((double) bits);
+  mp_bitcnt_t prec = bits + halvings + 64;
+  mpf_t x_, term, sum;
+
+  mpf_init2(x_, prec);
+  mpf_init2(term, prec);
+  mpf_init2(sum, prec);
+  mpf_div_2exp(x_, val, halvings);
+  mpf_set_ui(term, 1);
+  mpf_set_ui(sum, 1);
+  for (unsigned long i_ = 1; mpf_sgn(term) != 0; ++i_) {
+    long term_exp;
+    mpf_mul(term, term, x_);
+    mpf_div_ui(term, term, i_);
+    mpf_add(sum, sum, term);
+    mpf_get_d_2exp(&term_exp, term);
+    if (term_exp < -(long) prec) {
+      break;
+    }
+  }
+  for (unsigned long s_ = 0; s_ < halvings; ++s_) {
+    mpf_mul(sum, sum, sum);
+  }
+  mpf_set(result, sum);
+  mpf_clear(sum);
+  mpf_clear(term);
+  mpf_clear(x_);
+
+  return;
+}
@@ -0,0 +1,42 @@
+//
+//  factorial_leading.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  n! to a chosen number of significant digits with a separate decimal exponent, for
+//  n up to 2^64 - 1: between the 15 to 18 digits of the floating point engines and
+//  the whole of n! from GMP. Large n are summed from Stirling's series for ln n!, at
+//  a cost that grows with the precision and shrinks with n; small n, for which the
+//  series would need too many terms, come from the bracketed truncated products of
+//  factorial_digits.c. The exponent outgrows int64_t from n near 5 * 10^17, so it is
+//  an mpz_t.
+//
+
+#pragma once
+#ifndef factorial_leading_h
+#define factorial_leading_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Significant digits of factorial_leading() unless --precision is given, and the most.
+#define LEADING_PRECISION_DEFAULT 20
+#define LEADING_PRECISION_MAX     100000
+
+//  MARK: - Prototypes
+bool leading_factorial(char * text, mpz_ptr exponent, bool * stirling, uint64_t n, size_t precision);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_leading_h */
@@ -0,0 +1,366 @@
+//
+//  factorial_memprof.c
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://gmplib.org/manual/Custom-Allocation
+//  @see: https://man7.org/linux/man-pages/man2/getrusage.2.html
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/resource.h>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#define heap_block_size(ptr) malloc_size(ptr)
+#else
+#include <malloc.h>
+#define heap_block_size(ptr) malloc_usable_size(ptr)
+#endif
+#include <gmp.h>
+
+#include "factorial_memprof.h"
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct memprof_tally
+struct memprof_tally {
+  uint64_t allocs;
+  uint64_t bytes;
+  int64_t  peak_live;
+};
+typedef struct memprof_tally memprof_tally;
+
+//  MARK: struct memprof_record
+struct memprof_record {
+  char const *  engine;
+  uint64_t      rows;
+  memprof_tally tally;
+  uint64_t      peak_rss;
+};
+typedef struct memprof_record memprof_record;
+
+//  MARK: - Static data
+static bool memprof_on = false;
+static FILE * memprof_csv = NULL;
+static int64_t live = 0;
+
+static char const * engine_name = NULL;
+static memprof_tally engine_tally;
+static uint64_t engine_rows = 0;
+
+static bool row_open = false;
+static uint64_t row_val = 0;
+static memprof_tally row_tally;
+
+static memprof_record * records = NULL;
+static size_t records_c = 0;
+
+//  MARK: - Prototypes
+static void row_close(void);
+static uint64_t peak_rss(void);
+static void * gmp_alloc(size_t size);
+static void * gmp_realloc(void * ptr, size_t old_size, size_t new_size);
+static void gmp_free(void * ptr, size_t size);
+
+//  MARK: - Implementation
+/*
+ *  MARK: memprof_open()
+ *
+ *  Enable memory profiling and route GMP's allocations through the profiler.
+ *  Must be called before the first GMP allocation.
+ *  If csv_path is not NULL one line per engine and n is written to that file.
+ */
+bool memprof_open(char const * csv_path) {
+
+  bool ok = true;
+
+  memprof_on = true;
+  mp_set_memory_functions(gmp_alloc, gmp_realloc, gmp_free);
+
+  if (csv_path != NULL) {
+    memprof_csv = fopen(csv_path, "w");
+    if (memprof_csv == NULL) {
+      perror(csv_path);
+      ok = false;
+    }
+    else {
+      fprintf(memprof_csv, "engine,n,allocs,bytes,peak_live,peak_rss\n");
+    }
+  }
+
+  return ok;
+}
+
+/*
+ *  MARK: memprof_enabled()
+ */
+bool memprof_enabled(void) {
+
+  return memprof_on;
+}
+
+/*
+ *  MARK: memprof_begin()
+ */
+void memprof_begin(char const * engine) {
+
+  if (memprof_on) {
+    engine_name = engine;
+    memset(&engine_tally, 0, sizeof(engine_tally));
+    engine_tally.peak_live = live;
+    engine_rows = 0;
+    row_open = false;
+  }
+
+  return;
+}
+
+/*
+ *  MARK: memprof_row()
+ *
+ *  Close the current row (if any) and attribute following allocations to val!
+ */
+void memprof_row(uint64_t val) {
+
+  if (memprof_on) {
+    row_close();
+    memset(&row_tally, 0, sizeof(row_tally));
+    row_tally.peak_live = live;
+    row_val = val;
+    row_open = true;
+    ++engine_rows;
+  }
+
+  return;
+}
+
+/*
+ *  MARK: memprof_end()
+ */
+void memprof_end(void) {
+
+  if (memprof_on) {
+    row_close();
+
+    memprof_record * grown = realloc(records, (records_c + 1) * sizeof(*records));
+    if (grown != NULL) {
+      records = grown;
+      records[records_c].engine = engine_name;
+      records[records_c].rows = engine_rows;
+      records[records_c].tally = engine_tally;
+      records[records_c].peak_rss = peak_rss();
+      ++records_c;
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: memprof_summary()
+ */
+void memprof_summary(FILE * out) {
+
+  if (!memprof_on) {
+    return;
+  }
+
+  fprintf(out, "Engine memory footprint:\n\n");
+  fprintf(out, "%-24s %10s %14s %16s %16s %16s %16s\n",
+          "engine", "rows", "allocs", "bytes", "allocs/row", "peak_live", "peak_rss");
+  for (size_t r_ = 0; r_ < records_c; ++r_) {
+    memprof_record const * rec = &records[r_];
+
+    fprintf(out, "%-24s %10" PRIu64 " %14" PRIu64 " %16" PRIu64 " %16.1f %16" PRId64 " %16" PRIu64 "\n",
+            rec->engine, rec->rows, rec->tally.allocs, rec->tally.bytes,
+            rec->rows != 0 ? (double) rec->tally.allocs / (double) rec->rows : 0.0,
+            rec->tally.peak_live, rec->peak_rss);
+  }
+  fputc('\n', out);
+
+  return;
+}
+
+/*
+ *  MARK: memprof_close()
+ */
+void memprof_close(void) {
+
+  if (memprof_csv != NULL) {
+    fclose(memprof_csv);
+    memprof_csv = NULL;
+  }
+  free(records);
+  records = NULL;
+  records_c = 0;
+
+  return;
+}
+
+//  MARK: - Allocation wrappers
+/*
+ *  MARK: memprof_malloc()
+ */
+void * memprof_malloc(size_t size) {
+
+  void * ptr = malloc(size);
+  if (memprof_on && ptr != NULL) {
+    memprof_note_alloc(heap_block_size(ptr));
+  }
+
+  return ptr;
+}
+
+/*
+ *  MARK: memprof_calloc()
+ */
+void * memprof_calloc(size_t count, size_t size) {
+
+  void * ptr = calloc(count, size);
+  if (memprof_on && ptr != NULL) {
+    memprof_note_alloc(heap_block_size(ptr));
+  }
+
+  return ptr;
+}
+
+/*
+ *  MARK: memprof_free()
+ */
+void memprof_free(void * ptr) {
+
+  if (memprof_on && ptr != NULL) {
+    memprof_note_free(heap_block_size(ptr));
+  }
+  free(ptr);
+
+  return;
+}
+
+/*
+ *  MARK: memprof_note_alloc()
+ *
+ *  Account for an allocation of size bytes made outside the wrappers.
+ */
+void memprof_note_alloc(size_t size) {
+
+  if (memprof_on) {
+    live += (int64_t) size;
+    ++engine_tally.allocs;
+    engine_tally.bytes += size;
+    engine_tally.peak_live = live > engine_tally.peak_live ? live : engine_tally.peak_live;
+    if (row_open) {
+      ++row_tally.allocs;
+      row_tally.bytes += size;
+      row_tally.peak_live = live > row_tally.peak_live ? live : row_tally.peak_live;
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: memprof_note_free()
+ */
+void memprof_note_free(size_t size) {
+
+  if (memprof_on) {
+    live -= (int64_t) size;
+  }
+
+  return;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: row_close()
+ */
+static void row_close(void) {
+
+  if (row_open) {
+    if (memprof_csv != NULL) {
+      fprintf(memprof_csv, "%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRId64 ",%" PRIu64 "\n",
+              engine_name, row_val, row_tally.allocs, row_tally.bytes, row_tally.peak_live, peak_rss());
+    }
+    row_open = false;
+  }
+
+  return;
+}
+
+/*
+ *  MARK: peak_rss()
+ *
+ *  Peak resident set size of the process in bytes.
+ *  getrusage() reports kilobytes on Linux and bytes on macOS.
+ */
+static uint64_t peak_rss(void) {
+
+  struct rusage ru;
+  uint64_t rss = 0;
+
+  if (getrusage(RUSAGE_SELF, &ru) == 0) {
+#if defined(__APPLE__)
+    rss = (uint64_t) ru.ru_maxrss;
+#else
+    rss = (uint64_t) ru.ru_maxrss * 1024;
+#endif
+  }
+
+  return rss;
+}
+
+//  MARK: - GMP allocation functions
+/*
+ *  MARK: gmp_alloc()
+ *
+ *  GMP passes the block sizes to its realloc and free functions, so these
+ *  account with the requested sizes rather than the heap block sizes.
+ */
+static void * gmp_alloc(size_t size) {
+
+  void * ptr = malloc(size);
+  if (ptr == NULL) {
+    fprintf(stderr, "GNU MP: Cannot allocate memory (size=%zu)\n", size);
+    abort();
+  }
+  memprof_note_alloc(size);
+
+  return ptr;
+}
+
+/*
+ *  MARK: gmp_realloc()
+ */
+static void * gmp_realloc(void * ptr, size_t old_size, size_t new_size) {
+
+  void * grown = realloc(ptr, new_size);
+  if (grown == NULL) {
+    fprintf(stderr, "GNU MP: Cannot reallocate memory (old_size=%zu new_size=%zu)\n", old_size, new_size);
+    abort();
+  }
+  memprof_note_free(old_size);
+  memprof_note_alloc(new_size);
+
+  return grown;
+}
+
+/*
+ *  MARK: gmp_free()
+ */
+static void gmp_free(void * ptr, size_t size) {
+
+  memprof_note_free(size);
+  free(ptr);
+
+  return;
+}
@@ -0,0 +1,55 @@
+//
+//  factorial_memprof.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Opt-in memory footprint profiling.
+//  When --memprof is given the allocations made by the engines (the memprof_ wrappers,
+//  GMP's allocator and C++ operator new) are counted per engine and per n, together
+//  with the peak live bytes and the peak resident set size of the process.
+//  The wrappers return ordinary heap blocks: memory from memprof_malloc() may be
+//  released with free() (it is then just not subtracted from the live bytes).
+//
+
+#pragma once
+#ifndef factorial_memprof_h
+#define factorial_memprof_h
+
+#ifdef __cplusplus
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Prototypes
+bool memprof_open(char const * csv_path);
+bool memprof_enabled(void);
+void memprof_begin(char const * engine);
+void memprof_row(uint64_t val);
+void memprof_end(void);
+void memprof_summary(FILE * out);
+void memprof_close(void);
+
+//  MARK: Allocation wrappers
+void * memprof_malloc(size_t size);
+void * memprof_calloc(size_t count, size_t size);
+void memprof_free(void * ptr);
+void memprof_note_alloc(size_t size);
+void memprof_note_free(size_t size);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_memprof_h */
@@ -0,0 +1,67 @@
+//
+//  factorial_memprof_new.cpp
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://en.cppreference.com/w/cpp/memory/new/operator_new
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Replacement global operator new/delete so that the C++ engines
+//  (std::string and friends in gfg-factorial.cpp) are seen by the memory profiler.
+//
+
+#include <new>
+#include <cstdlib>
+
+#include "factorial_memprof.h"
+
+/*
+ *  MARK: operator new()
+ */
+void * operator new(std::size_t size) {
+
+  void * ptr = memprof_malloc(size != 0 ? size : 1);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+void * operator new[](std::size_t size) {
+
+  return operator new(size);
+}
+
+/*
+ *  MARK: operator delete()
+ */
+void operator delete(void * ptr) noexcept {
+
+  memprof_free(ptr);
+
+  return;
+}
+
+void operator delete[](void * ptr) noexcept {
+
+  memprof_free(ptr);
+
+  return;
+}
+
+void operator delete(void * ptr, std::size_t) noexcept {
+
+  memprof_free(ptr);
+
+  return;
+}
+
+void operator delete[](void * ptr, std::size_t) noexcept {
+
+  memprof_free(ptr);
+
+  return;
+}
@@ -0,0 +1,556 @@
+//
+//  factorial_modtable.c
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: P. L. Montgomery, "Modular Multiplication Without Trial Division",
+//        Mathematics of Computation 44 (1985).
+//  @see: https://cp-algorithms.com/algebra/montgomery_multiplication.html
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  The forward sweep keeps i! and i in Montgomery form (i advances by adding R mod p),
+//  so each step is one Montgomery multiplication on the critical path and one
+//  reduction out of Montgomery form to store. n! is inverted once, by Fermat, and the
+//  backward sweep multiplies by i to get 1/(i-1)! from 1/i!. All the primes of a table
+//  are swept together: their chains are independent, so the multiplications for
+//  different primes overlap in the pipeline instead of waiting on each other.
+//
+//  File layout: a header page, then the fact rows of every prime, then the inv_fact rows.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "factorial_modtable.h"
+#include "factorial_stats.h"
+
+#define MODTABLE_MAGIC       "FACTMOD1"
+#define MODTABLE_DATA_OFFSET 4096
+
+//  Fault the whole mapping in up front where the system can, rather than one page at a
+//  time during the sweeps.
+#ifdef MAP_POPULATE
+#define MODTABLE_MAP_FLAGS (MAP_SHARED | MAP_POPULATE)
+#else
+#define MODTABLE_MAP_FLAGS MAP_SHARED
+#endif
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct mont
+//  Montgomery constants for an odd modulus p < 2^63, R = 2^64.
+struct mont {
+  uint64_t p;
+  uint64_t pinv;  //  -p^-1 mod R
+  uint64_t one;   //  R mod p
+};
+typedef struct mont mont;
+
+//  MARK: struct modtable_header
+struct modtable_header {
+  char     magic[8];
+  uint64_t n;
+  uint64_t primes_c;
+  uint64_t primes[MODTABLE_PRIMES_MAX];
+};
+typedef struct modtable_header modtable_header;
+
+//  MARK: - Prototypes
+static bool check_primes(uint64_t n, uint64_t const primes[], unsigned primes_c);
+static bool is_prime(uint64_t val);
+static uint64_t mulmod(uint64_t a_, uint64_t b_, uint64_t p_);
+static uint64_t powmod(uint64_t base, uint64_t exponent, uint64_t p_);
+static mont mont_init(uint64_t p_);
+static inline uint64_t mont_redc(mont const * mt, unsigned __int128 t_);
+static inline uint64_t mont_mul(mont const * mt, uint64_t a_, uint64_t b_);
+static uint64_t mont_pow(mont const * mt, uint64_t base, uint64_t exponent);
+static void fill_tables(modtable const * table, uint64_t * fact[], uint64_t * inv_fact[]);
+static size_t map_size_for(uint64_t n, unsigned primes_c);
+static void set_rows(modtable * table);
+
+//  MARK: - Implementation
+/*
+ *  MARK: modtable_build()
+ *
+ *  Build the tables of i! and 1/i! mod each of primes[0 .. primes_c - 1] for 0 <= i <= n.
+ *  With a path the tables are written to that file (through a temporary file renamed
+ *  into place once complete) and stay mapped; without one they are in anonymous shared
+ *  memory. Each prime must be prime, below 2^63 and greater than n.
+ *  Returns false, having reported why, on failure.
+ */
+bool modtable_build(modtable * table, uint64_t n, uint64_t const primes[], unsigned primes_c, char const * path) {
+
+  memset(table, 0, sizeof(*table));
+  if (!check_primes(n, primes, primes_c)) {
+    return false;
+  }
+
+  size_t size = map_size_for(n, primes_c);
+  char tmp_path[4096];
+  int fd = -1;
+  void * map;
+
+  if (size == 0) {
+    fprintf(stderr, "modtable: a table of %" PRIu64 " entries does not fit in memory\n", n);
+    return false;
+  }
+  if (path != NULL) {
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    fd = open(tmp_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0 || ftruncate(fd, (off_t) size) != 0) {
+      perror(tmp_path);
+      if (fd >= 0) {
+        close(fd);
+        unlink(tmp_path);
+      }
+      return false;
+    }
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MODTABLE_MAP_FLAGS, fd, 0);
+  }
+  else {
+    map = mmap(NULL, size, PROT_READ | PROT_WRITE, MODTABLE_MAP_FLAGS | MAP_ANONYMOUS, -1, 0);
+  }
+  if (map == MAP_FAILED) {
+    perror("modtable: mmap");
+    if (fd >= 0) {
+      close(fd);
+      unlink(tmp_path);
+    }
+    return false;
+  }
+
+  table->n = n;
+  table->primes_c = primes_c;
+  memcpy(table->primes, primes, primes_c * sizeof(*primes));
+  table->map = map;
+  table->map_size = size;
+  set_rows(table);
+
+  uint64_t * fact[MODTABLE_PRIMES_MAX];
+  uint64_t * inv_fact[MODTABLE_PRIMES_MAX];
+  for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+    fact[k_] = (uint64_t *) table->fact[k_];
+    inv_fact[k_] = (uint64_t *) table->inv_fact[k_];
+  }
+  fill_tables(table, fact, inv_fact);
+
+  modtable_header header;
+  memset(&header, 0, sizeof(header));
+  header.n = n;
+  header.primes_c = primes_c;
+  memcpy(header.primes, primes, primes_c * sizeof(*primes));
+  memcpy(header.magic, MODTABLE_MAGIC, sizeof(header.magic));
+  memcpy(map, &header, sizeof(header));
+
+  if (fd >= 0) {
+    bool saved = msync(map, size, MS_SYNC) == 0;
+    saved = close(fd) == 0 && saved;
+    saved = saved && rename(tmp_path, path) == 0;
+    if (!saved) {
+      perror(path);
+      unlink(tmp_path);
+      modtable_close(table);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ *  MARK: modtable_open()
+ *
+ *  Map, read only, a table file written by modtable_build().
+ */
+bool modtable_open(modtable * table, char const * path) {
+
+  struct stat st;
+  int fd = open(path, O_RDONLY);
+  void * map = MAP_FAILED;
+
+  memset(table, 0, sizeof(*table));
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    return false;
+  }
+  if ((size_t) st.st_size >= MODTABLE_DATA_OFFSET) {
+    map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+  modtable_header const * header = map;
+  bool valid = memcmp(header->magic, MODTABLE_MAGIC, sizeof(header->magic)) == 0
+            && header->primes_c >= 1 && header->primes_c <= MODTABLE_PRIMES_MAX
+            && map_size_for(header->n, (unsigned) header->primes_c) == (size_t) st.st_size;
+  if (!valid) {
+    fprintf(stderr, "%s: not a factorial table\n", path);
+    munmap(map, (size_t) st.st_size);
+    return false;
+  }
+
+  table->n = header->n;
+  table->primes_c = (unsigned) header->primes_c;
+  memcpy(table->primes, header->primes, sizeof(table->primes));
+  table->map = map;
+  table->map_size = (size_t) st.st_size;
+  set_rows(table);
+
+  return true;
+}
+
+/*
+ *  MARK: modtable_close()
+ */
+void modtable_close(modtable * table) {
+
+  if (table->map != NULL) {
+    munmap(table->map, table->map_size);
+  }
+  memset(table, 0, sizeof(*table));
+
+  return;
+}
+
+/*
+ *  MARK: modtable_binomial()
+ *
+ *  n choose r mod primes[k] for n <= table->n; 0 when r > n.
+ */
+uint64_t modtable_binomial(modtable const * table, unsigned k, uint64_t n, uint64_t r) {
+
+  uint64_t p_ = table->primes[k];
+
+  if (r > n || n > table->n) {
+    return 0;
+  }
+
+  return mulmod(mulmod(table->fact[k][n], table->inv_fact[k][r], p_), table->inv_fact[k][n - r], p_);
+}
+
+/*
+ *  MARK: modtable_is_prime()
+ */
+bool modtable_is_prime(uint64_t val) {
+
+  return is_prime(val);
+}
+
+/*
+ *  MARK: modtable_mul_range()
+ *
+ *  residues[k] = residues[k] * lo * (lo + 1) * ... * hi mod primes[k], odd primes below
+ *  2^63, for every k together: the chains are independent and overlap as in the tables.
+ */
+void modtable_mul_range(uint64_t lo, uint64_t hi, uint64_t const primes[], unsigned primes_c, uint64_t residues[]) {
+
+  mont mt[MODTABLE_PRIMES_MAX];
+  uint64_t acc[MODTABLE_PRIMES_MAX];
+  uint64_t i_m[MODTABLE_PRIMES_MAX];
+
+  if (lo > hi) {
+    return;
+  }
+  for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+    mt[k_] = mont_init(primes[k_]);
+    acc[k_] = mulmod(residues[k_], mt[k_].one, mt[k_].p);
+    i_m[k_] = mulmod(lo % mt[k_].p, mt[k_].one, mt[k_].p);
+  }
+  for (uint64_t i_ = lo; ; ++i_) {
+    for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+      acc[k_] = mont_mul(&mt[k_], acc[k_], i_m[k_]);
+      uint64_t next = i_m[k_] + mt[k_].one;
+      i_m[k_] = next >= mt[k_].p ? next - mt[k_].p : next;
+    }
+    if (i_ == hi) {
+      break;
+    }
+  }
+  for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+    residues[k_] = mont_redc(&mt[k_], acc[k_]);
+  }
+  STATS_COUNT(STATS_MULTIPLICATIONS, (hi - lo + 1) * primes_c);
+
+  return;
+}
+
+/*
+ *  MARK: modtable_horner_decimal()
+ *
+ *  residues[k] = (residues[k] * 10^length + the value of the decimal digits) mod
+ *  primes[k], odd primes below 2^63, so that a number may be reduced a piece at a time.
+ *  Each group of 19 digits costs two Montgomery multiplications per prime; a group
+ *  below 2^64 times R^2 mod p is below p R, so it needs no reduction of its own.
+ */
+void modtable_horner_decimal(char const * digits, size_t length, uint64_t const primes[], unsigned primes_c, uint64_t residues[]) {
+
+  enum { GROUP = 19, };
+  mont mt[MODTABLE_PRIMES_MAX];
+  uint64_t r2[MODTABLE_PRIMES_MAX];
+  uint64_t acc[MODTABLE_PRIMES_MAX];
+  uint64_t scale[MODTABLE_PRIMES_MAX];
+
+  for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+    mt[k_] = mont_init(primes[k_]);
+    r2[k_] = mulmod(mt[k_].one, mt[k_].one, mt[k_].p);
+    acc[k_] = mulmod(residues[k_], mt[k_].one, mt[k_].p);
+    scale[k_] = mont_pow(&mt[k_], mont_mul(&mt[k_], 10, r2[k_]), GROUP);
+  }
+  for (size_t d_ = 0; d_ < length; ) {
+    size_t count = length - d_ < GROUP ? length - d_ : GROUP;
+    uint64_t group = 0;
+    for (size_t g_ = 0; g_ < count; ++g_) {
+      group = group * 10 + (uint64_t) (digits[d_ + g_] - '0');
+    }
+    d_ += count;
+    for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+      uint64_t by = count == GROUP ? scale[k_] : mont_pow(&mt[k_], mont_mul(&mt[k_], 10, r2[k_]), count);
+      uint64_t sum = mont_mul(&mt[k_], acc[k_], by) + mont_mul(&mt[k_], group, r2[k_]);
+      acc[k_] = sum >= mt[k_].p ? sum - mt[k_].p : sum;
+    }
+  }
+  for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+    residues[k_] = mont_redc(&mt[k_], acc[k_]);
+  }
+
+  return;
+}
+
+//  MARK: - Table
+/*
+ *  MARK: fill_tables()
+ */
+static void fill_tables(modtable const * table, uint64_t * fact[], uint64_t * inv_fact[]) {
+
+  unsigned const primes_c = table->primes_c;
+  uint64_t const n = table->n;
+  mont mt[MODTABLE_PRIMES_MAX];
+  uint64_t acc[MODTABLE_PRIMES_MAX];
+  uint64_t i_m[MODTABLE_PRIMES_MAX];
+
+  for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+    mt[k_] = mont_init(table->primes[k_]);
+    acc[k_] = mt[k_].one;
+    i_m[k_] = 0;
+    fact[k_][0] = 1;
+  }
+  for (uint64_t i_ = 1; i_ <= n; ++i_) {
+    for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+      uint64_t next = i_m[k_] + mt[k_].one;
+      i_m[k_] = next >= mt[k_].p ? next - mt[k_].p : next;
+      acc[k_] = mont_mul(&mt[k_], acc[k_], i_m[k_]);
+      fact[k_][i_] = mont_redc(&mt[k_], acc[k_]);
+    }
+  }
+
+  for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+    acc[k_] = mont_pow(&mt[k_], acc[k_], mt[k_].p - 2);
+  }
+  for (uint64_t i_ = n; i_ > 0; --i_) {
+    for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+      inv_fact[k_][i_] = mont_redc(&mt[k_], acc[k_]);
+      acc[k_] = mont_mul(&mt[k_], acc[k_], i_m[k_]);
+      i_m[k_] = i_m[k_] >= mt[k_].one ? i_m[k_] - mt[k_].one : i_m[k_] + mt[k_].p - mt[k_].one;
+    }
+  }
+  for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+    inv_fact[k_][0] = mont_redc(&mt[k_], acc[k_]);
+  }
+  STATS_COUNT(STATS_MULTIPLICATIONS, 2 * n * primes_c);
+
+  return;
+}
+
+/*
+ *  MARK: map_size_for()
+ *
+ *  Bytes in the mapping of a table, or 0 if that does not fit in a size_t.
+ */
+static size_t map_size_for(uint64_t n, unsigned primes_c) {
+
+  uint64_t const row_max = (SIZE_MAX - MODTABLE_DATA_OFFSET) / (2 * sizeof(uint64_t) * primes_c);
+
+  if (n >= row_max) {
+    return 0;
+  }
+
+  return MODTABLE_DATA_OFFSET + 2 * sizeof(uint64_t) * primes_c * (size_t) (n + 1);
+}
+
+/*
+ *  MARK: set_rows()
+ */
+static void set_rows(modtable * table) {
+
+  uint64_t const * data = (uint64_t const *) ((char const *) table->map + MODTABLE_DATA_OFFSET);
+  size_t const row = (size_t) (table->n + 1);
+
+  for (unsigned k_ = 0; k_ < table->primes_c; ++k_) {
+    table->fact[k_] = data + k_ * row;
+    table->inv_fact[k_] = data + (table->primes_c + k_) * row;
+  }
+
+  return;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: check_primes()
+ */
+static bool check_primes(uint64_t n, uint64_t const primes[], unsigned primes_c) {
+
+  if (primes_c < 1 || primes_c > MODTABLE_PRIMES_MAX) {
+    fprintf(stderr, "modtable: 1 to %d primes\n", MODTABLE_PRIMES_MAX);
+    return false;
+  }
+  for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+    if (primes[k_] < 3 || primes[k_] >= (UINT64_C(1) << 63) || !is_prime(primes[k_])) {
+      fprintf(stderr, "modtable: %" PRIu64 " is not an odd prime below 2^63\n", primes[k_]);
+      return false;
+    }
+    if (n >= primes[k_]) {
+      fprintf(stderr, "modtable: %" PRIu64 "! is 0 mod %" PRIu64 " and has no inverse\n", n, primes[k_]);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ *  MARK: is_prime()
+ *
+ *  Miller-Rabin with the first twelve primes as bases, which is exact below 2^64.
+ */
+static bool is_prime(uint64_t val) {
+
+  static uint64_t const bases[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, };
+  size_t const bases_c = sizeof(bases) / sizeof(*bases);
+
+  if (val < 2) {
+    return false;
+  }
+  for (size_t b_ = 0; b_ < bases_c; ++b_) {
+    if (val % bases[b_] == 0) {
+      return val == bases[b_];
+    }
+  }
+
+  uint64_t odd = val - 1;
+  int twos = __builtin_ctzll(odd);
+  odd >>= twos;
+  for (size_t b_ = 0; b_ < bases_c; ++b_) {
+    uint64_t x_ = powmod(bases[b_], odd, val);
+    bool witness = x_ != 1 && x_ != val - 1;
+    for (int s_ = 1; witness && s_ < twos; ++s_) {
+      x_ = mulmod(x_, x_, val);
+      witness = x_ != val - 1;
+    }
+    if (witness) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ *  MARK: mulmod()
+ */
+static uint64_t mulmod(uint64_t a_, uint64_t b_, uint64_t p_) {
+
+  return (uint64_t) ((unsigned __int128) a_ * b_ % p_);
+}
+
+/*
+ *  MARK: powmod()
+ */
+static uint64_t powmod(uint64_t base, uint64_t exponent, uint64_t p_) {
+
+  uint64_t result = 1 % p_;
+
+  base %= p_;
+  for (; exponent != 0; exponent >>= 1) {
+    if ((exponent & 1) != 0) {
+      result = mulmod(result, base, p_);
+    }
+    base = mulmod(base, base, p_);
+  }
+
+  return result;
+}
+
+//  MARK: - Montgomery arithmetic
+/*
+ *  MARK: mont_init()
+ */
+static mont mont_init(uint64_t p_) {
+
+  mont mt;
+  uint64_t inv = p_;
+
+  //  Newton's iteration doubles the correct low bits of p^-1 each step: 3, 6, ... 96.
+  for (int i_ = 0; i_ < 5; ++i_) {
+    inv *= 2 - p_ * inv;
+  }
+  mt.p = p_;
+  mt.pinv = -inv;
+  mt.one = (uint64_t) (((unsigned __int128) 1 << 64) % p_);
+
+  return mt;
+}
+
+/*
+ *  MARK: mont_redc()
+ *
+ *  t_ R^-1 mod p for t_ < p R.
+ */
+static inline uint64_t mont_redc(mont const * mt, unsigned __int128 t_) {
+
+  uint64_t q_ = (uint64_t) t_ * mt->pinv;
+  uint64_t r_ = (uint64_t) ((t_ + (unsigned __int128) q_ * mt->p) >> 64);
+
+  return r_ >= mt->p ? r_ - mt->p : r_;
+}
+
+/*
+ *  MARK: mont_mul()
+ */
+static inline uint64_t mont_mul(mont const * mt, uint64_t a_, uint64_t b_) {
+
+  return mont_redc(mt, (unsigned __int128) a_ * b_);
+}
+
+/*
+ *  MARK: mont_pow()
+ *
+ *  base^exponent, base and result in Montgomery form.
+ */
+static uint64_t mont_pow(mont const * mt, uint64_t base, uint64_t exponent) {
+
+  uint64_t result = mt->one;
+
+  for (; exponent != 0; exponent >>= 1) {
+    if ((exponent & 1) != 0) {
+      result = mont_mul(mt, result, base);
+    }
+    base = mont_mul(mt, base, base);
+  }
+
+  return result;
+}
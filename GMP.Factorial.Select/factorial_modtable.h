@@ -0,0 +1,59 @@
+//
+//  factorial_modtable.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Tables of i! and 1/i! mod p for 0 <= i <= n, for one or more primes p.
+//  The tables are built with Montgomery multiplication, one modular inversion per
+//  prime and a backward sweep, and live in a shared memory mapping: of a file,
+//  which other processes can then map with modtable_open(), or anonymous memory,
+//  which is shared with children forked after the build.
+//
+
+#pragma once
+#ifndef factorial_modtable_h
+#define factorial_modtable_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Most primes in one table.
+#define MODTABLE_PRIMES_MAX 8
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct modtable
+//  fact[k][i] = i! mod primes[k] and inv_fact[k][i] = (i!)^-1 mod primes[k],
+//  each row n + 1 contiguous values in the mapping.
+struct modtable {
+  uint64_t         n;
+  unsigned         primes_c;
+  uint64_t         primes[MODTABLE_PRIMES_MAX];
+  uint64_t const * fact[MODTABLE_PRIMES_MAX];
+  uint64_t const * inv_fact[MODTABLE_PRIMES_MAX];
+  void *           map;
+  size_t           map_size;
+};
+typedef struct modtable modtable;
+
+//  MARK: - Prototypes
+bool modtable_build(modtable * table, uint64_t n, uint64_t const primes[], unsigned primes_c, char const * path);
+bool modtable_open(modtable * table, char const * path);
+void modtable_close(modtable * table);
+uint64_t modtable_binomial(modtable const * table, unsigned k, uint64_t n, uint64_t r);
+bool modtable_is_prime(uint64_t val);
+void modtable_mul_range(uint64_t lo, uint64_t hi, uint64_t const primes[], unsigned primes_c, uint64_t residues[]);
+void modtable_horner_decimal(char const * digits, size_t length, uint64_t const primes[], unsigned primes_c, uint64_t residues[]);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_modtable_h */
@@ -0,0 +1,595 @@
+//
+//  factorial_ooc.c
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://gmplib.org/manual/Low_002dlevel-Functions
+//  @see: https://man7.org/linux/man-pages/man2/mmap.2.html
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  n! is the product tree of 2..n split at equal logarithms, so the two halves of a
+//  node are about the same size. A node small enough for a quarter of the budget is
+//  computed in memory by gmp_range_product(); a larger one spills both children to
+//  unlinked files in the spill directory and multiplies them as a schoolbook product
+//  of blocks: block i of one times block j of the other by mpn_mul() in memory, added
+//  into a window of the result file at limb (i + j) * block, the carry rippling on
+//  through further windows. Two operand blocks, their product and the result window
+//  are mapped at any one time, about ten blocks of memory in all.
+//
+//  Spill files hold the native limbs, least significant first, as in checkpoints.
+//
+//  A spilled factorial is converted to decimal out of core too. It is divided in place
+//  by d = 10^D, where d takes half a block, one window of a block at a time from the
+//  top, each window's limbs and the running remainder divided by mpn_tdiv_qr() in
+//  memory. The final remainder holds the lowest D digits not yet written. It is
+//  appended as text to a spill file, and the pass repeats on the quotient until that
+//  takes two blocks or less. Then the quotient is written, followed by the chunks of
+//  text in reverse order, each zero-padded to D digits. Each pass reads and writes
+//  the whole operand once, so the conversion takes about 2 L / block passes for an
+//  operand of L limbs.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <gmp.h>
+
+#include "factorial_ooc.h"
+#include "factorial_gmp.h"
+#include "factorial_stream.h"
+#include "factorial_stats.h"
+#include "factorial_memprof.h"
+
+//  Memory for one block multiplication, in blocks: two operand windows, their
+//  product, the result window it is added to and GMP's scratch for mpn_mul().
+#define BLOCKS_IN_BUDGET 10
+//  Smallest block, in limbs.
+#define BLOCK_LIMBS_MIN 1024
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct operand
+//  A subproduct: in memory while it is small, else in a spill file.
+struct operand {
+  mpz_t mem;
+  int fd;         //  spill file, or -1 for mem
+  size_t limbs;
+};
+typedef struct operand operand;
+
+//  MARK: struct window
+//  Limbs [first, first + count) of an operand, mapped from its file when it has one.
+struct window {
+  mp_limb_t * limbs;
+  void * map;
+  size_t map_size;
+};
+typedef struct window window;
+
+//  MARK: struct ooc
+struct ooc {
+  size_t memory_max;  //  largest subproduct kept in memory, in bytes
+  size_t block;       //  limbs per block of a file multiplication
+  size_t page_limbs;
+  char const * spill_dir;
+  unsigned spills;
+  bool failed;
+};
+typedef struct ooc ooc;
+
+//  MARK: - Prototypes
+static int spill_open(ooc * oc);
+static bool operand_spill(ooc * oc, operand * op);
+static void operand_free(operand * op);
+static bool window_map(operand const * op, size_t first, size_t count, bool writable, window * win);
+static void window_unmap(window * win);
+static bool mul_files(ooc * oc, operand * result, operand const * lhs, operand const * rhs);
+static void ooc_product(ooc * oc, operand * result, uint64_t lo, uint64_t hi);
+static bool write_limbs(FILE * out, operand const * op);
+static bool divide_pass(ooc * oc, operand * op, mpz_srcptr divisor, mp_limb_t * num, mp_limb_t * quotient, mp_limb_t * remainder);
+static bool copy_text(FILE * out, int fd, off_t offset, size_t length);
+static bool write_row(ooc * oc, FILE * out, uint64_t val, operand * op);
+
+// MARK: - Implementation
+/*
+ *  MARK: ooc_parse_size()
+ *
+ *  Bytes in "spec", a count with an optional K, M or G suffix (powers of 1024),
+ *  or 0 if it is not one.
+ */
+size_t ooc_parse_size(char const * spec) {
+
+  char * end;
+  unsigned long long size = strtoull(spec, &end, 0);
+  int shift = 0;
+
+  switch (toupper((unsigned char) *end)) {
+    case 'K':
+      shift = 10;
+      break;
+
+    case 'M':
+      shift = 20;
+      break;
+
+    case 'G':
+      shift = 30;
+      break;
+
+    default:
+      break;
+  }
+  end += shift != 0 ? 1 : 0;
+  if (end == spec || *end != '\0' || size > (SIZE_MAX >> shift)) {
+    return 0;
+  }
+
+  return (size_t) size << shift;
+}
+
+/*
+ *  MARK: stream_factorials_ooc()
+ *
+ *  Write the factorials nbegin! to nend! to out, each computed from scratch within
+ *  about "budget" bytes, spilling to files in spill_dir: one row per n in the format
+ *  of fact_gmp(), or the raw native limbs of the one factorial if "limbs" is set.
+ *  A spilled factorial is converted to decimal within the budget too, dividing its
+ *  file in place.
+ */
+bool stream_factorials_ooc(FILE * out, uint64_t nbegin, uint64_t nend, size_t budget, char const * spill_dir, bool limbs) {
+
+  ooc oc = {
+    .memory_max = budget / 4,
+    .page_limbs = (size_t) sysconf(_SC_PAGESIZE) / sizeof(mp_limb_t),
+    .spill_dir  = spill_dir,
+    .spills     = 0,
+    .failed     = false,
+  };
+  oc.block = budget / (BLOCKS_IN_BUDGET * sizeof(mp_limb_t)) / oc.page_limbs * oc.page_limbs;
+  oc.block = oc.block < BLOCK_LIMBS_MIN ? BLOCK_LIMBS_MIN : oc.block;
+
+  bool written = true;
+  for (uint64_t nb = nbegin; written && nb <= nend; ++nb) {
+    operand fact;
+
+    memprof_row(nb);
+    ooc_product(&oc, &fact, 2, nb);
+    written = !oc.failed && (limbs ? write_limbs(out, &fact) : write_row(&oc, out, nb, &fact));
+    operand_free(&fact);
+  }
+
+  return written;
+}
+
+/*
+ *  MARK: spill_open()
+ *
+ *  A new, empty spill file, already unlinked so it goes when it is closed,
+ *  or -1 on failure.
+ */
+static int spill_open(ooc * oc) {
+
+  char path[4096];
+
+  snprintf(path, sizeof(path), "%s/factorial_ooc_%ld_%u.limbs", oc->spill_dir, (long) getpid(), oc->spills++);
+  int fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    perror(path);
+    oc->failed = true;
+  }
+  else {
+    unlink(path);
+  }
+
+  return fd;
+}
+
+/*
+ *  MARK: operand_spill()
+ *
+ *  Move op from memory to a spill file.
+ */
+static bool operand_spill(ooc * oc, operand * op) {
+
+  if (op->fd >= 0) {
+    return true;
+  }
+
+  int fd = spill_open(oc);
+  bool spilled = fd >= 0;
+  size_t length = op->limbs * sizeof(mp_limb_t);
+  char const * next = (char const *) mpz_limbs_read(op->mem);
+
+  while (spilled && length > 0) {
+    ssize_t wrote = write(fd, next, length);
+    if (wrote < 0 && errno == EINTR) {
+      continue;
+    }
+    spilled = wrote > 0;
+    next += spilled ? wrote : 0;
+    length -= spilled ? (size_t) wrote : 0;
+  }
+  if (spilled) {
+    op->fd = fd;
+    mpz_clear(op->mem);
+    mpz_init(op->mem);
+  }
+  else {
+    if (fd >= 0) {
+      perror(oc->spill_dir);
+      close(fd);
+    }
+    oc->failed = true;
+  }
+
+  return spilled;
+}
+
+/*
+ *  MARK: operand_free()
+ */
+static void operand_free(operand * op) {
+
+  if (op->fd >= 0) {
+    close(op->fd);
+    op->fd = -1;
+  }
+  mpz_clear(op->mem);
+
+  return;
+}
+
+/*
+ *  MARK: window_map()
+ *
+ *  Map limbs [first, first + count) of op, writable for a spilled result.
+ *  The mapping starts at the page holding limb "first".
+ */
+static bool window_map(operand const * op, size_t first, size_t count, bool writable, window * win) {
+
+  if (op->fd < 0) {
+    win->limbs = (mp_limb_t *) mpz_limbs_read(op->mem) + first;
+    win->map = NULL;
+    win->map_size = 0;
+    return true;
+  }
+
+  size_t page = (size_t) sysconf(_SC_PAGESIZE);
+  size_t offset = first * sizeof(mp_limb_t);
+  size_t slack = offset % page;
+
+  win->map_size = slack + count * sizeof(mp_limb_t);
+  win->map = mmap(NULL, win->map_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, op->fd, (off_t) (offset - slack));
+  if (win->map == MAP_FAILED) {
+    perror("mmap");
+    win->map = NULL;
+    return false;
+  }
+  win->limbs = (mp_limb_t *) ((char *) win->map + slack);
+
+  return true;
+}
+
+/*
+ *  MARK: window_unmap()
+ */
+static void window_unmap(window * win) {
+
+  if (win->map != NULL) {
+    munmap(win->map, win->map_size);
+    win->map = NULL;
+  }
+
+  return;
+}
+
+/*
+ *  MARK: mul_files()
+ *
+ *  result = lhs * rhs into a new spill file, one pair of blocks at a time.
+ */
+static bool mul_files(ooc * oc, operand * result, operand const * lhs, operand const * rhs) {
+
+  size_t block = oc->block;
+  size_t total = lhs->limbs + rhs->limbs;
+
+  mpz_init(result->mem);
+  result->limbs = total;
+  result->fd = spill_open(oc);
+  if (result->fd < 0) {
+    return false;
+  }
+  if (ftruncate(result->fd, (off_t) (total * sizeof(mp_limb_t))) != 0) {
+    perror(oc->spill_dir);
+    oc->failed = true;
+    return false;
+  }
+
+  mp_limb_t * product = memprof_malloc(2 * block * sizeof(mp_limb_t));
+  bool multiplied = product != NULL;
+
+  for (size_t i_ = 0; multiplied && i_ < lhs->limbs; i_ += block) {
+    size_t lhs_c = lhs->limbs - i_ < block ? lhs->limbs - i_ : block;
+    window lhs_w;
+    multiplied = window_map(lhs, i_, lhs_c, false, &lhs_w);
+    for (size_t j_ = 0; multiplied && j_ < rhs->limbs; j_ += block) {
+      size_t rhs_c = rhs->limbs - j_ < block ? rhs->limbs - j_ : block;
+      window rhs_w;
+      window sum_w;
+      multiplied = window_map(rhs, j_, rhs_c, false, &rhs_w);
+      if (!multiplied) {
+        break;
+      }
+      if (lhs_c >= rhs_c) {
+        mpn_mul(product, lhs_w.limbs, (mp_size_t) lhs_c, rhs_w.limbs, (mp_size_t) rhs_c);
+      }
+      else {
+        mpn_mul(product, rhs_w.limbs, (mp_size_t) rhs_c, lhs_w.limbs, (mp_size_t) lhs_c);
+      }
+      window_unmap(&rhs_w);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      STATS_COUNT(STATS_LIMB_OPS, lhs_c + rhs_c);
+
+      size_t at = i_ + j_;
+      size_t product_c = lhs_c + rhs_c;
+      multiplied = window_map(result, at, product_c, true, &sum_w);
+      mp_limb_t carry = multiplied ? mpn_add_n(sum_w.limbs, sum_w.limbs, product, (mp_size_t) product_c) : 0;
+      window_unmap(&sum_w);
+      for (at += product_c; multiplied && carry != 0 && at < total; at += oc->page_limbs) {
+        size_t ripple_c = total - at < oc->page_limbs ? total - at : oc->page_limbs;
+        multiplied = window_map(result, at, ripple_c, true, &sum_w);
+        carry = multiplied ? mpn_add_1(sum_w.limbs, sum_w.limbs, (mp_size_t) ripple_c, carry) : 0;
+        window_unmap(&sum_w);
+      }
+    }
+    window_unmap(&lhs_w);
+  }
+  memprof_free(product);
+
+  //  The product of an lhs-limb and an rhs-limb number has one limb fewer at most.
+  mp_limb_t top = 0;
+  if (multiplied && pread(result->fd, &top, sizeof(top), (off_t) ((total - 1) * sizeof(mp_limb_t))) == sizeof(top) && top == 0) {
+    result->limbs = total - 1;
+    multiplied = ftruncate(result->fd, (off_t) (result->limbs * sizeof(mp_limb_t))) == 0;
+  }
+  oc->failed = oc->failed || !multiplied;
+
+  return multiplied;
+}
+
+/*
+ *  MARK: ooc_product()
+ *
+ *  result = lo * (lo + 1) * ... * hi, in memory if it fits a quarter of the budget,
+ *  else as the block product of its two halves, spilled.
+ */
+static void ooc_product(ooc * oc, operand * result, uint64_t lo, uint64_t hi) {
+
+  if (hi < lo || hi - lo < 2 || gmp_log_range(lo, hi) / M_LN2 / 8.0 <= (double) oc->memory_max) {
+    mpz_init(result->mem);
+    if (hi < lo) {
+      mpz_set_ui(result->mem, 1);
+    }
+    else {
+      gmp_range_product(result->mem, lo, hi);
+    }
+    result->fd = -1;
+    result->limbs = mpz_size(result->mem);
+    return;
+  }
+
+  uint64_t bounds[2];
+  gmp_split_range(lo, hi, 2, bounds);
+  uint64_t mid = bounds[0] < lo ? lo : bounds[0] >= hi ? hi - 1 : bounds[0];
+  operand lower;
+  operand upper;
+
+  ooc_product(oc, &lower, lo, mid);
+  if (operand_spill(oc, &lower)) {
+    ooc_product(oc, &upper, mid + 1, hi);
+    if (operand_spill(oc, &upper)) {
+      mul_files(oc, result, &lower, &upper);
+    }
+    else {
+      mpz_init(result->mem);
+      result->fd = -1;
+    }
+    operand_free(&upper);
+  }
+  else {
+    mpz_init(result->mem);
+    result->fd = -1;
+  }
+  operand_free(&lower);
+
+  return;
+}
+
+/*
+ *  MARK: write_limbs()
+ *
+ *  Copy the native limbs of op, least significant first, to out.
+ */
+static bool write_limbs(FILE * out, operand const * op) {
+
+  if (op->fd < 0) {
+    return fwrite(mpz_limbs_read(op->mem), sizeof(mp_limb_t), op->limbs, out) == op->limbs;
+  }
+
+  char buffer[1 << 16];
+  off_t offset = 0;
+  off_t length = (off_t) (op->limbs * sizeof(mp_limb_t));
+  bool written = true;
+
+  while (written && offset < length) {
+    ssize_t got = pread(op->fd, buffer, sizeof(buffer), offset);
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    written = got > 0 && fwrite(buffer, 1, (size_t) got, out) == (size_t) got;
+    offset += written ? got : 0;
+  }
+
+  return written;
+}
+
+/*
+ *  MARK: divide_pass()
+ *
+ *  op = op / divisor in place, a window of a block at a time from the top, leaving
+ *  op mod divisor in remainder (mpz_size(divisor) limbs). num and quotient hold a
+ *  block plus that many limbs, and a block plus one.
+ */
+static bool divide_pass(ooc * oc, operand * op, mpz_srcptr divisor, mp_limb_t * num, mp_limb_t * quotient, mp_limb_t * remainder) {
+
+  size_t dn = mpz_size(divisor);
+  size_t hi = op->limbs;
+  bool divided = true;
+
+  memset(remainder, 0, dn * sizeof(mp_limb_t));
+  while (divided && hi > 0) {
+    size_t lo = hi > oc->block ? hi - oc->block : 0;
+    window win;
+    divided = window_map(op, lo, hi - lo, true, &win);
+    if (divided) {
+      //  remainder < divisor, so the top limb of the quotient is 0.
+      memcpy(num, win.limbs, (hi - lo) * sizeof(mp_limb_t));
+      memcpy(num + (hi - lo), remainder, dn * sizeof(mp_limb_t));
+      mpn_tdiv_qr(quotient, remainder, 0, num, (mp_size_t) (hi - lo + dn), mpz_limbs_read(divisor), (mp_size_t) dn);
+      memcpy(win.limbs, quotient, (hi - lo) * sizeof(mp_limb_t));
+      window_unmap(&win);
+      STATS_COUNT(STATS_LIMB_OPS, hi - lo + dn);
+    }
+    hi = lo;
+  }
+
+  mp_limb_t top = 0;
+  while (divided && op->limbs > 0
+         && (divided = pread(op->fd, &top, sizeof(top), (off_t) ((op->limbs - 1) * sizeof(mp_limb_t))) == sizeof(top))
+         && top == 0) {
+    --op->limbs;
+  }
+  oc->failed = oc->failed || !divided;
+
+  return divided;
+}
+
+/*
+ *  MARK: copy_text()
+ *
+ *  Copy length bytes at offset of the file fd to out.
+ */
+static bool copy_text(FILE * out, int fd, off_t offset, size_t length) {
+
+  char buffer[1 << 16];
+  bool written = true;
+
+  while (written && length > 0) {
+    ssize_t got = pread(fd, buffer, length < sizeof(buffer) ? length : sizeof(buffer), offset);
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    written = got > 0 && fwrite(buffer, 1, (size_t) got, out) == (size_t) got;
+    offset += written ? got : 0;
+    length -= written ? (size_t) got : 0;
+  }
+
+  return written;
+}
+
+/*
+ *  MARK: write_row()
+ *
+ *  Write the row for val! = op. One in memory, a quarter of the budget at most, goes
+ *  to stream_factorial_row(); a spilled one is converted by divide_pass(), which
+ *  leaves op divided.
+ */
+static bool write_row(ooc * oc, FILE * out, uint64_t val, operand * op) {
+
+  if (op->fd < 0) {
+    return stream_factorial_row(out, val, op->mem);
+  }
+
+  //  D digits, with 10^D < 2^(GMP_NUMB_BITS * block / 2).
+  size_t digits = (size_t) ((double) (oc->block / 2 * GMP_NUMB_BITS) * 0.30102999566398119521);
+  mpz_t divisor;
+  mpz_init(divisor);
+  mpz_ui_pow_ui(divisor, 10, digits);
+  size_t dn = mpz_size(divisor);
+
+  mp_limb_t * num = memprof_malloc((oc->block + dn) * sizeof(mp_limb_t));
+  mp_limb_t * quotient = memprof_malloc((oc->block + 1) * sizeof(mp_limb_t));
+  mp_limb_t * remainder = memprof_malloc(dn * sizeof(mp_limb_t));
+  int fd = spill_open(oc);
+  FILE * chunks = fd >= 0 ? fdopen(fd, "w+b") : NULL;
+  size_t * lengths = NULL;
+  size_t chunks_c = 0;
+  bool written = num != NULL && quotient != NULL && remainder != NULL && chunks != NULL;
+
+  if (fd >= 0 && chunks == NULL) {
+    close(fd);
+  }
+  while (written && op->limbs > 2 * oc->block) {
+    size_t * grown = realloc(lengths, (chunks_c + 1) * sizeof(*lengths));
+    written = grown != NULL && divide_pass(oc, op, divisor, num, quotient, remainder);
+    if (grown != NULL) {
+      lengths = grown;
+    }
+    if (written) {
+      mpz_t view;
+      off_t start = ftello(chunks);
+      written = stream_mpz_decimal(chunks, mpz_roinit_n(view, remainder, (mp_size_t) dn));
+      lengths[chunks_c++] = (size_t) (ftello(chunks) - start);
+    }
+  }
+  memprof_free(remainder);
+  memprof_free(quotient);
+  memprof_free(num);
+  mpz_clear(divisor);
+
+  window whole;
+  if (written && fflush(chunks) == 0 && window_map(op, 0, op->limbs, false, &whole)) {
+    mpz_t view;
+    mpz_roinit_n(view, whole.limbs, (mp_size_t) op->limbs);
+    size_t top_digits = mpz_sizeinbase(view, 10);
+    int pc = fprintf(out, "%6" PRIu64 "!: ", val);
+    written = pc > 0 && stream_mpz_decimal(out, view);
+    window_unmap(&whole);
+
+    off_t offset = 0;
+    for (size_t c_ = 0; c_ < chunks_c; ++c_) {
+      offset += (off_t) lengths[c_];
+    }
+    for (size_t c_ = chunks_c; written && c_-- > 0; ) {
+      offset -= (off_t) lengths[c_];
+      for (size_t z_ = lengths[c_]; written && z_ < digits; ++z_) {
+        written = putc('0', out) != EOF;
+      }
+      written = written && copy_text(out, fileno(chunks), offset, lengths[c_]);
+    }
+    written = written && putc('\n', out) != EOF;
+    STATS_COUNT(STATS_BYTES_FORMATTED, pc + top_digits + chunks_c * digits + 1);
+  }
+  else {
+    written = false;
+  }
+  if (chunks != NULL) {
+    fclose(chunks);
+  }
+  free(lengths);
+  oc->failed = oc->failed || !written;
+
+  return written;
+}
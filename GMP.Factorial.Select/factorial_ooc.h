@@ -0,0 +1,41 @@
+//
+//  factorial_ooc.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Out-of-core GMP factorials.
+//  Subproducts that would take more than a quarter of a memory budget are kept as
+//  raw limb files in a spill directory, and two such operands are multiplied a
+//  block at a time through windows mapped from their files, so the memory in use
+//  stays near the budget however large n! is.
+//
+
+#pragma once
+#ifndef factorial_ooc_h
+#define factorial_ooc_h
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Smallest budget accepted by --mem-budget.
+#define OOC_BUDGET_MIN (64 * 1024)
+
+//  MARK: - Prototypes
+size_t ooc_parse_size(char const * spec);
+bool stream_factorials_ooc(FILE * out, uint64_t nbegin, uint64_t nend, size_t budget, char const * spill_dir, bool limbs);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_ooc_h */
@@ -0,0 +1,362 @@
+//
+//  factorial_pipeline.c
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  The stages share a ring of "depth" slots. Row i lives in slot i % depth and moves
+//  free -> queued -> ready -> free: the producer copies n! into a free slot's own mpz
+//  (mpz_set() reuses its limbs, so the ring's memory stops growing once it has held
+//  the largest rows), any formatter claims the next queued row and formats it, and the
+//  writer waits for the next ready row in order. The producer waits only when the
+//  writer is a whole ring behind.
+//
+//  Only the calling thread counts in factorial_stats; the writer's byte count is added
+//  after it is joined. With no formatters, for --memprof whose counters are not shared
+//  between threads, every stage runs in turn in the calling thread.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <pthread.h>
+#include <gmp.h>
+
+#include "factorial_pipeline.h"
+#include "factorial_gmp.h"
+#include "factorial_stats.h"
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct slot
+enum slot_state { SLOT_FREE, SLOT_QUEUED, SLOT_READY, };
+
+struct slot {
+  enum slot_state state;
+  mpz_t           snapshot;
+  char *          text;
+  size_t          length;
+};
+typedef struct slot slot;
+
+//  MARK: struct pipeline
+//  Rows are counted from 0 (nbegin). produced, claimed and written only grow.
+struct pipeline {
+  pthread_mutex_t lock;
+  pthread_cond_t  queued;     //  a row was produced, or the producer is done
+  pthread_cond_t  ready;      //  a row was formatted
+  pthread_cond_t  freed;      //  a row was written
+  FILE *          out;
+  uint64_t        nbegin;
+  slot *          slots;
+  unsigned        depth;
+  uint64_t        produced;
+  uint64_t        claimed;
+  uint64_t        written;
+  bool            done;
+  bool            failed;
+  double          format_busy;
+  double          write_busy;
+  uint64_t        bytes;
+};
+typedef struct pipeline pipeline;
+
+//  MARK: - Prototypes
+static bool sweep_in_turn(FILE * out, uint64_t nbegin, uint64_t nend, pipeline_usage * usage);
+static void * formatter_thread(void * arg);
+static void * writer_thread(void * arg);
+static char * format_row(uint64_t val, mpz_srcptr pf, size_t * length);
+static void free_text(char * text, size_t length);
+
+// MARK: - Implementation
+/*
+ *  MARK: pipeline_factorials_gmp()
+ *
+ *  Write the rows nbegin! to nend! to out as factorial_gmp() displays them, computing,
+ *  formatting and writing in parallel with "formatters" threads converting, and
+ *  record the time each stage was busy in usage. Returns false if a write failed.
+ */
+bool pipeline_factorials_gmp(FILE * out, uint64_t nbegin, uint64_t nend, unsigned formatters, pipeline_usage * usage) {
+
+  memset(usage, 0, sizeof(*usage));
+  usage->formatters = formatters;
+  if (formatters == 0 || nend < nbegin) {
+    return sweep_in_turn(out, nbegin, nend, usage);
+  }
+
+  double start = stats_seconds();
+  pipeline pl = { .out = out, .nbegin = nbegin, .depth = formatters * PIPELINE_DEPTH_PER_FORMATTER, };
+  pthread_t writer;
+  pthread_t threads[PIPELINE_FORMATTERS_MAX];
+  unsigned started = 0;
+  bool writing;
+  mpz_t pf;
+
+  pl.slots = calloc(pl.depth, sizeof(*pl.slots));
+  if (pl.slots == NULL) {
+    return sweep_in_turn(out, nbegin, nend, usage);
+  }
+  for (unsigned s_ = 0; s_ < pl.depth; ++s_) {
+    mpz_init(pl.slots[s_].snapshot);
+  }
+  pthread_mutex_init(&pl.lock, NULL);
+  pthread_cond_init(&pl.queued, NULL);
+  pthread_cond_init(&pl.ready, NULL);
+  pthread_cond_init(&pl.freed, NULL);
+
+  writing = pthread_create(&writer, NULL, writer_thread, &pl) == 0;
+  while (writing && started < formatters && pthread_create(&threads[started], NULL, formatter_thread, &pl) == 0) {
+    ++started;
+  }
+  usage->formatters = started;
+
+  mpz_init(pf);
+  for (uint64_t nb = nbegin; writing && started > 0 && nb <= nend; ++nb) {
+    double busy = stats_seconds();
+    if (nb == nbegin) {
+      gmp_fact_swing(pf, nb);
+    }
+    else {
+      mpz_mul_ui(pf, pf, nb);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      STATS_COUNT(STATS_LIMB_OPS, mpz_size(pf));
+    }
+    usage->produce += stats_seconds() - busy;
+
+    pthread_mutex_lock(&pl.lock);
+    while (pl.produced - pl.written >= pl.depth && !pl.failed) {
+      pthread_cond_wait(&pl.freed, &pl.lock);
+    }
+    bool failed = pl.failed;
+    pthread_mutex_unlock(&pl.lock);
+    if (failed) {
+      break;
+    }
+
+    //  The slot is free, and only the producer touches free slots.
+    busy = stats_seconds();
+    slot * sl = &pl.slots[pl.produced % pl.depth];
+    mpz_set(sl->snapshot, pf);
+    usage->produce += stats_seconds() - busy;
+
+    pthread_mutex_lock(&pl.lock);
+    sl->state = SLOT_QUEUED;
+    ++pl.produced;
+    pthread_cond_signal(&pl.queued);
+    pthread_mutex_unlock(&pl.lock);
+  }
+  mpz_clear(pf);
+
+  pthread_mutex_lock(&pl.lock);
+  pl.done = true;
+  pthread_cond_broadcast(&pl.queued);
+  pthread_cond_broadcast(&pl.ready);
+  pthread_mutex_unlock(&pl.lock);
+  for (unsigned t_ = 0; t_ < started; ++t_) {
+    pthread_join(threads[t_], NULL);
+  }
+  if (writing) {
+    pthread_join(writer, NULL);
+  }
+
+  //  Without a writer or a formatter nothing was produced; do it all here instead.
+  bool complete = writing && started > 0;
+  if (complete) {
+    STATS_COUNT(STATS_BYTES_FORMATTED, pl.bytes);
+    usage->format = pl.format_busy;
+    usage->write = pl.write_busy;
+    usage->wall = stats_seconds() - start;
+  }
+  for (unsigned s_ = 0; s_ < pl.depth; ++s_) {
+    mpz_clear(pl.slots[s_].snapshot);
+    if (pl.slots[s_].state == SLOT_READY) {
+      free_text(pl.slots[s_].text, pl.slots[s_].length);
+    }
+  }
+  free(pl.slots);
+  pthread_cond_destroy(&pl.freed);
+  pthread_cond_destroy(&pl.ready);
+  pthread_cond_destroy(&pl.queued);
+  pthread_mutex_destroy(&pl.lock);
+
+  if (!complete) {
+    usage->formatters = 0;
+    return sweep_in_turn(out, nbegin, nend, usage);
+  }
+
+  return !pl.failed;
+}
+
+/*
+ *  MARK: pipeline_report()
+ *
+ *  Display the share of the wall time each stage was busy.
+ */
+void pipeline_report(FILE * out, pipeline_usage const * usage) {
+
+  double wall = usage->wall > 0.0 ? usage->wall : 1.0;
+  unsigned formatters = usage->formatters > 0 ? usage->formatters : 1;
+
+  fprintf(out, "\nPipeline utilisation over %.6f seconds:\n", usage->wall);
+  if (usage->formatters == 0) {
+    fprintf(out, "(the stages ran in turn in one thread)\n");
+  }
+  fprintf(out, "%-10s %8s %14s %12s\n", "stage", "threads", "busy_seconds", "utilisation");
+  fprintf(out, "%-10s %8u %14.6f %11.1f%%\n", "produce", 1U, usage->produce, 100.0 * usage->produce / wall);
+  fprintf(out, "%-10s %8u %14.6f %11.1f%%\n", "format", formatters, usage->format, 100.0 * usage->format / (wall * formatters));
+  fprintf(out, "%-10s %8u %14.6f %11.1f%%\n", "write", 1U, usage->write, 100.0 * usage->write / wall);
+
+  return;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: sweep_in_turn()
+ *
+ *  The three stages one after another in the calling thread.
+ */
+static bool sweep_in_turn(FILE * out, uint64_t nbegin, uint64_t nend, pipeline_usage * usage) {
+
+  double start = stats_seconds();
+  bool written = true;
+  mpz_t pf;
+
+  mpz_init(pf);
+  for (uint64_t nb = nbegin; written && nb <= nend; ++nb) {
+    double busy = stats_seconds();
+    if (nb == nbegin) {
+      gmp_fact_swing(pf, nb);
+    }
+    else {
+      mpz_mul_ui(pf, pf, nb);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      STATS_COUNT(STATS_LIMB_OPS, mpz_size(pf));
+    }
+    double formatting = stats_seconds();
+    size_t length;
+    char * text = format_row(nb, pf, &length);
+    double writing = stats_seconds();
+    written = text != NULL && fwrite(text, 1, length, out) == length;
+    free_text(text, length);
+    STATS_COUNT(STATS_BYTES_FORMATTED, length);
+    double stop = stats_seconds();
+
+    usage->produce += formatting - busy;
+    usage->format += writing - formatting;
+    usage->write += stop - writing;
+  }
+  mpz_clear(pf);
+  usage->wall = stats_seconds() - start;
+
+  return written;
+}
+
+/*
+ *  MARK: formatter_thread()
+ */
+static void * formatter_thread(void * arg) {
+
+  pipeline * pl = (pipeline *) arg;
+
+  pthread_mutex_lock(&pl->lock);
+  for (;;) {
+    while (pl->claimed == pl->produced && !pl->done) {
+      pthread_cond_wait(&pl->queued, &pl->lock);
+    }
+    if (pl->claimed == pl->produced) {
+      break;
+    }
+    uint64_t row = pl->claimed++;
+    slot * sl = &pl->slots[row % pl->depth];
+    pthread_mutex_unlock(&pl->lock);
+
+    double busy = stats_seconds();
+    size_t length;
+    char * text = format_row(pl->nbegin + row, sl->snapshot, &length);
+    busy = stats_seconds() - busy;
+
+    pthread_mutex_lock(&pl->lock);
+    sl->text = text;
+    sl->length = length;
+    sl->state = SLOT_READY;
+    pl->format_busy += busy;
+    pthread_cond_broadcast(&pl->ready);
+  }
+  pthread_mutex_unlock(&pl->lock);
+
+  return NULL;
+}
+
+/*
+ *  MARK: writer_thread()
+ *
+ *  After a failed write the rows are still taken, and dropped, so that no stage waits
+ *  on the writer.
+ */
+static void * writer_thread(void * arg) {
+
+  pipeline * pl = (pipeline *) arg;
+
+  pthread_mutex_lock(&pl->lock);
+  for (;;) {
+    slot * sl = &pl->slots[pl->written % pl->depth];
+    while ((pl->written == pl->produced || sl->state != SLOT_READY) && !(pl->done && pl->written == pl->produced)) {
+      pthread_cond_wait(&pl->ready, &pl->lock);
+    }
+    if (pl->written == pl->produced) {
+      break;
+    }
+    bool failed = pl->failed;
+    pthread_mutex_unlock(&pl->lock);
+
+    double busy = stats_seconds();
+    bool written = !failed && sl->text != NULL && fwrite(sl->text, 1, sl->length, pl->out) == sl->length;
+    free_text(sl->text, sl->length);
+    busy = stats_seconds() - busy;
+
+    pthread_mutex_lock(&pl->lock);
+    pl->bytes += written ? sl->length : 0;
+    pl->failed = pl->failed || !written;
+    pl->write_busy += busy;
+    sl->text = NULL;
+    sl->state = SLOT_FREE;
+    ++pl->written;
+    pthread_cond_signal(&pl->freed);
+  }
+  pthread_mutex_unlock(&pl->lock);
+
+  return NULL;
+}
+
+/*
+ *  MARK: format_row()
+ *
+ *  The row of fact_gmp() for val! = pf, to be released with free_text().
+ */
+static char * format_row(uint64_t val, mpz_srcptr pf, size_t * length) {
+
+  char * text = NULL;
+  int pc = gmp_asprintf(&text, "%6" PRIu64 "!: %20Zd\n", val, pf);
+  *length = pc > 0 ? (size_t) pc : 0;
+
+  return pc > 0 ? text : NULL;
+}
+
+/*
+ *  MARK: free_text()
+ */
+static void free_text(char * text, size_t length) {
+
+  if (text != NULL) {
+    void (* free_fn)(void *, size_t);
+    mp_get_memory_functions(NULL, NULL, &free_fn);
+    free_fn(text, length + 1);
+  }
+
+  return;
+}
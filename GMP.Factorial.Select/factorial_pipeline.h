@@ -0,0 +1,51 @@
+//
+//  factorial_pipeline.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Pipelined GMP sweep: the calling thread multiplies (n + 1)! from n! while a pool
+//  of formatter threads converts copies of earlier factorials to decimal and a writer
+//  thread emits the rows in order. At most PIPELINE_DEPTH_PER_FORMATTER snapshots per
+//  formatter are in flight, so memory stays bounded however long the range.
+//
+
+#pragma once
+#ifndef factorial_pipeline_h
+#define factorial_pipeline_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+#define PIPELINE_FORMATTERS_MAX      64
+#define PIPELINE_DEPTH_PER_FORMATTER 2
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct pipeline_usage
+//  Seconds each stage spent working rather than waiting on its neighbours; format is
+//  summed over the formatters.
+struct pipeline_usage {
+  unsigned formatters;
+  double   wall;
+  double   produce;
+  double   format;
+  double   write;
+};
+typedef struct pipeline_usage pipeline_usage;
+
+//  MARK: - Prototypes
+bool pipeline_factorials_gmp(FILE * out, uint64_t nbegin, uint64_t nend, unsigned formatters, pipeline_usage * usage);
+void pipeline_report(FILE * out, pipeline_usage const * usage);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_pipeline_h */
@@ -0,0 +1,289 @@
+//
+//  factorial_procs.c
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+
+//  MARK: - Definitions
+
+#if __linux__
+#define _GNU_SOURCE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <gmp.h>
+
+#include "factorial_procs.h"
+#include "factorial_gmp.h"
+#include "factorial_stats.h"
+
+//  MARK: struct worker
+//  A forked worker: its subrange and the shared memory file its product is written to.
+struct worker {
+  uint64_t lo;
+  uint64_t hi;
+  pid_t pid;
+  int fd;
+};
+typedef struct worker worker;
+
+//  MARK: - Prototypes
+static int shared_file(unsigned index);
+static bool write_all(int fd, void const * data, size_t length);
+static void run_worker(worker const * wkr);
+static bool collect_worker(worker * wkr, mpz_t product);
+static void abandon_workers(worker workers[], unsigned count);
+
+//  MARK: - Implementation
+/*
+ *  MARK: procs_fact()
+ *
+ *  result = val! using "procs" worker processes.
+ *
+ *  2..val is cut into subranges with products of about equal size (equal shares of
+ *  log val!), each worker forms its product with gmp_range_product() and writes the
+ *  limbs to an anonymous shared memory file, and the coordinator maps the files back
+ *  in and multiplies the products pairwise.
+ *  If a worker cannot be started, dies, or fails to deliver its product the remaining
+ *  workers are killed and reaped, every file is closed and false is returned with
+ *  result untouched.
+ */
+bool procs_fact(mpz_t result, uint64_t val, unsigned procs) {
+
+  bool computed = true;
+
+  procs = procs > PROCS_MAX ? PROCS_MAX : procs;
+  if (procs <= 1 || val < PROCS_MIN_N) {
+    gmp_fact_tree(result, val);
+  }
+  else {
+    worker workers[PROCS_MAX];
+    mpz_t products[PROCS_MAX];
+    uint64_t bounds[PROCS_MAX];
+    unsigned started = 0;
+
+    gmp_split_range(2, val, procs, bounds);
+    fflush(NULL);
+    for (uint64_t lo = 2; computed && started < procs; ++started) {
+      worker * wkr = &workers[started];
+      wkr->lo = lo;
+      wkr->hi = bounds[started];
+      wkr->pid = -1;
+      wkr->fd = shared_file(started);
+      lo = wkr->hi + 1;
+
+      if (wkr->fd < 0) {
+        computed = false;
+      }
+      else if ((wkr->pid = fork()) < 0) {
+        perror("fork");
+        computed = false;
+      }
+      else if (wkr->pid == 0) {
+        run_worker(wkr);
+      }
+    }
+
+    unsigned collected = 0;
+    for (; computed && collected < started; ++collected) {
+      mpz_init(products[collected]);
+      if (!collect_worker(&workers[collected], products[collected])) {
+        mpz_clear(products[collected]);
+        computed = false;
+        break;
+      }
+    }
+    if (!computed) {
+      abandon_workers(workers + collected, started - collected);
+    }
+
+    //  Balanced merge: multiply neighbours until one product is left.
+    for (unsigned count = collected; computed && count > 1; count = (count + 1) / 2) {
+      for (unsigned p_ = 0; p_ < count / 2; ++p_) {
+        mpz_mul(products[p_], products[2 * p_], products[2 * p_ + 1]);
+        STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+        STATS_COUNT(STATS_LIMB_OPS, mpz_size(products[p_]));
+      }
+      if (count % 2 != 0) {
+        mpz_swap(products[count / 2], products[count - 1]);
+      }
+    }
+    if (computed) {
+      mpz_swap(result, products[0]);
+    }
+    for (unsigned p_ = 0; p_ < collected; ++p_) {
+      mpz_clear(products[p_]);
+    }
+  }
+
+  return computed;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: shared_file()
+ *
+ *  An anonymous, already unlinked shared memory file, or -1.
+ */
+static int shared_file(unsigned index) {
+
+  int fd;
+
+#if __linux__
+  char name[32];
+  snprintf(name, sizeof(name), "factorial_part_%u", index);
+  fd = memfd_create(name, MFD_CLOEXEC);
+#else
+  char name[64];
+  snprintf(name, sizeof(name), "/factorial_part_%ld_%u", (long) getpid(), index);
+  fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  if (fd >= 0) {
+    shm_unlink(name);
+  }
+#endif
+  if (fd < 0) {
+    perror("shared memory");
+  }
+
+  return fd;
+}
+
+/*
+ *  MARK: write_all()
+ */
+static bool write_all(int fd, void const * data, size_t length) {
+
+  char const * next = data;
+
+  while (length > 0) {
+    ssize_t wrote = write(fd, next, length);
+    if (wrote < 0 && errno == EINTR) {
+      continue;
+    }
+    if (wrote <= 0) {
+      return false;
+    }
+    next += wrote;
+    length -= (size_t) wrote;
+  }
+
+  return true;
+}
+
+/*
+ *  MARK: run_worker()
+ *
+ *  In the child: compute the subrange product, write its limbs to the shared file
+ *  and exit. Never returns.
+ */
+static void run_worker(worker const * wkr) {
+
+  mpz_t product;
+  int status = EXIT_SUCCESS;
+
+  mpz_init(product);
+  gmp_range_product(product, wkr->lo, wkr->hi);
+  size_t limbs = mpz_size(product);
+  if (!write_all(wkr->fd, mpz_limbs_read(product), limbs * sizeof(mp_limb_t))) {
+    status = EXIT_FAILURE;
+  }
+  mpz_clear(product);
+
+  _exit(status);
+}
+
+/*
+ *  MARK: collect_worker()
+ *
+ *  Wait for the worker and read its product from the shared file.
+ */
+static bool collect_worker(worker * wkr, mpz_t product) {
+
+  bool collected = false;
+  int status = 0;
+  pid_t reaped;
+
+  while ((reaped = waitpid(wkr->pid, &status, 0)) < 0 && errno == EINTR) {
+  }
+  wkr->pid = -1;
+
+  if (reaped < 0) {
+    perror("waitpid");
+  }
+  else if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+    if (WIFSIGNALED(status)) {
+      fprintf(stderr, "worker for %" PRIu64 "..%" PRIu64 " killed by signal %d\n", wkr->lo, wkr->hi, WTERMSIG(status));
+    }
+    else {
+      fprintf(stderr, "worker for %" PRIu64 "..%" PRIu64 " failed\n", wkr->lo, wkr->hi);
+    }
+  }
+  else {
+    struct stat st;
+    if (fstat(wkr->fd, &st) != 0 || st.st_size % sizeof(mp_limb_t) != 0) {
+      fprintf(stderr, "worker for %" PRIu64 "..%" PRIu64 " left an unreadable product\n", wkr->lo, wkr->hi);
+    }
+    else if (st.st_size == 0) {
+      mpz_set_ui(product, 0);
+      collected = true;
+    }
+    else {
+      size_t limbs = (size_t) st.st_size / sizeof(mp_limb_t);
+      void * mapped = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, wkr->fd, 0);
+      if (mapped == MAP_FAILED) {
+        perror("mmap");
+      }
+      else {
+        memcpy(mpz_limbs_write(product, (mp_size_t) limbs), mapped, (size_t) st.st_size);
+        mpz_limbs_finish(product, (mp_size_t) limbs);
+        munmap(mapped, (size_t) st.st_size);
+        collected = true;
+      }
+    }
+  }
+  close(wkr->fd);
+  wkr->fd = -1;
+
+  return collected;
+}
+
+/*
+ *  MARK: abandon_workers()
+ *
+ *  Kill and reap the workers not yet collected and close their files.
+ */
+static void abandon_workers(worker workers[], unsigned count) {
+
+  for (unsigned w_ = 0; w_ < count; ++w_) {
+    if (workers[w_].pid > 0) {
+      kill(workers[w_].pid, SIGKILL);
+    }
+  }
+  for (unsigned w_ = 0; w_ < count; ++w_) {
+    if (workers[w_].pid > 0) {
+      while (waitpid(workers[w_].pid, NULL, 0) < 0 && errno == EINTR) {
+      }
+    }
+    if (workers[w_].fd >= 0) {
+      close(workers[w_].fd);
+    }
+  }
+
+  return;
+}
@@ -0,0 +1,38 @@
+//
+//  factorial_procs.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Multi-process GMP factorial on a single host.
+//  Worker processes, each with its own address space and GMP allocator, compute
+//  the products of subranges of 2..n into shared memory files; the coordinator
+//  merges them in a balanced tree.
+//
+
+#pragma once
+#ifndef factorial_procs_h
+#define factorial_procs_h
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Below this n a factorial is computed in-process: forking costs more than it saves.
+#define PROCS_MIN_N 20000
+#define PROCS_MAX 256
+
+//  MARK: - Prototypes
+bool procs_fact(mpz_t result, uint64_t val, unsigned procs);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_procs_h */
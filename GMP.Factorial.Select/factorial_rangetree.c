@@ -0,0 +1,386 @@
+//
+//  factorial_rangetree.c
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://cp-algorithms.com/data_structures/segment_tree.html
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  A window lo..hi is cut into the partial leaves at its ends and the run of
+//  complete leaves between them; the run is covered bottom-up as in an iterative
+//  segment tree query, taking a node whenever the run's bound on that level is odd.
+//  The pieces are then multiplied two smallest at a time, so each multiplication has
+//  operands of similar size, as in the balanced product tree.
+//
+//  File layout: a header, which also records how long the tree took to build, and
+//  the limb count of every node, padded to a page, then the limbs of the nodes
+//  level by level.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <gmp.h>
+
+#include "factorial_rangetree.h"
+#include "factorial_gmp.h"
+#include "factorial_stats.h"
+
+#define RANGETREE_MAGIC "FACTRNG2"
+#define RANGETREE_PAGE  4096
+
+//  Most pieces of one window: two nodes per level and the two partial leaves.
+#define PIECES_MAX (2 * RANGETREE_LEVELS_MAX + 2)
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct rangetree_header
+struct rangetree_header {
+  char     magic[8];
+  uint64_t limb_bytes;
+  uint64_t n;
+  uint64_t leaf;
+  uint64_t levels;
+  uint64_t nodes_c;
+  double   build_seconds;
+};
+typedef struct rangetree_header rangetree_header;
+
+//  MARK: - Prototypes
+static void shape(rangetree * tree, uint64_t n);
+static uint64_t nodes_total(rangetree const * tree);
+static size_t data_offset(uint64_t nodes_c);
+static bool save_tree(rangetree const * tree, char const * path);
+
+// MARK: - Implementation
+/*
+ *  MARK: rangetree_build()
+ *
+ *  Build the index over [1, n] in memory and, with a path, save it to that file
+ *  (through a temporary file renamed into place once complete).
+ *  Returns false, having reported why, on failure.
+ */
+bool rangetree_build(rangetree * tree, uint64_t n, char const * path) {
+
+  double started = stats_seconds();
+
+  shape(tree, n);
+  for (unsigned k_ = 0; k_ < tree->levels; ++k_) {
+    tree->nodes[k_] = malloc(tree->count[k_] * sizeof(mpz_t));
+    if (tree->nodes[k_] == NULL) {
+      fprintf(stderr, "rangetree: no memory for %" PRIu64 " nodes\n", tree->count[k_]);
+      rangetree_close(tree);
+      return false;
+    }
+    for (uint64_t i_ = 0; i_ < tree->count[k_]; ++i_) {
+      mpz_init(tree->nodes[k_][i_]);
+      if (k_ == 0) {
+        gmp_range_product(tree->nodes[k_][i_], i_ * tree->leaf + 1, (i_ + 1) * tree->leaf);
+      }
+      else {
+        mpz_mul(tree->nodes[k_][i_], tree->nodes[k_ - 1][2 * i_], tree->nodes[k_ - 1][2 * i_ + 1]);
+        STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+        STATS_COUNT(STATS_LIMB_OPS, mpz_size(tree->nodes[k_][i_]));
+      }
+      tree->bytes += mpz_size(tree->nodes[k_][i_]) * sizeof(mp_limb_t);
+    }
+  }
+  tree->build_seconds = stats_seconds() - started;
+
+  if (path != NULL && !save_tree(tree, path)) {
+    rangetree_close(tree);
+    return false;
+  }
+
+  return true;
+}
+
+/*
+ *  MARK: rangetree_open()
+ *
+ *  Map, read only, an index file written by rangetree_build(). The nodes are read
+ *  in place.
+ */
+bool rangetree_open(rangetree * tree, char const * path) {
+
+  double started = stats_seconds();
+  struct stat st;
+  int fd = open(path, O_RDONLY);
+  void * map = MAP_FAILED;
+
+  memset(tree, 0, sizeof(*tree));
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    return false;
+  }
+  if ((size_t) st.st_size >= RANGETREE_PAGE) {
+    map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+
+  rangetree_header const * header = map;
+  bool valid = memcmp(header->magic, RANGETREE_MAGIC, sizeof(header->magic)) == 0
+            && header->limb_bytes == sizeof(mp_limb_t) && header->leaf == RANGETREE_LEAF;
+  if (valid) {
+    shape(tree, header->n);
+    valid = header->levels == tree->levels && header->nodes_c == nodes_total(tree)
+         && data_offset(header->nodes_c) <= (size_t) st.st_size;
+    tree->build_seconds = header->build_seconds;
+  }
+
+  uint64_t const * sizes = (uint64_t const *) (header + 1);
+  mp_limb_t const * next = (mp_limb_t const *) ((char const *) map + data_offset(header->nodes_c));
+  mp_limb_t const * end = (mp_limb_t const *) ((char const *) map + st.st_size);
+  for (unsigned k_ = 0; valid && k_ < tree->levels; ++k_) {
+    tree->nodes[k_] = malloc(tree->count[k_] * sizeof(mpz_t));
+    valid = tree->nodes[k_] != NULL;
+    for (uint64_t i_ = 0; valid && i_ < tree->count[k_]; ++i_) {
+      uint64_t limbs = *sizes++;
+      valid = limbs > 0 && limbs <= (uint64_t) (end - next);
+      if (valid) {
+        mpz_roinit_n(tree->nodes[k_][i_], next, (mp_size_t) limbs);
+        next += limbs;
+        tree->bytes += limbs * sizeof(mp_limb_t);
+      }
+    }
+  }
+  tree->map = map;
+  tree->map_size = (size_t) st.st_size;
+  if (!valid) {
+    fprintf(stderr, "%s: not a range product index\n", path);
+    rangetree_close(tree);
+    return false;
+  }
+  tree->map_seconds = stats_seconds() - started;
+
+  return true;
+}
+
+/*
+ *  MARK: rangetree_close()
+ */
+void rangetree_close(rangetree * tree) {
+
+  for (unsigned k_ = 0; k_ < tree->levels; ++k_) {
+    for (uint64_t i_ = 0; tree->map == NULL && tree->nodes[k_] != NULL && i_ < tree->count[k_]; ++i_) {
+      mpz_clear(tree->nodes[k_][i_]);
+    }
+    free(tree->nodes[k_]);
+  }
+  if (tree->map != NULL) {
+    munmap(tree->map, tree->map_size);
+  }
+  memset(tree, 0, sizeof(*tree));
+
+  return;
+}
+
+/*
+ *  MARK: rangetree_product()
+ *
+ *  result = lo * (lo + 1) * ... * hi; 1 when lo > hi. Factors above tree->n are
+ *  multiplied directly.
+ */
+void rangetree_product(rangetree const * tree, mpz_t result, uint64_t lo, uint64_t hi) {
+
+  uint64_t leaf = tree->leaf;
+  uint64_t first = lo == 0 ? 0 : (lo - 1 + leaf - 1) / leaf;  //  first complete leaf
+  uint64_t last = hi / leaf < tree->count[0] ? hi / leaf : tree->count[0];  //  one past the last
+
+  if (lo > hi) {
+    mpz_set_ui(result, 1);
+    return;
+  }
+  if (lo == 0) {
+    mpz_set_ui(result, 0);
+    return;
+  }
+  if (first >= last) {
+    gmp_range_product(result, lo, hi);
+    return;
+  }
+
+  mpz_t work[PIECES_MAX];
+  mpz_srcptr piece[PIECES_MAX];
+  size_t pieces_c = 0;
+
+  for (size_t p_ = 0; p_ < PIECES_MAX; ++p_) {
+    mpz_init(work[p_]);
+  }
+  if (lo <= first * leaf) {
+    gmp_range_product(work[pieces_c], lo, first * leaf);
+    piece[pieces_c] = work[pieces_c];
+    ++pieces_c;
+  }
+  if (last * leaf < hi) {
+    gmp_range_product(work[pieces_c], last * leaf + 1, hi);
+    piece[pieces_c] = work[pieces_c];
+    ++pieces_c;
+  }
+  for (unsigned k_ = 0; first < last; ++k_, first >>= 1, last >>= 1) {
+    if (first & 1) {
+      piece[pieces_c++] = tree->nodes[k_][first++];
+    }
+    if (last & 1) {
+      piece[pieces_c++] = tree->nodes[k_][--last];
+    }
+  }
+
+  //  Multiply the two smallest pieces into the slot of the first and move the last
+  //  piece, with its work value, into the slot of the second.
+  while (pieces_c > 1) {
+    size_t small[2] = { 0, 1, };
+    if (mpz_size(piece[1]) < mpz_size(piece[0])) {
+      small[0] = 1;
+      small[1] = 0;
+    }
+    for (size_t p_ = 2; p_ < pieces_c; ++p_) {
+      if (mpz_size(piece[p_]) < mpz_size(piece[small[0]])) {
+        small[1] = small[0];
+        small[0] = p_;
+      }
+      else if (mpz_size(piece[p_]) < mpz_size(piece[small[1]])) {
+        small[1] = p_;
+      }
+    }
+    mpz_mul(work[small[0]], piece[small[0]], piece[small[1]]);
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+    STATS_COUNT(STATS_LIMB_OPS, mpz_size(work[small[0]]));
+    piece[small[0]] = work[small[0]];
+    --pieces_c;
+    if (small[1] != pieces_c) {
+      bool owned = piece[pieces_c] == work[pieces_c];
+      mpz_swap(work[small[1]], work[pieces_c]);
+      piece[small[1]] = owned ? work[small[1]] : piece[pieces_c];
+    }
+  }
+  mpz_set(result, piece[0]);
+
+  for (size_t p_ = 0; p_ < PIECES_MAX; ++p_) {
+    mpz_clear(work[p_]);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: rangetree_ratio()
+ *
+ *  result = n! / m! for m <= n.
+ */
+void rangetree_ratio(rangetree const * tree, mpz_t result, uint64_t n, uint64_t m) {
+
+  rangetree_product(tree, result, m + 1, n);
+
+  return;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: shape()
+ *
+ *  Clear tree and set its levels and node counts for [1, n].
+ */
+static void shape(rangetree * tree, uint64_t n) {
+
+  memset(tree, 0, sizeof(*tree));
+  tree->n = n;
+  tree->leaf = RANGETREE_LEAF;
+  for (uint64_t count = n / RANGETREE_LEAF; count > 0 && tree->levels < RANGETREE_LEVELS_MAX; count /= 2) {
+    tree->count[tree->levels++] = count;
+  }
+
+  return;
+}
+
+/*
+ *  MARK: nodes_total()
+ */
+static uint64_t nodes_total(rangetree const * tree) {
+
+  uint64_t total = 0;
+  for (unsigned k_ = 0; k_ < tree->levels; ++k_) {
+    total += tree->count[k_];
+  }
+
+  return total;
+}
+
+/*
+ *  MARK: data_offset()
+ *
+ *  Offset of the first limb in a file of nodes_c nodes.
+ */
+static size_t data_offset(uint64_t nodes_c) {
+
+  size_t table = sizeof(rangetree_header) + nodes_c * sizeof(uint64_t);
+
+  return (table + RANGETREE_PAGE - 1) / RANGETREE_PAGE * RANGETREE_PAGE;
+}
+
+/*
+ *  MARK: save_tree()
+ *
+ *  Write the index to "path" atomically: to a temporary file, synced, then renamed.
+ */
+static bool save_tree(rangetree const * tree, char const * path) {
+
+  char tmp_path[4096];
+  FILE * out;
+  rangetree_header header;
+  uint64_t nodes_c = nodes_total(tree);
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, RANGETREE_MAGIC, sizeof(header.magic));
+  header.limb_bytes = sizeof(mp_limb_t);
+  header.n = tree->n;
+  header.leaf = tree->leaf;
+  header.levels = tree->levels;
+  header.nodes_c = nodes_c;
+  header.build_seconds = tree->build_seconds;
+
+  snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+  out = fopen(tmp_path, "w");
+  bool saved = out != NULL && fwrite(&header, sizeof(header), 1, out) == 1;
+  for (unsigned k_ = 0; saved && k_ < tree->levels; ++k_) {
+    for (uint64_t i_ = 0; saved && i_ < tree->count[k_]; ++i_) {
+      uint64_t limbs = mpz_size(tree->nodes[k_][i_]);
+      saved = fwrite(&limbs, sizeof(limbs), 1, out) == 1;
+    }
+  }
+  for (size_t pad = data_offset(nodes_c) - sizeof(header) - nodes_c * sizeof(uint64_t); saved && pad > 0; --pad) {
+    saved = putc('\0', out) != EOF;
+  }
+  for (unsigned k_ = 0; saved && k_ < tree->levels; ++k_) {
+    for (uint64_t i_ = 0; saved && i_ < tree->count[k_]; ++i_) {
+      size_t limbs = mpz_size(tree->nodes[k_][i_]);
+      saved = fwrite(mpz_limbs_read(tree->nodes[k_][i_]), sizeof(mp_limb_t), limbs, out) == limbs;
+    }
+  }
+  if (out != NULL) {
+    saved = fflush(out) == 0 && fsync(fileno(out)) == 0 && saved;
+    saved = fclose(out) == 0 && saved;
+  }
+  saved = saved && rename(tmp_path, path) == 0;
+  if (!saved) {
+    perror(path);
+    unlink(tmp_path);
+  }
+
+  return saved;
+}
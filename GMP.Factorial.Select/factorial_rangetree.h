@@ -0,0 +1,64 @@
+//
+//  factorial_rangetree.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Index of range products over [1, n].
+//  A segment tree of partial products: leaves of RANGETREE_LEAF consecutive factors,
+//  and above them the products of pairs of nodes. The product a * (a + 1) * ... * b
+//  of any window, so n!/m! or a falling factorial, is assembled from at most two
+//  nodes per level and two partial leaves, multiplied smallest first. The tree is
+//  built in memory and can be saved to a file that other runs map.
+//
+
+#pragma once
+#ifndef factorial_rangetree_h
+#define factorial_rangetree_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Factors per leaf.
+#define RANGETREE_LEAF 256
+//  Most levels, leaves included.
+#define RANGETREE_LEVELS_MAX 48
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct rangetree
+//  nodes[k][i] = the product of leaves i * 2^k to (i + 1) * 2^k - 1, leaf j being
+//  the product of j * leaf + 1 to (j + 1) * leaf. Only complete nodes are kept.
+struct rangetree {
+  uint64_t n;
+  uint64_t leaf;
+  unsigned levels;
+  uint64_t count[RANGETREE_LEVELS_MAX];
+  mpz_t *  nodes[RANGETREE_LEVELS_MAX];
+  size_t   bytes;          //  limbs held by the nodes
+  double   build_seconds;  //  as recorded in the file for a mapped tree
+  double   map_seconds;    //  0 for a built tree
+  void *   map;
+  size_t   map_size;
+};
+typedef struct rangetree rangetree;
+
+//  MARK: - Prototypes
+bool rangetree_build(rangetree * tree, uint64_t n, char const * path);
+bool rangetree_open(rangetree * tree, char const * path);
+void rangetree_close(rangetree * tree);
+void rangetree_product(rangetree const * tree, mpz_t result, uint64_t lo, uint64_t hi);
+void rangetree_ratio(rangetree const * tree, mpz_t result, uint64_t n, uint64_t m);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_rangetree_h */
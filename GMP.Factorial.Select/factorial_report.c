@@ -0,0 +1,956 @@
+//
+//  factorial_report.c
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://www.w3.org/TR/SVG11/
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Input files are recognised by their header line, so stats and memprof files may
+//  be given in any order, and columns are found by name, so files written before a
+//  column was added still load. Each file is labelled by its base name; the same
+//  engine in several files is shown side by side in the bar chart.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/utsname.h>
+
+#include "factorial_report.h"
+
+#define REPORT_NAME_MAX   64
+#define REPORT_LINE_MAX   1024
+#define REPORT_FIELDS_MAX 32
+
+#define CHART_WIDTH  760
+#define CHART_HEIGHT 360
+#define CHART_LEFT   80
+#define CHART_RIGHT  200
+#define CHART_TOP    36
+#define CHART_BOTTOM 52
+#define BAR_HEIGHT   16
+
+//  MARK: - Definition of typedef, union, structure, etc.
+enum report_hw {
+  REPORT_CYCLES = 0,
+  REPORT_INSTRUCTIONS,
+  REPORT_CACHE_MISSES,
+  REPORT_BRANCH_MISSES,
+  REPORT_MULTIPLICATIONS,
+  REPORT_LIMB_OPS,
+  REPORT_BYTES_FORMATTED,
+  REPORT_COUNTER_COUNT,
+};
+
+//  MARK: struct report_stats
+//  One line of a --stats file.
+struct report_stats {
+  char     engine[REPORT_NAME_MAX];
+  size_t   file;
+  uint64_t nbegin;
+  uint64_t nend;
+  uint64_t wall_ns;
+  unsigned workers;
+  bool     valid[REPORT_COUNTER_COUNT];
+  uint64_t counter[REPORT_COUNTER_COUNT];
+};
+typedef struct report_stats report_stats;
+
+//  MARK: struct report_mem
+//  One line of a --memprof file.
+struct report_mem {
+  char     engine[REPORT_NAME_MAX];
+  size_t   file;
+  uint64_t n;
+  uint64_t allocs;
+  uint64_t bytes;
+  int64_t  peak_live;
+  uint64_t peak_rss;
+};
+typedef struct report_mem report_mem;
+
+//  MARK: struct report_data
+struct report_data {
+  char const *   const * paths;
+  size_t         files_c;
+  report_stats * stats;
+  size_t         stats_c;
+  report_mem *   mem;
+  size_t         mem_c;
+};
+typedef struct report_data report_data;
+
+//  MARK: struct report_series
+//  A named line of (x, y) points for svg_line_chart().
+struct report_series {
+  char     name[2 * REPORT_NAME_MAX];
+  size_t   points_c;
+  double * x;
+  double * y;
+};
+typedef struct report_series report_series;
+
+//  MARK: struct chart_axis
+struct chart_axis {
+  bool   log_scale;
+  double lo;
+  double hi;
+};
+typedef struct chart_axis chart_axis;
+
+//  MARK: - Static data
+static char const * const counter_names[REPORT_COUNTER_COUNT] = {
+  "cycles", "instructions", "cache_misses", "branch_misses",
+  "multiplications", "limb_ops", "bytes_formatted",
+};
+static char const * const palette[] = {
+  "#4e79a7", "#f28e2b", "#e15759", "#76b7b2", "#59a14f",
+  "#edc948", "#b07aa1", "#ff9da7", "#9c755f", "#bab0ac",
+};
+static size_t const palette_c = sizeof(palette) / sizeof(*palette);
+
+//  MARK: - Prototypes
+static bool load_csv(report_data * data, size_t file);
+static size_t split_csv(char * line, char * fields[], size_t fields_l);
+static int find_column(char * const names[], size_t names_c, char const * name);
+static char const * file_label(char const * path);
+static void html_text(FILE * out, char const * text);
+static void html_head(FILE * out, report_data const * data);
+static void html_stats(FILE * out, report_data const * data);
+static void html_scaling(FILE * out, report_data const * data);
+static void html_memory(FILE * out, report_data const * data);
+static size_t add_point(report_series ** series, size_t * series_c, char const * name, double x_, double y_);
+static void free_series(report_series * series, size_t series_c);
+static chart_axis make_axis(double lo, double hi);
+static double axis_pos(chart_axis const * axis, double value, double from, double to);
+static size_t axis_ticks(chart_axis const * axis, double ticks[], size_t ticks_l);
+static char * format_value(double value, char * buffp, size_t buff_len);
+static void svg_line_chart(FILE * out, char const * title, char const * x_label, char const * y_label,
+                           report_series const * series, size_t series_c);
+static void svg_bar_chart(FILE * out, char const * title, char const * value_label,
+                          char const * const rows[], size_t rows_c, char const * const groups[], size_t groups_c,
+                          double const values[]);
+
+//  MARK: - Implementation
+/*
+ *  MARK: report_write()
+ *
+ *  Read the --stats and --memprof files csv_paths[] and write the report to html_path.
+ *  Returns false, having reported why, if a file cannot be read or the page cannot be written.
+ */
+bool report_write(char const * html_path, char const * const csv_paths[], size_t csv_c) {
+
+  report_data data = { csv_paths, csv_c, NULL, 0, NULL, 0, };
+  bool ok = true;
+
+  for (size_t f_ = 0; ok && f_ < csv_c; ++f_) {
+    ok = load_csv(&data, f_);
+  }
+
+  if (ok) {
+    FILE * out = fopen(html_path, "w");
+    if (out == NULL) {
+      perror(html_path);
+      ok = false;
+    }
+    else {
+      html_head(out, &data);
+      html_stats(out, &data);
+      html_scaling(out, &data);
+      html_memory(out, &data);
+      fprintf(out, "</body>\n</html>\n");
+      ok = ferror(out) == 0;
+      ok = fclose(out) == 0 && ok;
+      if (!ok) {
+        perror(html_path);
+      }
+      else {
+        printf("Report: %s (%zu stats records, %zu memory records)\n", html_path, data.stats_c, data.mem_c);
+      }
+    }
+  }
+
+  free(data.stats);
+  free(data.mem);
+
+  return ok;
+}
+
+//  MARK: - Input
+/*
+ *  MARK: load_csv()
+ *
+ *  Append the records of file "file" to data.
+ */
+static bool load_csv(report_data * data, size_t file) {
+
+  char const * path = data->paths[file];
+  FILE * in = fopen(path, "r");
+  char header[REPORT_LINE_MAX];
+  char line[REPORT_LINE_MAX];
+  char * names[REPORT_FIELDS_MAX];
+  char * fields[REPORT_FIELDS_MAX];
+  size_t names_c;
+  bool is_stats;
+  bool ok = true;
+
+  if (in == NULL) {
+    perror(path);
+    return false;
+  }
+  if (fgets(header, sizeof(header), in) == NULL) {
+    fprintf(stderr, "%s: empty file\n", path);
+    fclose(in);
+    return false;
+  }
+  names_c = split_csv(header, names, REPORT_FIELDS_MAX);
+  is_stats = find_column(names, names_c, "wall_ns") >= 0;
+  if (find_column(names, names_c, "engine") != 0
+      || (!is_stats && find_column(names, names_c, "peak_live") < 0)) {
+    fprintf(stderr, "%s: not a --stats or --memprof file\n", path);
+    fclose(in);
+    return false;
+  }
+
+  int col_engine = 0;
+  int col_nbegin = find_column(names, names_c, "nbegin");
+  int col_nend = find_column(names, names_c, "nend");
+  int col_wall = find_column(names, names_c, "wall_ns");
+  int col_workers = find_column(names, names_c, "workers");
+  int col_counter[REPORT_COUNTER_COUNT];
+  for (size_t c_ = 0; c_ < REPORT_COUNTER_COUNT; ++c_) {
+    col_counter[c_] = find_column(names, names_c, counter_names[c_]);
+  }
+  int col_n = find_column(names, names_c, "n");
+  int col_allocs = find_column(names, names_c, "allocs");
+  int col_bytes = find_column(names, names_c, "bytes");
+  int col_peak_live = find_column(names, names_c, "peak_live");
+  int col_peak_rss = find_column(names, names_c, "peak_rss");
+
+  while (ok && fgets(line, sizeof(line), in) != NULL) {
+    size_t fields_c = split_csv(line, fields, REPORT_FIELDS_MAX);
+    if (fields_c < names_c || fields[0][0] == '\0') {
+      continue;
+    }
+
+    if (is_stats) {
+      report_stats * grown = realloc(data->stats, (data->stats_c + 1) * sizeof(*data->stats));
+      ok = grown != NULL;
+      if (ok) {
+        report_stats * rec = &grown[data->stats_c++];
+        data->stats = grown;
+        memset(rec, 0, sizeof(*rec));
+        snprintf(rec->engine, sizeof(rec->engine), "%s", fields[col_engine]);
+        rec->file = file;
+        rec->nbegin = col_nbegin >= 0 ? strtoull(fields[col_nbegin], NULL, 10) : 0;
+        rec->nend = col_nend >= 0 ? strtoull(fields[col_nend], NULL, 10) : 0;
+        rec->wall_ns = strtoull(fields[col_wall], NULL, 10);
+        rec->workers = col_workers >= 0 ? (unsigned) strtoul(fields[col_workers], NULL, 10) : 1;
+        for (size_t c_ = 0; c_ < REPORT_COUNTER_COUNT; ++c_) {
+          rec->valid[c_] = col_counter[c_] >= 0 && fields[col_counter[c_]][0] != '\0';
+          rec->counter[c_] = rec->valid[c_] ? strtoull(fields[col_counter[c_]], NULL, 10) : 0;
+        }
+      }
+    }
+    else if (col_n >= 0 && col_allocs >= 0 && col_bytes >= 0 && col_peak_rss >= 0) {
+      report_mem * grown = realloc(data->mem, (data->mem_c + 1) * sizeof(*data->mem));
+      ok = grown != NULL;
+      if (ok) {
+        report_mem * rec = &grown[data->mem_c++];
+        data->mem = grown;
+        snprintf(rec->engine, sizeof(rec->engine), "%s", fields[col_engine]);
+        rec->file = file;
+        rec->n = strtoull(fields[col_n], NULL, 10);
+        rec->allocs = strtoull(fields[col_allocs], NULL, 10);
+        rec->bytes = strtoull(fields[col_bytes], NULL, 10);
+        rec->peak_live = strtoll(fields[col_peak_live], NULL, 10);
+        rec->peak_rss = strtoull(fields[col_peak_rss], NULL, 10);
+      }
+    }
+  }
+  if (!ok) {
+    fprintf(stderr, "%s: out of memory\n", path);
+  }
+  fclose(in);
+
+  return ok;
+}
+
+/*
+ *  MARK: split_csv()
+ *
+ *  Split "line" in place at commas, dropping the line end. Returns the field count.
+ */
+static size_t split_csv(char * line, char * fields[], size_t fields_l) {
+
+  size_t fields_c = 0;
+
+  line[strcspn(line, "\r\n")] = '\0';
+  fields[fields_c++] = line;
+  for (char * next = strchr(line, ','); next != NULL && fields_c < fields_l; next = strchr(next, ',')) {
+    *next++ = '\0';
+    fields[fields_c++] = next;
+  }
+
+  return fields_c;
+}
+
+/*
+ *  MARK: find_column()
+ */
+static int find_column(char * const names[], size_t names_c, char const * name) {
+
+  for (size_t c_ = 0; c_ < names_c; ++c_) {
+    if (strcmp(names[c_], name) == 0) {
+      return (int) c_;
+    }
+  }
+
+  return -1;
+}
+
+/*
+ *  MARK: file_label()
+ */
+static char const * file_label(char const * path) {
+
+  char const * slash = strrchr(path, '/');
+
+  return slash != NULL ? slash + 1 : path;
+}
+
+//  MARK: - Page
+/*
+ *  MARK: html_text()
+ *
+ *  Write text with the HTML special characters escaped.
+ */
+static void html_text(FILE * out, char const * text) {
+
+  for (char const * ch = text; *ch != '\0'; ++ch) {
+    switch (*ch) {
+      case '&':
+        fputs("&amp;", out);
+        break;
+
+      case '<':
+        fputs("&lt;", out);
+        break;
+
+      case '>':
+        fputs("&gt;", out);
+        break;
+
+      case '"':
+        fputs("&quot;", out);
+        break;
+
+      default:
+        fputc(*ch, out);
+        break;
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: html_head()
+ */
+static void html_head(FILE * out, report_data const * data) {
+
+  char stamp[64];
+  time_t now = time(NULL);
+  struct utsname host;
+
+  strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S %Z", localtime(&now));
+  if (uname(&host) != 0) {
+    memset(&host, 0, sizeof(host));
+  }
+
+  fprintf(out,
+          "<!DOCTYPE html>\n"
+          "<html>\n"
+          "<head>\n"
+          "  <meta charset=\"utf-8\" />\n"
+          "  <title>Factorial Engine Performance Report</title>\n"
+          "  <style>\n"
+          "  body { font-family: \"Helvetica Neue\", Helvetica, Arial, sans-serif; font-size: 0.95em; margin: 1.5em; }\n"
+          "  table { border-collapse: collapse; margin-bottom: 1.5em; }\n"
+          "  th, td { border: 1px solid #999; padding: 0.25em 0.5em; }\n"
+          "  th { background: #eee; }\n"
+          "  td.num { text-align: right; font-family: Menlo, Consolas, \"DejaVu Sans Mono\", monospace; }\n"
+          "  svg { display: block; margin-bottom: 1.5em; }\n"
+          "  svg text { font-family: \"Helvetica Neue\", Helvetica, Arial, sans-serif; font-size: 11px; }\n"
+          "  .note { color: #666; }\n"
+          "  </style>\n"
+          "</head>\n"
+          "<body>\n"
+          "  <h1>Factorial Engine Performance Report</h1>\n"
+          "  <p>Generated %s on ", stamp);
+  html_text(out, host.nodename);
+  fputs(" (", out);
+  html_text(out, host.sysname);
+  fputc(' ', out);
+  html_text(out, host.machine);
+  fputs(").</p>\n  <table>\n    <tr><th>#</th><th>Input</th></tr>\n", out);
+  for (size_t f_ = 0; f_ < data->files_c; ++f_) {
+    fprintf(out, "    <tr><td class=\"num\">%zu</td><td>", f_ + 1);
+    html_text(out, data->paths[f_]);
+    fputs("</td></tr>\n", out);
+  }
+  fputs("  </table>\n", out);
+
+  return;
+}
+
+/*
+ *  MARK: html_stats()
+ *
+ *  Wall time of each engine in each input as a grouped bar chart, then every
+ *  record with its counters.
+ */
+static void html_stats(FILE * out, report_data const * data) {
+
+  fputs("  <h2>Engine Statistics</h2>\n", out);
+  if (data->stats_c == 0) {
+    fputs("  <p class=\"note\">No --stats input.</p>\n", out);
+    return;
+  }
+
+  char const ** engines = calloc(data->stats_c, sizeof(*engines));
+  char const ** groups = calloc(data->files_c, sizeof(*groups));
+  double * values = malloc(data->stats_c * data->files_c * sizeof(*values));
+  size_t engines_c = 0;
+
+  if (engines != NULL && groups != NULL && values != NULL) {
+    for (size_t f_ = 0; f_ < data->files_c; ++f_) {
+      groups[f_] = file_label(data->paths[f_]);
+    }
+    for (size_t v_ = 0; v_ < data->stats_c * data->files_c; ++v_) {
+      values[v_] = -1.0;
+    }
+    for (size_t r_ = 0; r_ < data->stats_c; ++r_) {
+      report_stats const * rec = &data->stats[r_];
+      size_t e_ = 0;
+      while (e_ < engines_c && strcmp(engines[e_], rec->engine) != 0) {
+        ++e_;
+      }
+      if (e_ == engines_c) {
+        engines[engines_c++] = rec->engine;
+      }
+      values[e_ * data->files_c + rec->file] = (double) rec->wall_ns / 1.0e6;
+    }
+    svg_bar_chart(out, "Wall time by engine", "wall time (ms)", engines, engines_c, groups, data->files_c, values);
+  }
+  free(engines);
+  free(groups);
+  free(values);
+
+  fputs("  <table>\n    <tr><th>#</th><th>engine</th><th>n</th><th>workers</th><th>wall ms</th>", out);
+  for (size_t c_ = 0; c_ < REPORT_COUNTER_COUNT; ++c_) {
+    fprintf(out, "<th>%s</th>", counter_names[c_]);
+    if (c_ == REPORT_INSTRUCTIONS) {
+      fputs("<th>IPC</th>", out);
+    }
+  }
+  fputs("</tr>\n", out);
+  for (size_t r_ = 0; r_ < data->stats_c; ++r_) {
+    report_stats const * rec = &data->stats[r_];
+
+    fprintf(out, "    <tr><td class=\"num\">%zu</td><td>", rec->file + 1);
+    html_text(out, rec->engine);
+    fprintf(out, "</td><td class=\"num\">%" PRIu64 " &ndash; %" PRIu64 "</td><td class=\"num\">%u</td>"
+                 "<td class=\"num\">%.3f</td>",
+            rec->nbegin, rec->nend, rec->workers, (double) rec->wall_ns / 1.0e6);
+    for (size_t c_ = 0; c_ < REPORT_COUNTER_COUNT; ++c_) {
+      if (rec->valid[c_]) {
+        fprintf(out, "<td class=\"num\">%" PRIu64 "</td>", rec->counter[c_]);
+      }
+      else {
+        fputs("<td class=\"num\">-</td>", out);
+      }
+      if (c_ == REPORT_INSTRUCTIONS) {
+        if (rec->valid[REPORT_CYCLES] && rec->valid[REPORT_INSTRUCTIONS] && rec->counter[REPORT_CYCLES] != 0) {
+          fprintf(out, "<td class=\"num\">%.3f</td>",
+                  (double) rec->counter[REPORT_INSTRUCTIONS] / (double) rec->counter[REPORT_CYCLES]);
+        }
+        else {
+          fputs("<td class=\"num\">-</td>", out);
+        }
+      }
+    }
+    fputs("</tr>\n", out);
+  }
+  fputs("  </table>\n", out);
+
+  return;
+}
+
+/*
+ *  MARK: html_scaling()
+ *
+ *  Wall time against n for each engine measured at more than one n, and against
+ *  the worker count for each engine and n measured with more than one.
+ */
+static void html_scaling(FILE * out, report_data const * data) {
+
+  report_series * by_n = NULL;
+  size_t by_n_c = 0;
+  report_series * by_workers = NULL;
+  size_t by_workers_c = 0;
+  size_t kept_c = 0;
+
+  fputs("  <h2>Scaling</h2>\n", out);
+  for (size_t r_ = 0; r_ < data->stats_c; ++r_) {
+    report_stats const * rec = &data->stats[r_];
+    char name[2 * REPORT_NAME_MAX];
+    double wall_ms = (double) rec->wall_ns / 1.0e6;
+
+    if (rec->workers == 1) {
+      add_point(&by_n, &by_n_c, rec->engine, (double) rec->nend, wall_ms);
+    }
+    snprintf(name, sizeof(name), "%s %" PRIu64 "!", rec->engine, rec->nend);
+    add_point(&by_workers, &by_workers_c, name, (double) rec->workers, wall_ms);
+  }
+
+  for (size_t s_ = 0; s_ < by_n_c; ++s_) {
+    if (by_n[s_].points_c > 1) {
+      by_n[kept_c++] = by_n[s_];
+    }
+    else {
+      free_series(&by_n[s_], 1);
+    }
+  }
+  by_n_c = kept_c;
+  if (by_n_c > 0) {
+    svg_line_chart(out, "Wall time by n (one worker)", "n", "wall time (ms)", by_n, by_n_c);
+  }
+  else {
+    fputs("  <p class=\"note\">Each engine was measured at a single n: run the engines over several ranges "
+          "with --stats=file.csv and give all the files to --report to chart the scaling with n.</p>\n", out);
+  }
+
+  kept_c = 0;
+  for (size_t s_ = 0; s_ < by_workers_c; ++s_) {
+    if (by_workers[s_].points_c > 1) {
+      by_workers[kept_c++] = by_workers[s_];
+    }
+    else {
+      free_series(&by_workers[s_], 1);
+    }
+  }
+  by_workers_c = kept_c;
+  if (by_workers_c > 0) {
+    svg_line_chart(out, "Wall time by workers", "worker processes or threads", "wall time (ms)",
+                   by_workers, by_workers_c);
+  }
+  else {
+    fputs("  <p class=\"note\">No engine was measured with more than one worker count "
+          "(see --procs).</p>\n", out);
+  }
+
+  free_series(by_n, by_n_c);
+  free(by_n);
+  free_series(by_workers, by_workers_c);
+  free(by_workers);
+
+  return;
+}
+
+/*
+ *  MARK: html_memory()
+ *
+ *  Peak live bytes against n for each engine, then a summary per engine and input.
+ */
+static void html_memory(FILE * out, report_data const * data) {
+
+  report_series * by_n = NULL;
+  size_t by_n_c = 0;
+  size_t mem_files_c = 0;
+  bool * mem_file = calloc(data->files_c + 1, sizeof(*mem_file));
+
+  fputs("  <h2>Memory Footprint</h2>\n", out);
+  if (data->mem_c == 0 || mem_file == NULL) {
+    fputs("  <p class=\"note\">No --memprof input.</p>\n", out);
+    free(mem_file);
+    return;
+  }
+
+  for (size_t r_ = 0; r_ < data->mem_c; ++r_) {
+    if (!mem_file[data->mem[r_].file]) {
+      mem_file[data->mem[r_].file] = true;
+      ++mem_files_c;
+    }
+  }
+  for (size_t r_ = 0; r_ < data->mem_c; ++r_) {
+    report_mem const * rec = &data->mem[r_];
+    char name[2 * REPORT_NAME_MAX];
+
+    if (mem_files_c > 1) {
+      snprintf(name, sizeof(name), "%s #%zu", rec->engine, rec->file + 1);
+    }
+    else {
+      snprintf(name, sizeof(name), "%s", rec->engine);
+    }
+    add_point(&by_n, &by_n_c, name, (double) rec->n, rec->peak_live > 0 ? (double) rec->peak_live : 0.0);
+  }
+  svg_line_chart(out, "Peak live bytes by n", "n", "peak live bytes", by_n, by_n_c);
+
+  fputs("  <table>\n    <tr><th>#</th><th>engine</th><th>rows</th><th>allocations</th><th>bytes allocated</th>"
+        "<th>max peak live</th><th>peak RSS</th></tr>\n", out);
+  for (size_t r_ = 0; r_ < data->mem_c; ++r_) {
+    report_mem const * first = &data->mem[r_];
+    uint64_t rows = 0;
+    uint64_t allocs = 0;
+    uint64_t bytes = 0;
+    int64_t peak_live = 0;
+    uint64_t peak_rss = 0;
+    bool seen = false;
+
+    for (size_t p_ = 0; p_ < r_ && !seen; ++p_) {
+      seen = data->mem[p_].file == first->file && strcmp(data->mem[p_].engine, first->engine) == 0;
+    }
+    if (seen) {
+      continue;
+    }
+    for (size_t q_ = r_; q_ < data->mem_c; ++q_) {
+      report_mem const * rec = &data->mem[q_];
+      if (rec->file == first->file && strcmp(rec->engine, first->engine) == 0) {
+        ++rows;
+        allocs += rec->allocs;
+        bytes += rec->bytes;
+        peak_live = rec->peak_live > peak_live ? rec->peak_live : peak_live;
+        peak_rss = rec->peak_rss > peak_rss ? rec->peak_rss : peak_rss;
+      }
+    }
+    fprintf(out, "    <tr><td class=\"num\">%zu</td><td>", first->file + 1);
+    html_text(out, first->engine);
+    fprintf(out, "</td><td class=\"num\">%" PRIu64 "</td><td class=\"num\">%" PRIu64 "</td>"
+                 "<td class=\"num\">%" PRIu64 "</td><td class=\"num\">%" PRId64 "</td><td class=\"num\">%" PRIu64 "</td></tr>\n",
+            rows, allocs, bytes, peak_live, peak_rss);
+  }
+  fputs("  </table>\n", out);
+
+  free_series(by_n, by_n_c);
+  free(by_n);
+  free(mem_file);
+
+  return;
+}
+
+//  MARK: - Series
+/*
+ *  MARK: add_point()
+ *
+ *  Add (x_, y_) to the series called "name", starting it if need be, keeping the
+ *  points in order of x. Returns the series index, or series_c if out of memory.
+ */
+static size_t add_point(report_series ** series, size_t * series_c, char const * name, double x_, double y_) {
+
+  size_t s_ = 0;
+
+  while (s_ < *series_c && strcmp((*series)[s_].name, name) != 0) {
+    ++s_;
+  }
+  if (s_ == *series_c) {
+    report_series * grown = realloc(*series, (*series_c + 1) * sizeof(**series));
+    if (grown == NULL) {
+      return *series_c;
+    }
+    *series = grown;
+    memset(&grown[s_], 0, sizeof(grown[s_]));
+    snprintf(grown[s_].name, sizeof(grown[s_].name), "%s", name);
+    ++*series_c;
+  }
+
+  report_series * line = &(*series)[s_];
+  double * grown_x = realloc(line->x, (line->points_c + 1) * sizeof(*line->x));
+  if (grown_x == NULL) {
+    return *series_c;
+  }
+  line->x = grown_x;
+  double * grown_y = realloc(line->y, (line->points_c + 1) * sizeof(*line->y));
+  if (grown_y == NULL) {
+    return *series_c;
+  }
+  line->y = grown_y;
+
+  size_t p_ = line->points_c++;
+  while (p_ > 0 && line->x[p_ - 1] > x_) {
+    line->x[p_] = line->x[p_ - 1];
+    line->y[p_] = line->y[p_ - 1];
+    --p_;
+  }
+  line->x[p_] = x_;
+  line->y[p_] = y_;
+
+  return s_;
+}
+
+/*
+ *  MARK: free_series()
+ */
+static void free_series(report_series * series, size_t series_c) {
+
+  for (size_t s_ = 0; s_ < series_c; ++s_) {
+    free(series[s_].x);
+    free(series[s_].y);
+    series[s_].x = NULL;
+    series[s_].y = NULL;
+    series[s_].points_c = 0;
+  }
+
+  return;
+}
+
+//  MARK: - Charts
+/*
+ *  MARK: make_axis()
+ *
+ *  A logarithmic axis when the positive values span two decades or more,
+ *  otherwise a linear axis from 0.
+ */
+static chart_axis make_axis(double lo, double hi) {
+
+  chart_axis axis;
+
+  axis.log_scale = lo > 0.0 && hi / lo >= 100.0;
+  if (axis.log_scale) {
+    axis.lo = pow(10.0, floor(log10(lo)));
+    axis.hi = pow(10.0, ceil(log10(hi)));
+  }
+  else {
+    axis.lo = 0.0;
+    axis.hi = hi > 0.0 ? hi * 1.05 : 1.0;
+  }
+
+  return axis;
+}
+
+/*
+ *  MARK: axis_pos()
+ *
+ *  Map value onto the pixel range from .. to.
+ */
+static double axis_pos(chart_axis const * axis, double value, double from, double to) {
+
+  double frac;
+
+  if (axis->log_scale) {
+    value = value > axis->lo ? value : axis->lo;
+    frac = (log10(value) - log10(axis->lo)) / (log10(axis->hi) - log10(axis->lo));
+  }
+  else {
+    frac = (value - axis->lo) / (axis->hi - axis->lo);
+  }
+
+  return from + frac * (to - from);
+}
+
+/*
+ *  MARK: axis_ticks()
+ *
+ *  Decades on a logarithmic axis, steps of 1, 2 or 5 times a power of ten on a linear one.
+ */
+static size_t axis_ticks(chart_axis const * axis, double ticks[], size_t ticks_l) {
+
+  size_t ticks_c = 0;
+
+  if (axis->log_scale) {
+    for (double tick = axis->lo; tick <= axis->hi * 1.0001 && ticks_c < ticks_l; tick *= 10.0) {
+      ticks[ticks_c++] = tick;
+    }
+  }
+  else {
+    double raw = (axis->hi - axis->lo) / 5.0;
+    double decade = pow(10.0, floor(log10(raw)));
+    double step = raw / decade < 2.0 ? 2.0 * decade : raw / decade < 5.0 ? 5.0 * decade : 10.0 * decade;
+    for (double tick = axis->lo; tick <= axis->hi && ticks_c < ticks_l; tick += step) {
+      ticks[ticks_c++] = tick;
+    }
+  }
+
+  return ticks_c;
+}
+
+/*
+ *  MARK: format_value()
+ *
+ *  Short tick label: 950, 1.5k, 20M, 3G.
+ */
+static char * format_value(double value, char * buffp, size_t buff_len) {
+
+  static char const * const suffixes[] = { "", "k", "M", "G", "T", "P", };
+  size_t s_ = 0;
+
+  while (fabs(value) >= 1000.0 && s_ + 1 < sizeof(suffixes) / sizeof(*suffixes)) {
+    value /= 1000.0;
+    ++s_;
+  }
+  snprintf(buffp, buff_len, "%.3g%s", value, suffixes[s_]);
+
+  return buffp;
+}
+
+/*
+ *  MARK: svg_line_chart()
+ */
+static void svg_line_chart(FILE * out, char const * title, char const * x_label, char const * y_label,
+                           report_series const * series, size_t series_c) {
+
+  double x_lo = INFINITY, x_hi = 0.0, y_lo = INFINITY, y_hi = 0.0;
+  double const left = CHART_LEFT, right = CHART_WIDTH - CHART_RIGHT;
+  double const top = CHART_TOP, bottom = CHART_HEIGHT - CHART_BOTTOM;
+  double ticks[32];
+  char label[32];
+
+  for (size_t s_ = 0; s_ < series_c; ++s_) {
+    for (size_t p_ = 0; p_ < series[s_].points_c; ++p_) {
+      double x_ = series[s_].x[p_];
+      double y_ = series[s_].y[p_];
+      x_lo = x_ > 0.0 && x_ < x_lo ? x_ : x_lo;
+      x_hi = x_ > x_hi ? x_ : x_hi;
+      y_lo = y_ > 0.0 && y_ < y_lo ? y_ : y_lo;
+      y_hi = y_ > y_hi ? y_ : y_hi;
+    }
+  }
+  chart_axis x_axis = make_axis(x_lo, x_hi);
+  chart_axis y_axis = make_axis(y_lo, y_hi);
+
+  fprintf(out, "  <svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\">\n",
+          CHART_WIDTH, CHART_HEIGHT, CHART_WIDTH, CHART_HEIGHT);
+  fprintf(out, "    <text x=\"%g\" y=\"20\" font-weight=\"bold\">", left);
+  html_text(out, title);
+  fputs("</text>\n", out);
+
+  size_t ticks_c = axis_ticks(&x_axis, ticks, sizeof(ticks) / sizeof(*ticks));
+  for (size_t t_ = 0; t_ < ticks_c; ++t_) {
+    double px = axis_pos(&x_axis, ticks[t_], left, right);
+    fprintf(out, "    <line x1=\"%.1f\" y1=\"%g\" x2=\"%.1f\" y2=\"%g\" stroke=\"#ddd\" />\n", px, top, px, bottom);
+    fprintf(out, "    <text x=\"%.1f\" y=\"%g\" text-anchor=\"middle\">%s</text>\n",
+            px, bottom + 16, format_value(ticks[t_], label, sizeof(label)));
+  }
+  ticks_c = axis_ticks(&y_axis, ticks, sizeof(ticks) / sizeof(*ticks));
+  for (size_t t_ = 0; t_ < ticks_c; ++t_) {
+    double py = axis_pos(&y_axis, ticks[t_], bottom, top);
+    fprintf(out, "    <line x1=\"%g\" y1=\"%.1f\" x2=\"%g\" y2=\"%.1f\" stroke=\"#ddd\" />\n", left, py, right, py);
+    fprintf(out, "    <text x=\"%g\" y=\"%.1f\" text-anchor=\"end\">%s</text>\n",
+            left - 6, py + 4, format_value(ticks[t_], label, sizeof(label)));
+  }
+  fprintf(out, "    <rect x=\"%g\" y=\"%g\" width=\"%g\" height=\"%g\" fill=\"none\" stroke=\"#333\" />\n",
+          left, top, right - left, bottom - top);
+  fprintf(out, "    <text x=\"%g\" y=\"%d\" text-anchor=\"middle\">", (left + right) / 2, CHART_HEIGHT - 12);
+  html_text(out, x_label);
+  fprintf(out, "%s</text>\n", x_axis.log_scale ? " (log scale)" : "");
+  fprintf(out, "    <text transform=\"translate(16 %g) rotate(-90)\" text-anchor=\"middle\">", (top + bottom) / 2);
+  html_text(out, y_label);
+  fprintf(out, "%s</text>\n", y_axis.log_scale ? " (log scale)" : "");
+
+  for (size_t s_ = 0; s_ < series_c; ++s_) {
+    char const * colour = palette[s_ % palette_c];
+    fprintf(out, "    <polyline fill=\"none\" stroke=\"%s\" stroke-width=\"2\" points=\"", colour);
+    for (size_t p_ = 0; p_ < series[s_].points_c; ++p_) {
+      fprintf(out, "%s%.1f,%.1f", p_ == 0 ? "" : " ",
+              axis_pos(&x_axis, series[s_].x[p_], left, right), axis_pos(&y_axis, series[s_].y[p_], bottom, top));
+    }
+    fputs("\" />\n", out);
+    for (size_t p_ = 0; p_ < series[s_].points_c; ++p_) {
+      fprintf(out, "    <circle cx=\"%.1f\" cy=\"%.1f\" r=\"3\" fill=\"%s\"><title>",
+              axis_pos(&x_axis, series[s_].x[p_], left, right), axis_pos(&y_axis, series[s_].y[p_], bottom, top), colour);
+      html_text(out, series[s_].name);
+      fprintf(out, ": %g, %g</title></circle>\n", series[s_].x[p_], series[s_].y[p_]);
+    }
+    fprintf(out, "    <rect x=\"%g\" y=\"%g\" width=\"10\" height=\"10\" fill=\"%s\" />\n",
+            right + 12, top + 16.0 * (double) s_, colour);
+    fprintf(out, "    <text x=\"%g\" y=\"%g\">", right + 26, top + 16.0 * (double) s_ + 9);
+    html_text(out, series[s_].name);
+    fputs("</text>\n", out);
+  }
+  fputs("  </svg>\n", out);
+
+  return;
+}
+
+/*
+ *  MARK: svg_bar_chart()
+ *
+ *  Horizontal bars, one group of groups_c bars per row. values[row * groups_c + group]
+ *  is negative where there is no value.
+ */
+static void svg_bar_chart(FILE * out, char const * title, char const * value_label,
+                          char const * const rows[], size_t rows_c, char const * const groups[], size_t groups_c,
+                          double const values[]) {
+
+  double const left = 180, right = CHART_WIDTH - CHART_RIGHT, top = CHART_TOP;
+  double const row_height = BAR_HEIGHT * (double) groups_c + 8;
+  double const bottom = top + row_height * (double) rows_c;
+  int const height = (int) bottom + CHART_BOTTOM;
+  double hi = 0.0;
+  double ticks[32];
+  char label[32];
+
+  for (size_t v_ = 0; v_ < rows_c * groups_c; ++v_) {
+    hi = values[v_] > hi ? values[v_] : hi;
+  }
+  chart_axis axis = make_axis(0.0, hi);
+
+  fprintf(out, "  <svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\">\n",
+          CHART_WIDTH, height, CHART_WIDTH, height);
+  fprintf(out, "    <text x=\"%g\" y=\"20\" font-weight=\"bold\">", left);
+  html_text(out, title);
+  fputs("</text>\n", out);
+
+  size_t ticks_c = axis_ticks(&axis, ticks, sizeof(ticks) / sizeof(*ticks));
+  for (size_t t_ = 0; t_ < ticks_c; ++t_) {
+    double px = axis_pos(&axis, ticks[t_], left, right);
+    fprintf(out, "    <line x1=\"%.1f\" y1=\"%g\" x2=\"%.1f\" y2=\"%g\" stroke=\"#ddd\" />\n", px, top, px, bottom);
+    fprintf(out, "    <text x=\"%.1f\" y=\"%g\" text-anchor=\"middle\">%s</text>\n",
+            px, bottom + 16, format_value(ticks[t_], label, sizeof(label)));
+  }
+  fprintf(out, "    <text x=\"%g\" y=\"%d\" text-anchor=\"middle\">", (left + right) / 2, height - 12);
+  html_text(out, value_label);
+  fputs("</text>\n", out);
+
+  for (size_t r_ = 0; r_ < rows_c; ++r_) {
+    double row_top = top + row_height * (double) r_;
+    fprintf(out, "    <text x=\"%g\" y=\"%.1f\" text-anchor=\"end\">", left - 6, row_top + row_height / 2 + 4);
+    html_text(out, rows[r_]);
+    fputs("</text>\n", out);
+    for (size_t g_ = 0; g_ < groups_c; ++g_) {
+      double value = values[r_ * groups_c + g_];
+      if (value < 0.0) {
+        continue;
+      }
+      double bar_top = row_top + 4 + BAR_HEIGHT * (double) g_;
+      double width = axis_pos(&axis, value, left, right) - left;
+      fprintf(out, "    <rect x=\"%g\" y=\"%.1f\" width=\"%.1f\" height=\"%d\" fill=\"%s\"><title>",
+              left, bar_top, width > 0.5 ? width : 0.5, BAR_HEIGHT - 2, palette[g_ % palette_c]);
+      html_text(out, groups[g_]);
+      fprintf(out, ": %.3f</title></rect>\n", value);
+      fprintf(out, "    <text x=\"%.1f\" y=\"%.1f\">%.3f</text>\n", left + width + 4, bar_top + BAR_HEIGHT - 5, value);
+    }
+  }
+  fprintf(out, "    <line x1=\"%g\" y1=\"%g\" x2=\"%g\" y2=\"%g\" stroke=\"#333\" />\n", left, top, left, bottom);
+
+  for (size_t g_ = 0; g_ < groups_c; ++g_) {
+    fprintf(out, "    <rect x=\"%g\" y=\"%g\" width=\"10\" height=\"10\" fill=\"%s\" />\n",
+            right + 60, top + 16.0 * (double) g_, palette[g_ % palette_c]);
+    fprintf(out, "    <text x=\"%g\" y=\"%g\">%zu ", right + 74, top + 16.0 * (double) g_ + 9, g_ + 1);
+    html_text(out, groups[g_]);
+    fputs("</text>\n", out);
+  }
+  fputs("  </svg>\n", out);
+
+  return;
+}
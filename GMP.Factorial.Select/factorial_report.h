@@ -0,0 +1,35 @@
+//
+//  factorial_report.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Performance report.
+//  report_write() reads the comma separated values written by --stats=file.csv and
+//  --memprof=file.csv and renders them as one self-contained HTML page: tables,
+//  and charts drawn as inline SVG, with no scripts and nothing fetched from the network.
+//
+
+#pragma once
+#ifndef factorial_report_h
+#define factorial_report_h
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+#define REPORT_DEFAULT_PATH "web/factorial_report.html"
+
+//  MARK: - Prototypes
+bool report_write(char const * html_path, char const * const csv_paths[], size_t csv_c);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_report_h */
@@ -7,6 +7,7 @@
 //  @see: https://gmplib.org/manual/index.html#Top
 //  @see: https://github.com/opencv/opencv/issues/15645
 //  @see: https://gcc.gnu.org/onlinedocs/gcc/Integer-Overflow-Builtins.html
+//  @see: https://man7.org/linux/man-pages/man3/getopt.3.html
 //
 //  Created by Alan Sampson on 1/27/20.
 //  Copyright © 2020 Alan @ FreeShell. All rights reserved.
@@ -26,9 +27,33 @@
 #include <inttypes.h>
 #include <string.h>
 #include <float.h>
+#include <getopt.h>
+#include <unistd.h>
 #include <gmp.h>
 
 #include "gfg-factorial.hpp"
+#include "factorial_stats.h"
+#include "factorial_memprof.h"
+#include "factorial_gmp.h"
+#include "factorial_calibrate.h"
+#include "factorial_stream.h"
+#include "factorial_procs.h"
+#include "factorial_checkpoint.h"
+#include "factorial_async.hpp"
+#include "factorial_fixed.hpp"
+#include "factorial_report.h"
+#include "factorial_modtable.h"
+#include "factorial_gamma.h"
+#include "factorial_digest.h"
+#include "factorial_ooc.h"
+#include "factorial_rangetree.h"
+#include "factorial_digits.h"
+#include "factorial_leading.h"
+#include "factorial_pipeline.h"
+#include "factorial_verify.h"
+#include "factorial_archive.h"
+#include "factorial_batch.h"
+#include "factorial_fused.h"
 
 //  TODO: Check availability of 128-bit integers
 #ifndef __SIZEOF_INT128__
@@ -51,6 +76,22 @@ union biggar {
 };
 typedef union biggar biggar;
 
+//  Largest factorials held exactly by the fixed width engines used by --engine auto.
+#define U64_EXACT_MAX   20
+#define U128_EXACT_MAX  34
+
+//  stdio buffer size for --output files.
+#define OUTPUT_BUFFER   (1 << 20)
+
+//  MARK: struct driver
+//  An entry in the engine registry. "standard" drivers make up the default run.
+struct driver {
+  char const * name;
+  void (* run)(uint64_t nbegin, uint64_t nend);
+  bool standard;
+};
+typedef struct driver driver;
+
 // MARK: - Prototypes -
 //  MARK: Inline Function Localization
 // This needs to be before the inclusion of version_info.h
@@ -68,31 +109,106 @@ void factorial_s64(uint64_t nbegin, uint64_t nend);
 void factorial_u128(uint64_t nbegin, uint64_t nend);
 void factorial_s128(uint64_t nbegin, uint64_t nend);
 void factorial_gmp(uint64_t nbegin, uint64_t nend);
+void factorial_gmp_incremental(uint64_t nbegin, uint64_t nend);
+void factorial_gmp_pipeline(uint64_t nbegin, uint64_t nend);
+void factorial_gmp_tree(uint64_t nbegin, uint64_t nend);
+void factorial_gmp_odd(uint64_t nbegin, uint64_t nend);
+void factorial_gmp_odd_tree(uint64_t nbegin, uint64_t nend);
+void factorial_gfg_stripped(uint64_t nbegin, uint64_t nend);
+void factorial_gmp_swing(uint64_t nbegin, uint64_t nend);
+void factorial_gmp_procs(uint64_t nbegin, uint64_t nend);
+void factorial_auto(uint64_t nbegin, uint64_t nend);
+void factorial_leading(uint64_t nbegin, uint64_t nend);
 void factorial_gfg(uint64_t nbegin, uint64_t nend);
+bool factorial_gfg_check(uint64_t nbegin, uint64_t nend);
+bool factorial_output(char const * path, bool use_gfg, uint64_t nbegin, uint64_t nend);
+bool factorial_digest(uint64_t nbegin, uint64_t nend, bool use_gfg, unsigned fields);
+bool factorial_mod_table(uint64_t nbegin, uint64_t nend, uint64_t const primes[], unsigned primes_c, char const * path);
+bool factorial_range_ratio(uint64_t nbegin, uint64_t nend, uint64_t mval, char const * path);
+bool factorial_digit_windows(uint64_t nbegin, uint64_t nend, bool low, uint64_t low_pos, uint64_t low_count, size_t high_count);
+bool factorial_verify(uint64_t nbegin, uint64_t nend, char const * path, bool limbs);
+bool factorial_archive(char const * path, uint64_t nbegin, uint64_t nend);
+bool factorial_read_rows(char const * path, uint64_t nbegin, uint64_t nend);
 void factorial_u64_unrolled(uint64_t nbegin, uint64_t nend);
 void factorial_u64_tabular(uint64_t nbegin, uint64_t nend);
 void factorial_float(uint64_t nbegin, uint64_t nend);
 void factorial_double(uint64_t nbegin, uint64_t nend);
 void factorial_longdouble(uint64_t nbegin, uint64_t nend);
 //  MARK: Factorial Calculators
-void fact_u32(uint64_t val);
-void fact_s32(uint64_t val);
-void fact_u64(uint64_t val);
-void fact_s64(uint64_t val);
-void fact_u128(uint64_t val);
-void fact_s128(uint64_t val);
 void fact_gmp(uint64_t val);
+void fact_gmp_tree(uint64_t val);
+void fact_gmp_swing(uint64_t val);
+void fact_gmp_odd(uint64_t val);
+void fact_gmp_odd_tree(uint64_t val);
+bool fact_gmp_procs(uint64_t val);
 void fact_u64_unrolled(uint64_t val);
 void fact_u64_tabular(uint64_t val);
 void fact_float(uint64_t val);
 void fact_double(uint64_t val);
 void fact_longdouble(uint64_t val);
+void fact_float_gamma(uint64_t nbegin, uint64_t nend);
+void fact_double_gamma(uint64_t nbegin, uint64_t nend);
+//  MARK: Fused rows
+void row_fixed(void (* fact)(uint64_t), unsigned bits, bool is_signed, uint64_t val);
+void row_u64_small(void (* fact)(uint64_t), uint64_t val);
+void row_exact(void (* fact)(uint64_t), uint64_t val);
+void row_float(uint64_t val);
+void row_double(uint64_t val);
+void row_longdouble(uint64_t val);
 //  MARK: Helpers
-bool umulj_overflow(uint128_t multiplicand, uint128_t multiplier, uint128_t * product);
-bool smulj_overflow(int128_t  multiplicand, int128_t  multiplier, int128_t * product);
 char * uint128toa(uint128_t big, char * buffp, size_t const buff_len);
 char * int128toa(int128_t big, char * buffp, size_t const buff_len);
-int printf_fact128str(uint64_t val, char ** pnrstr, bool overflowed, size_t * ppw_max);
+driver const * find_driver(char const * name);
+void list_drivers(FILE * out);
+size_t select_drivers(char const * spec, driver const ** selected, size_t selected_l);
+void gmp_fact_from_scratch(mpz_t result, uint64_t val);
+
+//  MARK: - Engine registry
+static driver const drivers[] = {
+  { "factorial_u32",             factorial_u32,             true,  },
+  { "factorial_s32",             factorial_s32,             true,  },
+  { "factorial_u64",             factorial_u64,             true,  },
+  { "factorial_s64",             factorial_s64,             true,  },
+  { "factorial_u128",            factorial_u128,            true,  },
+  { "factorial_s128",            factorial_s128,            true,  },
+  { "factorial_gmp",             factorial_gmp,             true,  },
+  { "factorial_gfg",             factorial_gfg,             true,  },
+  { "factorial_u64_unrolled",    factorial_u64_unrolled,    true,  },
+  { "factorial_u64_tabular",     factorial_u64_tabular,     true,  },
+  { "factorial_float",           factorial_float,           true,  },
+  { "factorial_double",          factorial_double,          true,  },
+  { "factorial_longdouble",      factorial_longdouble,      true,  },
+  { "factorial_u256",            factorial_u256,            false, },
+  { "factorial_u512",            factorial_u512,            false, },
+  { "factorial_u1024",           factorial_u1024,           false, },
+  { "factorial_gmp_incremental", factorial_gmp_incremental, false, },
+  { "factorial_gmp_pipeline",    factorial_gmp_pipeline,    false, },
+  { "factorial_gmp_tree",        factorial_gmp_tree,        false, },
+  { "factorial_gmp_swing",       factorial_gmp_swing,       false, },
+  { "factorial_gmp_procs",       factorial_gmp_procs,       false, },
+  { "factorial_gmp_odd",         factorial_gmp_odd,         false, },
+  { "factorial_gmp_odd_tree",    factorial_gmp_odd_tree,    false, },
+  { "factorial_gfg_stripped",    factorial_gfg_stripped,    false, },
+  { "factorial_auto",            factorial_auto,            false, },
+  { "factorial_leading",         factorial_leading,         false, },
+};
+static size_t const drivers_c = sizeof(drivers) / sizeof(*drivers);
+
+//  Crossovers between the from-scratch GMP engines used by factorial_auto().
+static crossovers auto_crossovers;
+//  Worker processes for factorial_gmp_procs() and --output.
+static unsigned procs_count = 1;
+//  Checkpoint directory for long single-n GMP computations, or NULL.
+static char const * checkpoint_dir = NULL;
+//  Memory budget of --output in bytes (0 for none), the directory its operands spill
+//  to (NULL for that of the output file) and whether it writes raw limbs.
+static size_t mem_budget = 0;
+static char const * spill_dir = NULL;
+static bool output_limbs = false;
+//  Rows of factorial_float() and factorial_double() from the batched gamma function.
+static bool gamma_rows = false;
+//  Significant digits of factorial_leading().
+static size_t leading_precision = LEADING_PRECISION_DEFAULT;
 
 // MARK: - Implementation
 /*
@@ -104,42 +220,368 @@ int main(int argc, char const * argv[]) {
 
   version_details();
 
-  if (argc < 3) {
-    fprintf(stderr, "usage %s startN, endN", argv[0]);
+  static struct option const options[] = {
+    { "stats",     optional_argument, NULL, 's', },
+    { "memprof",   optional_argument, NULL, 'm', },
+    { "check-gfg", no_argument,       NULL, 'c', },
+    { "gamma",     no_argument,       NULL, 'g', },
+    { "check-gamma", no_argument,     NULL, 'G', },
+    { "check-batch", no_argument,     NULL, 'B', },
+    { "fused",     no_argument,       NULL, 'f', },
+    { "engine",    required_argument, NULL, 'e', },
+    { "calibrate", no_argument,       NULL, 'C', },
+    { "output",    required_argument, NULL, 'o', },
+    { "procs",     required_argument, NULL, 'p', },
+    { "checkpoint", required_argument, NULL, 'k', },
+    { "async",     no_argument,       NULL, 'a', },
+    { "deadline",  required_argument, NULL, 'd', },
+    { "report",    optional_argument, NULL, 'r', },
+    { "digest",    optional_argument, NULL, 'D', },
+    { "mod",       required_argument, NULL, 'M', },
+    { "mod-file",  required_argument, NULL, 'F', },
+    { "mem-budget", required_argument, NULL, 'b', },
+    { "spill-dir", required_argument, NULL, 'S', },
+    { "limbs",     no_argument,       NULL, 'l', },
+    { "ratio",     required_argument, NULL, 'R', },
+    { "range-file", required_argument, NULL, 'I', },
+    { "low-digits", required_argument, NULL, 'w', },
+    { "high-digits", required_argument, NULL, 'h', },
+    { "precision", required_argument, NULL, 'P', },
+    { "verify",    optional_argument, NULL, 'V', },
+    { "archive",   required_argument, NULL, 'A', },
+    { "read-rows", required_argument, NULL, 'Y', },
+    { NULL,        0,                 NULL,  0,  },
+  };
+  bool stats = false;
+  char const * stats_path = NULL;
+  bool memprof = false;
+  char const * memprof_path = NULL;
+  bool check_gfg = false;
+  bool check_gamma = false;
+  bool check_batch = false;
+  bool fused = false;
+  char const * engine_spec = NULL;
+  bool calibrate = false;
+  char const * output_path = NULL;
+  bool async = false;
+  double deadline = 0.0;
+  bool report = false;
+  char const * report_path = REPORT_DEFAULT_PATH;
+  unsigned digest_spec = 0;
+  uint64_t mod_primes[MODTABLE_PRIMES_MAX];
+  unsigned mod_primes_c = 0;
+  char const * mod_path = NULL;
+  bool ratio = false;
+  uint64_t ratio_m = 0;
+  char const * range_path = NULL;
+  bool low_digits = false;
+  uint64_t low_pos = 0;
+  uint64_t low_count = DIGITS_WINDOW_DEFAULT;
+  size_t high_count = 0;
+  bool verify = false;
+  char const * verify_path = NULL;
+  char const * archive_path = NULL;
+  char const * read_rows_path = NULL;
+  int opt;
+  while ((opt = getopt_long(argc, (char * const *) argv, "", options, NULL)) != -1) {
+    switch (opt) {
+      case 's':
+        stats = true;
+        stats_path = optarg;
+        break;
+
+      case 'm':
+        memprof = true;
+        memprof_path = optarg;
+        break;
+
+      case 'c':
+        check_gfg = true;
+        break;
+
+      case 'g':
+        gamma_rows = true;
+        break;
+
+      case 'G':
+        check_gamma = true;
+        break;
+
+      case 'B':
+        check_batch = true;
+        break;
+
+      case 'f':
+        fused = true;
+        break;
+
+      case 'e':
+        engine_spec = optarg;
+        break;
+
+      case 'C':
+        calibrate = true;
+        break;
+
+      case 'o':
+        output_path = optarg;
+        break;
+
+      case 'k':
+        checkpoint_dir = optarg;
+        break;
+
+      case 'a':
+        async = true;
+        break;
+
+      case 'd':
+        deadline = strtod(optarg, NULL);
+        break;
+
+      case 'r':
+        report = true;
+        report_path = optarg != NULL ? optarg : REPORT_DEFAULT_PATH;
+        break;
+
+      case 'D':
+        digest_spec = digest_fields(optarg);
+        RC = digest_spec != 0 ? RC : EXIT_FAILURE;
+        break;
+
+      case 'M':
+        for (char const * next = optarg; *next != '\0' && RC == EXIT_SUCCESS; ) {
+          char * end;
+          if (mod_primes_c == MODTABLE_PRIMES_MAX) {
+            fprintf(stderr, "--mod takes at most %d primes\n", MODTABLE_PRIMES_MAX);
+            RC = EXIT_FAILURE;
+            break;
+          }
+          mod_primes[mod_primes_c++] = strtoull(next, &end, 0);
+          RC = end != next && (*end == ',' || *end == '\0') ? RC : EXIT_FAILURE;
+          next = *end == ',' ? end + 1 : end;
+        }
+        break;
+
+      case 'F':
+        mod_path = optarg;
+        break;
+
+      case 'b':
+        mem_budget = ooc_parse_size(optarg);
+        if (mem_budget < OOC_BUDGET_MIN) {
+          fprintf(stderr, "--mem-budget must be a size of at least %dK\n", OOC_BUDGET_MIN / 1024);
+          RC = EXIT_FAILURE;
+        }
+        break;
+
+      case 'S':
+        spill_dir = optarg;
+        break;
+
+      case 'l':
+        output_limbs = true;
+        break;
+
+      case 'R':
+        ratio = true;
+        ratio_m = strtoull(optarg, NULL, 0);
+        break;
+
+      case 'I':
+        range_path = optarg;
+        break;
+
+      case 'w': {
+        char * end;
+        low_digits = true;
+        low_pos = strtoull(optarg, &end, 0);
+        if (*end == ',') {
+          low_count = strtoull(end + 1, &end, 0);
+        }
+        if (end == optarg || *end != '\0' || low_count == 0 || low_count > INT_MAX) {
+          fprintf(stderr, "--low-digits takes pos[,count] with count 1 to %d\n", INT_MAX);
+          RC = EXIT_FAILURE;
+        }
+        break;
+      }
+
+      case 'V':
+        verify = true;
+        verify_path = optarg;
+        break;
+
+      case 'A':
+        archive_path = optarg;
+        break;
+
+      case 'Y':
+        read_rows_path = optarg;
+        break;
+
+      case 'P':
+        leading_precision = (size_t) strtoull(optarg, NULL, 0);
+        if (leading_precision < 1 || leading_precision > LEADING_PRECISION_MAX) {
+          fprintf(stderr, "--precision must be 1 to %d\n", LEADING_PRECISION_MAX);
+          RC = EXIT_FAILURE;
+        }
+        break;
+
+      case 'h':
+        high_count = (size_t) strtoull(optarg, NULL, 0);
+        if (high_count == 0 || high_count > INT_MAX) {
+          fprintf(stderr, "--high-digits takes a count of 1 to %d\n", INT_MAX);
+          RC = EXIT_FAILURE;
+        }
+        break;
+
+      case 'p':
+        procs_count = (unsigned) strtoul(optarg, NULL, 0);
+        if (procs_count < 1 || procs_count > PROCS_MAX) {
+          fprintf(stderr, "--procs must be 1 to %d\n", PROCS_MAX);
+          RC = EXIT_FAILURE;
+        }
+        break;
+
+      default:
+        RC = EXIT_FAILURE;
+        break;
+    }
+  }
+
+  auto_crossovers = calibrate_defaults();
+  calibrate_load(&auto_crossovers);
+  if (RC == EXIT_SUCCESS && calibrate) {
+    if (calibrate_run(&auto_crossovers, stdout)) {
+      calibrate_save(&auto_crossovers);
+    }
+    if (argc - optind < 2) {
+      return RC;
+    }
+  }
+
+  if (RC == EXIT_SUCCESS && report) {
+    if (argc - optind < 1) {
+      fprintf(stderr, "usage %s --report[=file.html] file.csv [file.csv...]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+    return report_write(report_path, &argv[optind], (size_t) (argc - optind)) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if (RC == EXIT_SUCCESS && engine_spec != NULL && strcmp(engine_spec, "list") == 0) {
+    list_drivers(stdout);
+    return RC;
+  }
+
+  driver const * selected[sizeof(drivers) / sizeof(*drivers)];
+  size_t selected_c = 0;
+  if (RC == EXIT_SUCCESS) {
+    selected_c = select_drivers(engine_spec, selected, sizeof(selected) / sizeof(*selected));
+    RC = selected_c > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  if ((mem_budget != 0 || output_limbs) && output_path == NULL && !(output_limbs && verify_path != NULL)) {
+    fprintf(stderr, "--mem-budget needs --output, and --limbs --output or --verify=file\n");
+    RC = EXIT_FAILURE;
+  }
+  else if (output_limbs && ((output_path != NULL && mem_budget == 0) || argc - optind < 2 || strcmp(argv[optind], argv[optind + 1]) != 0)) {
+    fprintf(stderr, "--limbs needs startN equal to endN, and --mem-budget with --output\n");
+    RC = EXIT_FAILURE;
+  }
+  else if (verify && output_path != NULL && (verify_path != NULL || strcmp(output_path, "-") == 0)) {
+    fprintf(stderr, "--verify with --output checks the output file, which must be named\n");
+    RC = EXIT_FAILURE;
+  }
+
+  if (async && memprof) {
+    fprintf(stderr, "--memprof cannot be combined with --async\n");
+    RC = EXIT_FAILURE;
+  }
+
+  if (RC != EXIT_SUCCESS || argc - optind < 2) {
+    fprintf(stderr, "usage %s [--stats[=file.csv]] [--memprof[=file.csv]] [--check-gfg] [--gamma] [--check-gamma] [--check-batch] [--fused] "
+                    "[--engine auto|name[,name...]] [--precision digits] [--calibrate] [--output file [--mem-budget size[K|M|G] [--spill-dir dir] [--limbs]]] [--procs N] [--checkpoint dir] [--async [--deadline seconds]] [--digest[=sum,histogram,hash]] [--mod p[,p...] [--mod-file file]] [--ratio m [--range-file file]] [--low-digits pos[,count]] [--high-digits count] [--verify[=file] [--limbs]] [--archive file] [--read-rows file] startN, endN\n"
+                    "      %s --report[=file.html] file.csv [file.csv...]", argv[0], argv[0]);
+    RC = EXIT_FAILURE;
+  }
+  else if ((stats && !stats_open(stats_path)) || (memprof && !memprof_open(memprof_path))) {
     RC = EXIT_FAILURE;
   }
   else {
     uint64_t nbegin;
     uint64_t nend;
-    nbegin = strtoul(argv[1], NULL, 0);
-    nend = strtoul(argv[2], NULL, 0);
+    nbegin = strtoul(argv[optind], NULL, 0);
+    nend = strtoul(argv[optind + 1], NULL, 0);
+    stats_workers(procs_count);
 
-    factorial_u32(nbegin, nend);
-    putchar('\n');
-    factorial_s32(nbegin, nend);
-    putchar('\n');
-    factorial_u64(nbegin, nend);
-    putchar('\n');
-    factorial_s64(nbegin, nend);
-    putchar('\n');
-    factorial_u128(nbegin, nend);
-    putchar('\n');
-    factorial_s128(nbegin, nend);
-    putchar('\n');
-    factorial_gmp(nbegin, nend);
-    putchar('\n');
-    factorial_gfg(nbegin, nend);
-    putchar('\n');
-    factorial_u64_unrolled(nbegin, nend);
-    putchar('\n');
-    factorial_u64_tabular(nbegin, nend);
-    putchar('\n');
-    factorial_float(nbegin, nend);
-    putchar('\n');
-    factorial_double(nbegin, nend);
-    putchar('\n');
-    factorial_longdouble(nbegin, nend);
-    putchar('\n');
+    if (check_gfg) {
+      RC = factorial_gfg_check(nbegin, nend) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (check_gamma) {
+      RC = gamma_check(nbegin, nend) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (check_batch) {
+      RC = batch_check(nbegin, nend) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (async) {
+      bool use_gfg = selected_c == 1 && selected[0]->run == factorial_gfg;
+      stats_workers(factorial_async_threads());
+      stats_begin(use_gfg ? "factorial_gfg_async" : "factorial_gmp_async", nbegin, nend);
+      RC = factorial_async_table(nbegin, nend, use_gfg, deadline) ? EXIT_SUCCESS : EXIT_FAILURE;
+      stats_end();
+    }
+    else if (digest_spec != 0) {
+      bool use_gfg = selected_c == 1 && selected[0]->run == factorial_gfg;
+      RC = factorial_digest(nbegin, nend, use_gfg, digest_spec) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (mod_primes_c > 0) {
+      RC = factorial_mod_table(nbegin, nend, mod_primes, mod_primes_c, mod_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (low_digits || high_count > 0) {
+      RC = factorial_digit_windows(nbegin, nend, low_digits, low_pos, low_count, high_count) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (ratio) {
+      RC = factorial_range_ratio(nbegin, nend, ratio_m, range_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (read_rows_path != NULL) {
+      RC = factorial_read_rows(read_rows_path, nbegin, nend) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (archive_path != NULL) {
+      RC = factorial_archive(archive_path, nbegin, nend) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (verify && output_path == NULL) {
+      RC = factorial_verify(nbegin, nend, verify_path, output_limbs) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else if (output_path != NULL) {
+      bool use_gfg = selected_c == 1 && selected[0]->run == factorial_gfg;
+      RC = factorial_output(output_path, use_gfg, nbegin, nend) ? EXIT_SUCCESS : EXIT_FAILURE;
+      if (RC == EXIT_SUCCESS && verify) {
+        RC = factorial_verify(nbegin, nend, output_path, output_limbs) ? EXIT_SUCCESS : EXIT_FAILURE;
+      }
+    }
+    else {
+      if (fused) {
+        stats_begin("factorial_fused_sweep", nbegin, nend);
+        memprof_begin("factorial_fused_sweep");
+        RC = fused_sweep(nbegin, nend) ? EXIT_SUCCESS : EXIT_FAILURE;
+        memprof_end();
+        stats_end();
+      }
+      for (size_t d_ = 0; RC == EXIT_SUCCESS && d_ < selected_c; ++d_) {
+        stats_begin(selected[d_]->name, nbegin, nend);
+        memprof_begin(selected[d_]->name);
+        selected[d_]->run(nbegin, nend);
+        memprof_end();
+        stats_end();
+        putchar('\n');
+      }
+      fused_release();
+    }
+
+    stats_summary(stdout);
+    memprof_summary(stdout);
+    stats_close();
+    memprof_close();
   }
 
   return RC;
@@ -158,7 +600,8 @@ void factorial_u32(uint64_t nbegin, uint64_t nend) {
   printf("Factorials from %" PRIu64 " to %" PRIu64 " {32-bit values}:\n\n", nbegin, nend);
   printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_s32(nb);
+    memprof_row(nb);
+    row_fixed(fact_s32, 32, true, nb);
   }
 
   return;
@@ -175,7 +618,8 @@ void factorial_s32(uint64_t nbegin, uint64_t nend) {
   printf("Factorials from %" PRIu64 " to %" PRIu64 " {32-bit values}:\n\n", nbegin, nend);
   printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_u32(nb);
+    memprof_row(nb);
+    row_fixed(fact_u32, 32, false, nb);
   }
 
   return;
@@ -193,12 +637,370 @@ void factorial_u64(uint64_t nbegin, uint64_t nend) {
   printf("Factorials from %" PRIu64 " to %" PRIu64 " {64-bit values}:\n\n", nbegin, nend);
   printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_u64(nb);
+    memprof_row(nb);
+    row_fixed(fact_u64, 64, false, nb);
   }
 
   return;
 }
 
+/*
+ *  MARK: factorial_output()
+ *
+ *  Write the factorials nbegin! to nend! to the file "path" ("-" for standard output),
+ *  streaming each decimal expansion rather than formatting it in memory.
+ *  GMP computes them unless use_gfg selects the GMP-free engine, within mem_budget
+ *  bytes when one is set, spilling to spill_dir or else the directory of "path".
+ */
+bool factorial_output(char const * path, bool use_gfg, uint64_t nbegin, uint64_t nend) {
+
+  bool to_stdout = strcmp(path, "-") == 0;
+  FILE * out = to_stdout ? stdout : fopen(path, "w");
+  bool out_of_core = mem_budget != 0 && !use_gfg;
+  char const * engine = use_gfg ? "factorial_gfg_stream" : out_of_core ? "factorial_gmp_ooc" : "factorial_gmp_stream";
+  bool written = false;
+  char spill_default[4096];
+
+  if (out_of_core && spill_dir == NULL) {
+    char const * slash = to_stdout ? NULL : strrchr(path, '/');
+    snprintf(spill_default, sizeof(spill_default), "%.*s", slash == NULL ? 1 : (int) (slash - path + (slash == path)), slash == NULL ? "." : path);
+  }
+
+  if (out == NULL) {
+    perror(path);
+  }
+  else {
+    if (!to_stdout) {
+      setvbuf(out, NULL, _IOFBF, OUTPUT_BUFFER);
+    }
+    stats_begin(engine, nbegin, nend);
+    memprof_begin(engine);
+    if (use_gfg) {
+      written = stream_factorials_gfg(out, nbegin, nend);
+    }
+    else if (out_of_core) {
+      written = stream_factorials_ooc(out, nbegin, nend, mem_budget, spill_dir != NULL ? spill_dir : spill_default, output_limbs);
+    }
+    else {
+      written = stream_factorials_gmp(out, nbegin, nend, procs_count, checkpoint_dir);
+    }
+    memprof_end();
+    stats_end();
+    bool io_failed = ferror(out) != 0;
+    io_failed = (to_stdout ? fflush(out) : fclose(out)) != 0 || io_failed;
+    if (io_failed) {
+      perror(path);
+    }
+    written = written && !io_failed;
+  }
+
+  return written;
+}
+
+/*
+ *  MARK: factorial_digest()
+ *
+ *  Display the digit count and the selected reductions of the decimal expansions of
+ *  nbegin! to nend!, which are never formatted in full.
+ *  GMP computes them, converting with one thread per processor, unless use_gfg
+ *  selects the GMP-free engine.
+ *  @see: factorial_digest.c
+ */
+bool factorial_digest(uint64_t nbegin, uint64_t nend, bool use_gfg, unsigned fields) {
+
+  char const * engine = use_gfg ? "factorial_gfg_digest" : "factorial_gmp_digest";
+  long online = sysconf(_SC_NPROCESSORS_ONLN);
+  unsigned threads = online < 1 || memprof_enabled() ? 1 : online > DIGEST_THREADS_MAX ? DIGEST_THREADS_MAX : (unsigned) online;
+  bool written;
+
+  printf("Function: %s\n", __func__);
+  printf("Digests of the factorials from %" PRIu64 " to %" PRIu64 " {%s, %u %s}:\n\n",
+         nbegin, nend, use_gfg ? "GMP-free engine" : "GMP", use_gfg ? 1 : threads, use_gfg || threads == 1 ? "thread" : "threads");
+  digest_header(stdout, fields);
+  stats_begin(engine, nbegin, nend);
+  memprof_begin(engine);
+  written = use_gfg ? digest_factorials_gfg(stdout, nbegin, nend, fields) : digest_factorials_gmp(stdout, nbegin, nend, fields, threads);
+  memprof_end();
+  stats_end();
+
+  return written;
+}
+
+/*
+ *  MARK: factorial_mod_table()
+ *
+ *  Display i! and 1/i! mod each prime for nbegin <= i <= nend from a table up to nend.
+ *  With a path the table is mapped from that file when it already holds these primes
+ *  up to nend or beyond, and otherwise built into it for other processes to map.
+ *  @see: factorial_modtable.c
+ */
+bool factorial_mod_table(uint64_t nbegin, uint64_t nend, uint64_t const primes[], unsigned primes_c, char const * path) {
+
+  modtable table;
+  bool mapped = path != NULL && modtable_open(&table, path);
+
+  if (mapped && (table.n < nend || table.primes_c != primes_c
+                 || memcmp(table.primes, primes, primes_c * sizeof(*primes)) != 0)) {
+    modtable_close(&table);
+    mapped = false;
+  }
+  if (!mapped) {
+    stats_begin("factorial_mod_table", 0, nend);
+    bool built = modtable_build(&table, nend, primes, primes_c, path);
+    stats_end();
+    if (!built) {
+      return false;
+    }
+  }
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials and inverses from %" PRIu64 " to %" PRIu64 " {Montgomery arithmetic, %u %s, table %s}:\n\n",
+         nbegin, nend, primes_c, primes_c == 1 ? "prime" : "primes", mapped ? "mapped" : "built");
+  for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+    printf("......>: %20" PRIu64 " <-- %s %u\n", primes[k_], "p", k_);
+  }
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    printf("%6" PRIu64 "!:", nb);
+    for (unsigned k_ = 0; k_ < primes_c; ++k_) {
+      printf(" %20" PRIu64 " %20" PRIu64, table.fact[k_][nb], table.inv_fact[k_][nb]);
+    }
+    putchar('\n');
+  }
+  modtable_close(&table);
+
+  return true;
+}
+
+/*
+ *  MARK: factorial_range_ratio()
+ *
+ *  Display n!/m! for n from nbegin to nend, each assembled from the index of range
+ *  products over [1, nend]. The index is mapped from "path" when it is given and
+ *  already covers nend, and otherwise built, and saved to it.
+ *  @see: factorial_rangetree.c
+ */
+bool factorial_range_ratio(uint64_t nbegin, uint64_t nend, uint64_t mval, char const * path) {
+
+  rangetree tree;
+  bool mapped = path != NULL && rangetree_open(&tree, path);
+
+  if (mval > nbegin) {
+    fprintf(stderr, "--ratio %" PRIu64 " is above startN\n", mval);
+    return false;
+  }
+  if (mapped && tree.n < nend) {
+    rangetree_close(&tree);
+    mapped = false;
+  }
+  if (!mapped) {
+    stats_begin("factorial_range_index", 0, nend);
+    bool built = rangetree_build(&tree, nend, path);
+    stats_end();
+    if (!built) {
+      return false;
+    }
+  }
+
+  printf("Function: %s\n", __func__);
+  printf("Ratios n!/%" PRIu64 "! from %" PRIu64 " to %" PRIu64 " {GMP, range index %s}:\n", mval, nbegin, nend, mapped ? "mapped" : "built");
+  printf("Index over [1, %" PRIu64 "]: %u levels, %" PRIu64 " leaves of %" PRIu64 ", %zu bytes of limbs, built in %.6f seconds",
+         tree.n, tree.levels, tree.count[0], tree.leaf, tree.bytes, tree.build_seconds);
+  if (mapped) {
+    printf(", mapped in %.6f seconds", tree.map_seconds);
+  }
+  printf("\n\n");
+
+  bool written = true;
+  mpz_t ratio;
+  mpz_init(ratio);
+  stats_begin("factorial_range_ratio", nbegin, nend);
+  memprof_begin("factorial_range_ratio");
+  for (uint64_t nb = nbegin; written && nb <= nend; ++nb) {
+    memprof_row(nb);
+    rangetree_ratio(&tree, ratio, nb, mval);
+    written = printf("%6" PRIu64 "!/%" PRIu64 "!: ", nb, mval) > 0 && stream_mpz_decimal(stdout, ratio) && putchar('\n') != EOF;
+  }
+  memprof_end();
+  stats_end();
+  mpz_clear(ratio);
+  rangetree_close(&tree);
+
+  return written;
+}
+
+/*
+ *  MARK: factorial_digit_windows()
+ *
+ *  Display, for nbegin! to nend!, the digits low_pos to low_pos + low_count - 1 from
+ *  the least significant when "low" is set, and the number of digits and the leading
+ *  high_count digits when it is not 0, without computing the factorials in full.
+ *  @see: factorial_digits.c
+ */
+bool factorial_digit_windows(uint64_t nbegin, uint64_t nend, bool low, uint64_t low_pos, uint64_t low_count, size_t high_count) {
+
+  bool written = true;
+  char * leading = high_count > 0 ? malloc(high_count + 1) : NULL;
+  mpz_t window;
+
+  if (high_count > 0 && leading == NULL) {
+    fprintf(stderr, "--high-digits: no memory for %zu digits\n", high_count);
+    return false;
+  }
+
+  printf("Function: %s\n", __func__);
+  printf("Digit windows of the factorials from %" PRIu64 " to %" PRIu64 " {GMP, n! mod 10^k and truncated products}:\n\n", nbegin, nend);
+  mpz_init(window);
+  stats_begin("factorial_digit_windows", nbegin, nend);
+  memprof_begin("factorial_digit_windows");
+  for (uint64_t nb = nbegin; written && nb <= nend; ++nb) {
+    memprof_row(nb);
+    if (high_count > 0) {
+      uint64_t digits;
+      written = digits_high(leading, &digits, nb, high_count)
+             && printf("%6" PRIu64 "!: %" PRIu64 " digits, leading %zu: %s\n", nb, digits, strlen(leading), leading) > 0;
+    }
+    if (written && low) {
+      digits_low(window, nb, low_pos, low_count);
+      written = gmp_printf("%6" PRIu64 "!: digits %" PRIu64 " to %" PRIu64 ": %0*Zd\n",
+                           nb, low_pos, low_pos + low_count - 1, (int) low_count, window) > 0;
+    }
+  }
+  memprof_end();
+  stats_end();
+  mpz_clear(window);
+  free(leading);
+
+  return written;
+}
+
+/*
+ *  MARK: factorial_verify()
+ *
+ *  Check nbegin! to nend! against n! mod a few random primes: the rows of the decimal
+ *  file at "path", or the raw limbs of nbegin! (= nend!) in it if "limbs" is set, or
+ *  without a path the GMP results in memory, computed here.
+ *  @see: factorial_verify.c
+ */
+bool factorial_verify(uint64_t nbegin, uint64_t nend, char const * path, bool limbs) {
+
+  verifier vf;
+  bool matched;
+
+  if (!verify_init(&vf)) {
+    return false;
+  }
+  printf("Function: %s\n", __func__);
+  printf("Fingerprints of the factorials from %" PRIu64 " to %" PRIu64 " {n! mod %d random %d-bit primes, %s%s}:\n\n",
+         nbegin, nend, VERIFY_PRIMES, VERIFY_PRIME_BITS, path == NULL ? "GMP in memory" : limbs ? "raw limbs in " : "decimal rows in ",
+         path == NULL ? "" : path);
+  for (unsigned k_ = 0; k_ < VERIFY_PRIMES; ++k_) {
+    printf("......>: %20" PRIu64 " <-- %s %u\n", vf.primes[k_], "p", k_);
+  }
+
+  if (path == NULL) {
+    double compute = 0.0;
+    double check = 0.0;
+    mpz_t pf;
+
+    matched = true;
+    mpz_init(pf);
+    stats_begin("factorial_verify", nbegin, nend);
+    memprof_begin("factorial_verify");
+    for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+      memprof_row(nb);
+      double t0 = stats_seconds();
+      if (nb == nbegin) {
+        gmp_fact_from_scratch(pf, nb);
+      }
+      else {
+        mpz_mul_ui(pf, pf, nb);
+        STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+        STATS_COUNT(STATS_LIMB_OPS, mpz_size(pf));
+      }
+      double t1 = stats_seconds();
+      matched = verify_mpz(&vf, stdout, nb, pf) && matched;
+      double t2 = stats_seconds();
+      compute += t1 - t0;
+      check += t2 - t1;
+    }
+    memprof_end();
+    stats_end();
+    mpz_clear(pf);
+    printf("Computed in %.6f seconds, verified in %.6f seconds\n", compute, check);
+  }
+  else {
+    stats_begin("factorial_verify", nbegin, nend);
+    memprof_begin("factorial_verify");
+    matched = limbs ? verify_limbs_file(&vf, stdout, nbegin, path) : verify_decimal_file(&vf, stdout, path);
+    memprof_end();
+    stats_end();
+  }
+  printf("%" PRIu64 " %s verified, %" PRIu64 " %s\n", vf.rows - vf.mismatches, vf.rows - vf.mismatches == 1 ? "factorial" : "factorials",
+         vf.mismatches, vf.mismatches == 1 ? "mismatch" : "mismatches");
+
+  return matched;
+}
+
+/*
+ *  MARK: factorial_archive()
+ *
+ *  Write the rows nbegin! to nend! to a compressed archive at "path", indexed by n.
+ *  @see: factorial_archive.c
+ */
+bool factorial_archive(char const * path, uint64_t nbegin, uint64_t nend) {
+
+  long online = sysconf(_SC_NPROCESSORS_ONLN);
+  unsigned workers = memprof_enabled() ? 0 : online <= 2 ? 1 : online > ARCHIVE_WORKERS_MAX ? ARCHIVE_WORKERS_MAX : (unsigned) online - 1;
+  archive_summary summary;
+  bool archived;
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {multiple precision arithmatic, archived to %s in blocks of %d bytes, %u worker %s}:\n\n",
+         nbegin, nend, path, ARCHIVE_BLOCK_BYTES, workers, workers == 1 ? "thread" : "threads");
+  stats_workers(workers > 0 ? workers : 1);
+  stats_begin("factorial_archive", nbegin, nend);
+  memprof_begin("factorial_archive");
+  archived = archive_write_gmp(path, nbegin, nend, workers, &summary);
+  memprof_end();
+  stats_end();
+  if (archived) {
+    printf("%" PRIu64 " rows in %" PRIu64 " blocks: %" PRIu64 " bytes of text stored in %" PRIu64 " bytes (%.1f%%) in %.6f seconds\n",
+           summary.rows, summary.blocks, summary.raw_bytes, summary.stored_bytes,
+           summary.raw_bytes > 0 ? 100.0 * (double) summary.stored_bytes / (double) summary.raw_bytes : 0.0, summary.seconds);
+  }
+
+  return archived;
+}
+
+/*
+ *  MARK: factorial_read_rows()
+ *
+ *  Display the rows nbegin! to nend! from the archive at "path", inflating only the
+ *  blocks that hold them.
+ */
+bool factorial_read_rows(char const * path, uint64_t nbegin, uint64_t nend) {
+
+  archive_summary summary;
+  bool read;
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {read from the archive %s}:\n\n", nbegin, nend, path);
+  printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
+  printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
+  printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
+  printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
+  fflush(stdout);
+  stats_begin("factorial_read_rows", nbegin, nend);
+  read = archive_read_rows(stdout, path, nbegin, nend, &summary);
+  stats_end();
+  if (read) {
+    printf("\n%" PRIu64 " rows from %" PRIu64 " of %" PRIu64 " blocks: %" PRIu64 " bytes inflated from %" PRIu64 " bytes in %.6f seconds\n",
+           summary.rows, summary.blocks, summary.blocks_total, summary.raw_bytes, summary.stored_bytes, summary.seconds);
+  }
+
+  return read;
+}
+
 /*
  *  MARK: factorial_u64_unrolled()
  *
@@ -210,7 +1012,8 @@ void factorial_u64_unrolled(uint64_t nbegin, uint64_t nend) {
   printf("Factorials from %" PRIu64 " to %" PRIu64 " {64-bit values}:\n\n", nbegin, nend);
   printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_u64_unrolled(nb);
+    memprof_row(nb);
+    row_u64_small(fact_u64_unrolled, nb);
   }
 
   return;
@@ -227,7 +1030,8 @@ void factorial_u64_tabular(uint64_t nbegin, uint64_t nend) {
   printf("Factorials from %" PRIu64 " to %" PRIu64 " {64-bit values}:\n\n", nbegin, nend);
   printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_u64_tabular(nb);
+    memprof_row(nb);
+    row_u64_small(fact_u64_tabular, nb);
   }
 
   return;
@@ -244,7 +1048,8 @@ void factorial_s64(uint64_t nbegin, uint64_t nend) {
   printf("Factorials from %" PRIu64 " to %" PRIu64 " {64-bit values}:\n\n", nbegin, nend);
   printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_s64(nb);
+    memprof_row(nb);
+    row_fixed(fact_s64, 64, true, nb);
   }
 
   return;
@@ -278,7 +1083,8 @@ void factorial_u128(uint64_t nbegin, uint64_t nend) {
   printf("......>: %40" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
   printf("......>: %40s <-- %s\n", pbuff, "Max unsigned 128-bit integer");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_u128(nb);
+    memprof_row(nb);
+    row_fixed(fact_u128, 128, false, nb);
   }
 
   return;
@@ -319,7 +1125,8 @@ void factorial_s128(uint64_t nbegin, uint64_t nend) {
   printf("......>: %40s <-- %s\n", pbuff_min, "Min signed 128-bit integer");
   printf("......>: %40s <-- %s\n", pbuff_max, "Max signed 128-bit integer");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_s128(nb);
+    memprof_row(nb);
+    row_fixed(fact_s128, 128, true, nb);
   }
 
   return;
@@ -340,12 +1147,281 @@ void factorial_gmp(uint64_t nbegin, uint64_t nend) {
   printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
   printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_gmp(nb);
+    memprof_row(nb);
+    row_exact(fact_gmp, nb);
   }
 
   return;
 }
 
+/*
+ *  MARK: factorial_gmp_incremental()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ *  The first factorial is computed from scratch (one factor at a time and
+ *  checkpointed when --checkpoint is given), every following one from its
+ *  predecessor with a single multiplication.
+ */
+void factorial_gmp_incremental(uint64_t nbegin, uint64_t nend) {
+
+  mpz_t pf;
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {multiple precision arithmatic}:\n\n", nbegin, nend);
+  printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
+  printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
+  printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
+  printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
+  mpz_init(pf);
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    memprof_row(nb);
+    if (nb == nbegin && checkpoint_dir != NULL) {
+      if (!checkpoint_fact(pf, nb, checkpoint_dir, CHECKPOINT_LINEAR)) {
+        gmp_fact_linear(pf, nb);
+      }
+    }
+    else if (nb == nbegin) {
+      gmp_fact_from_scratch(pf, nb);
+    }
+    else {
+      mpz_mul_ui(pf, pf, nb);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      STATS_COUNT(STATS_LIMB_OPS, mpz_size(pf));
+    }
+    int pc = gmp_printf("%6" PRIu64 "!: %20Zd\n", nb, pf);
+    STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+  }
+  mpz_clear(pf);
+
+  return;
+}
+
+/*
+ *  MARK: factorial_gmp_pipeline()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ *  Each factorial follows from its predecessor, as in factorial_gmp_incremental(),
+ *  while one thread per further processor converts earlier rows to decimal and a
+ *  writer thread displays them in order; then the utilisation of each stage.
+ *  @see: factorial_pipeline.c
+ */
+void factorial_gmp_pipeline(uint64_t nbegin, uint64_t nend) {
+
+  long online = sysconf(_SC_NPROCESSORS_ONLN);
+  unsigned formatters = memprof_enabled() ? 0 : online <= 2 ? 1 : online > PIPELINE_FORMATTERS_MAX ? PIPELINE_FORMATTERS_MAX : (unsigned) online - 1;
+  pipeline_usage usage;
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {multiple precision arithmatic, %u formatter %s}:\n\n",
+         nbegin, nend, formatters, formatters == 1 ? "thread" : "threads");
+  printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
+  printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
+  printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
+  printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
+  if (!pipeline_factorials_gmp(stdout, nbegin, nend, formatters, &usage)) {
+    perror("factorial_gmp_pipeline");
+  }
+  pipeline_report(stdout, &usage);
+
+  return;
+}
+
+/*
+ *  MARK: factorial_gmp_tree()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ */
+void factorial_gmp_tree(uint64_t nbegin, uint64_t nend) {
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {multiple precision arithmatic}:\n\n", nbegin, nend);
+  printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
+  printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
+  printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
+  printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    memprof_row(nb);
+    fact_gmp_tree(nb);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: factorial_gmp_swing()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ */
+void factorial_gmp_swing(uint64_t nbegin, uint64_t nend) {
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {multiple precision arithmatic}:\n\n", nbegin, nend);
+  printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
+  printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
+  printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
+  printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    memprof_row(nb);
+    fact_gmp_swing(nb);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: factorial_gmp_odd()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ */
+void factorial_gmp_odd(uint64_t nbegin, uint64_t nend) {
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {multiple precision arithmatic}:\n\n", nbegin, nend);
+  printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
+  printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
+  printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
+  printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    memprof_row(nb);
+    fact_gmp_odd(nb);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: factorial_gmp_odd_tree()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ */
+void factorial_gmp_odd_tree(uint64_t nbegin, uint64_t nend) {
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {multiple precision arithmatic}:\n\n", nbegin, nend);
+  printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
+  printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
+  printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
+  printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    memprof_row(nb);
+    fact_gmp_odd_tree(nb);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: factorial_gmp_procs()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ *  Each factorial is computed by --procs worker processes; the table stops
+ *  at the first one that fails.
+ */
+void factorial_gmp_procs(uint64_t nbegin, uint64_t nend) {
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {multiple precision arithmatic, %u processes}:\n\n",
+         nbegin, nend, procs_count);
+  printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
+  printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
+  printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
+  printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    memprof_row(nb);
+    if (!fact_gmp_procs(nb)) {
+      printf("%6" PRIu64 "!: %20s\n", nb, "*- workers failed -*");
+      break;
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: factorial_auto()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ *  Each factorial is computed by the cheapest engine that is exact for it:
+ *  the lookup table up to 20!, 128-bit integers up to 34!, and GMP beyond.
+ *  A GMP factorial follows from its predecessor when that was computed by GMP,
+ *  otherwise it is computed from scratch by the engine the crossovers select.
+ */
+void factorial_auto(uint64_t nbegin, uint64_t nend) {
+
+  mpz_t pf;
+  bool warm = false;
+  uint64_t warm_n = 0;
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {engine chosen by n}:\n\n", nbegin, nend);
+  printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
+  mpz_init(pf);
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    memprof_row(nb);
+    if (nb >= 1 && nb <= U64_EXACT_MAX) {
+      fact_u64_tabular(nb);
+    }
+    else if (nb >= 1 && nb <= U128_EXACT_MAX) {
+      fact_u128(nb);
+    }
+    else {
+      if (warm && warm_n + 1 == nb) {
+        mpz_mul_ui(pf, pf, nb);
+        STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+        STATS_COUNT(STATS_LIMB_OPS, mpz_size(pf));
+      }
+      else {
+        gmp_fact_from_scratch(pf, nb);
+      }
+      warm = true;
+      warm_n = nb;
+      int pc = gmp_printf("%6" PRIu64 "!: %20Zd\n", nb, pf);
+      STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+    }
+  }
+  mpz_clear(pf);
+
+  return;
+}
+
+/*
+ *  MARK: factorial_leading()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ *  to leading_precision significant digits (truncated) and a decimal exponent.
+ *  @see: factorial_leading.c
+ */
+void factorial_leading(uint64_t nbegin, uint64_t nend) {
+
+  char * text = malloc(leading_precision + 1);
+  bool more = text != NULL && nbegin <= nend;
+  mpz_t exponent;
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {%zu significant digits, Stirling series or truncated product}:\n\n",
+         nbegin, nend, leading_precision);
+  mpz_init(exponent);
+  //  nend may be UINT64_MAX, so the loop stops at nend rather than past it.
+  for (uint64_t nb = nbegin; more; ++nb) {
+    bool stirling;
+
+    more = nb != nend;
+    memprof_row(nb);
+    if (leading_factorial(text, exponent, &stirling, nb, leading_precision)) {
+      int pc = gmp_printf("%6" PRIu64 "!: %c%s%se+%Zd%s\n", nb, text[0], text[1] == '\0' ? "" : ".", text + 1, exponent,
+                          stirling ? "" : " *- product -*");
+      STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+    }
+    else {
+      printf("%6" PRIu64 "!: *- unresolved -*\n", nb);
+    }
+  }
+  mpz_clear(exponent);
+  free(text);
+
+  return;
+}
+
 /*
  *  MARK: factorial_gfg()
  *
@@ -360,10 +1436,69 @@ void factorial_gfg(uint64_t nbegin, uint64_t nend) {
   printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
   printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    gfg_factorial(nb);
+    memprof_row(nb);
+    row_exact(gfg_factorial, nb);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: factorial_gfg_stripped()
+ *
+ *  Display table of factorials within ranges "nbegin" and "nend"
+ */
+void factorial_gfg_stripped(uint64_t nbegin, uint64_t nend) {
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {multiple precision arithmatic}:\n\n", nbegin, nend);
+  printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
+  printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
+  printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
+  printf("......>: %20" PRIu64 " <-- %s\n", UINT64_MAX, "UINT64_MAX");
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    memprof_row(nb);
+    gfg_factorial_stripped(nb);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: factorial_gfg_check()
+ *
+ *  Verify the GMP-free engine against GMP for every factorial within ranges
+ *  "nbegin" and "nend". The GMP value is carried from one n to the next.
+ *  Returns true when every value matches.
+ */
+bool factorial_gfg_check(uint64_t nbegin, uint64_t nend) {
+
+  bool matched = true;
+  mpz_t pf;
+
+  printf("Function: %s\n", __func__);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {GMP-free engine vs GMP}:\n\n", nbegin, nend);
+  mpz_init(pf);
+  mpz_fac_ui(pf, nbegin);
+  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+    if (nb > nbegin) {
+      mpz_mul_ui(pf, pf, nb);
+    }
+    char * gfg = get_factorial(nb);
+    char * gmp = mpz_get_str(NULL, 10, pf);
+    bool same = strcmp(gfg, gmp) == 0;
+    printf("%6" PRIu64 "!: %20zu digits %s\n", nb, strlen(gmp), same ? "" : "*- mismatch -*");
+    matched = matched && same;
+
+    void (* gmp_free)(void *, size_t);
+    mp_get_memory_functions(NULL, NULL, &gmp_free);
+    gmp_free(gmp, strlen(gmp) + 1);
+    memprof_free(gfg);
   }
+  mpz_clear(pf);
+  printf("\n%s\n", matched ? "All values match." : "*- Values differ -*");
 
-  return;
+  return matched;
 }
 
 //  MARK: <--> floating point drivers
@@ -373,7 +1508,8 @@ void factorial_gfg(uint64_t nbegin, uint64_t nend) {
 void factorial_float(uint64_t nbegin, uint64_t nend) {
   
   printf("Function: %s\n", __func__);
-  printf("Factorials from %" PRIu64 " to %" PRIu64 " {single precision floating point}:\n\n", nbegin, nend);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {single precision floating point%s}:\n\n", nbegin, nend,
+         gamma_rows ? ", batched gamma function" : "");
   printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
   printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
   printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
@@ -384,8 +1520,14 @@ void factorial_float(uint64_t nbegin, uint64_t nend) {
   printf("......>: %20.13le <-- %s\n", DBL_MAX, "DBL_MAX");
   printf("......>: %20.3Lf <-- %s\n", LDBL_MAX, "LDBL_MAX");
   printf("......>: %20.12Le <-- %s\n", LDBL_MAX, "LDBL_MAX");
-  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_float(nb);
+  if (gamma_rows) {
+    fact_float_gamma(nbegin, nend);
+  }
+  else {
+    for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+      memprof_row(nb);
+      row_float(nb);
+    }
   }
 
   return;
@@ -397,7 +1539,8 @@ void factorial_float(uint64_t nbegin, uint64_t nend) {
 void factorial_double(uint64_t nbegin, uint64_t nend) {
 
   printf("Function: %s\n", __func__);
-  printf("Factorials from %" PRIu64 " to %" PRIu64 " {double precision floating point}:\n\n", nbegin, nend);
+  printf("Factorials from %" PRIu64 " to %" PRIu64 " {double precision floating point%s}:\n\n", nbegin, nend,
+         gamma_rows ? ", batched gamma function" : "");
   printf("......>: %20" PRId32 " <-- %s\n", INT32_MAX, "INT32_MAX");
   printf("......>: %20" PRIu32 " <-- %s\n", UINT32_MAX, "UINT32_MAX");
   printf("......>: %20" PRId64 " <-- %s\n", INT64_MAX, "INT64_MAX");
@@ -408,8 +1551,14 @@ void factorial_double(uint64_t nbegin, uint64_t nend) {
   printf("......>: %20.13le <-- %s\n", DBL_MAX, "DBL_MAX");
   printf("......>: %20.3Lf <-- %s\n", LDBL_MAX, "LDBL_MAX");
   printf("......>: %20.12Le <-- %s\n", LDBL_MAX, "LDBL_MAX");
-  for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_double(nb);
+  if (gamma_rows) {
+    fact_double_gamma(nbegin, nend);
+  }
+  else {
+    for (uint64_t nb = nbegin; nb <= nend; ++nb) {
+      memprof_row(nb);
+      row_double(nb);
+    }
   }
 
   return;
@@ -433,117 +1582,18 @@ void factorial_longdouble(uint64_t nbegin, uint64_t nend) {
   printf("......>: %20.3Lf <-- %s\n", LDBL_MAX, "LDBL_MAX");
   printf("......>: %20.12Le <-- %s\n", LDBL_MAX, "LDBL_MAX");
   for (uint64_t nb = nbegin; nb <= nend; ++nb) {
-    fact_longdouble(nb);
+    memprof_row(nb);
+    row_longdouble(nb);
   }
 
   return;
 }
 
 //  MARK: - Implementors -
-//  MARK: <--> 32-bit implementations
-/*
- *  MARK: fact_u32()
- *
- *  Calculate val! using unsigned 32-bit integers
- *  Arithmetic overflow is prevented via __builtin_umul_overflow()
- *  @see: https://gcc.gnu.org/onlinedocs/gcc/Integer-Overflow-Builtins.html
- *
- *  Uses an iterative method to calculate the factorial of the argument.
- *  assign factorial the value 1
- *  loop with iterator from 1 to argument
- *    catch any potential arithmentic overflow
- *    factorial = factorial * iterator
- *  print result
- */
-void fact_u32(uint64_t val) {
-
-  uint32_t fv = 1;
-  bool overflow;
-  bool overflowed;
-  overflow = overflowed = false;;
-
-  for (uint32_t i_ = 1; i_ <= val ; ++i_) {
-    uint32_t intermediate;
-    overflow = __builtin_umul_overflow(fv, i_, &intermediate);
-    overflowed = overflowed ? overflowed : overflow;
-    fv = intermediate;
-    //fv = fv * i_;
-  }
-
-  printf("%6" PRIu64 "!: %20" PRIu32 " %s\n", val, fv, overflowed ? "*- overflow -*" : "");
-
-  return;
-}
-
-/*
- *  MARK: fact_s32()
- *
- *  Calculate val! using signed 32-bit integers
- *  Arithmetic overflow is prevented via __builtin_smul_overflow()
- *  @see: https://gcc.gnu.org/onlinedocs/gcc/Integer-Overflow-Builtins.html
- *
- *  Uses an iterative method to calculate the factorial of the argument.
- *  assign factorial the value 1
- *  loop with iterator from 1 to argument
- *    catch any potential arithmentic overflow
- *    factorial = factorial * iterator
- *  print result
- */
-void fact_s32(uint64_t val) {
-  
-  int32_t fv = 1;
-  bool overflow;
-  bool overflowed;
-  overflow = overflowed = false;;
-
-  for (int32_t i_ = 1; i_ <= val ; ++i_) {
-    int32_t intermediate;
-    overflow = __builtin_smul_overflow(fv, i_, &intermediate);
-    overflowed = overflowed ? overflowed : overflow;
-    fv = intermediate;
-    //fv = fv * i_;
-  }
-
-  printf("%6" PRIu64 "!: %20" PRId32 " %s\n", val, fv, overflowed ? "*- overflow -*" : "");
-
-  return;
-}
+//  MARK: <--> Fixed width implementations
+//  fact_u32() ... fact_s128() are FixedWidthFactorial<Bits, Signed> in factorial_fixed.cpp.
 
 //  MARK: <--> 64-bit implementations
-/*
- *  MARK: fact_u64()
- *
- *  Calculate val! using unsigned 64-bit integers
- *  Arithmetic overflow is prevented via __builtin_umulll_overflow()
- *  @see: https://gcc.gnu.org/onlinedocs/gcc/Integer-Overflow-Builtins.html
- *
- *  Uses an iterative method to calculate the factorial of the argument.
- *  assign factorial the value 1
- *  loop with iterator from 1 to argument
- *    catch any potential arithmentic overflow
- *    factorial = factorial * iterator
- *  print result
- */
-void fact_u64(uint64_t val) {
-
-  uint64_t fv = 1;
-  bool overflow;
-  bool overflowed;
-  overflow = overflowed = false;;
-
-  for (uint64_t i_ = 1; i_ <= val ; ++i_) {
-    uint64_t intermediate;
-    overflow = __builtin_umulll_overflow(fv, i_, &intermediate);
-    overflowed = overflowed ? overflowed : overflow;
-    fv = intermediate;
-    // fv = fv * i_;
-  }
-
-  printf("%6" PRIu64 "!: %20" PRIu64 " %s\n", val, fv, overflowed ? "*- overflow -*" : "");
-
-  return;
-}
-
 /*
  *  MARK: fact_u64_unrolled()
  *
@@ -608,8 +1658,11 @@ void fact_u64_unrolled(uint64_t val) {
       overflowed = true;
       break;
   }
+  STATS_COUNT(STATS_MULTIPLICATIONS, ix - 1);
+  STATS_COUNT(STATS_LIMB_OPS, ix - 1);
 
-  printf("%6" PRIu64 "!: %20" PRIu64 " %s\n", val, fv, overflowed ? "*- overflow -*" : "");
+  int pc = printf("%6" PRIu64 "!: %20" PRIu64 " %s\n", val, fv, overflowed ? "*- overflow -*" : "");
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
 
   return;
 }
@@ -663,154 +1716,140 @@ void fact_u64_tabular(uint64_t val) {
     *oflow = true;
   }
   
-  printf("%6" PRIu64 "!: %20" PRIu64 " %s\n", val, fv, overflow ? "*- overflow -*" : "");
+  int pc = printf("%6" PRIu64 "!: %20" PRIu64 " %s\n", val, fv, overflow ? "*- overflow -*" : "");
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
 
   return;
 }
 
+//  MARK: <--> BigNum (multiple precision) implementations
 /*
- *  MARK: fact_s64()
+ *  MARK: fact_gmp()
  *
- *  Calculate val! using signed 64-bit integers.
- *  Arithmetic overflow is prevented via __builtin_smulll_overflow()
- *  @see: https://gcc.gnu.org/onlinedocs/gcc/Integer-Overflow-Builtins.html
+ *  Calculate val! using GNU Multiple Precision Aritmetic Library (GMP)
+ *  @see: https://gmplib.org/manual/index.html#Top
  *
  *  Uses an iterative method to calculate the factorial of the argument.
- *  assign factorial the value 1
- *  loop with iterator from 1 to argument
- *    catch any potential arithmentic overflow
- *    factorial = factorial * iterator
+ *  assign factorial the value 1, word the value 1
+ *  loop with iterator from 2 to argument
+ *    if word * iterator overflows a machine word
+ *      factorial = factorial * word, word = 1
+ *    word = word * iterator
+ *  factorial = factorial * word
  *  print result
+ *  @see: gmp_mul_range() in factorial_gmp.c
  */
-void fact_s64(uint64_t val) {
-  
-  int64_t fv = 1;
-  bool overflow;
-  bool overflowed;
-  overflow = overflowed = false;;
+void fact_gmp(uint64_t val) {
 
-  for (int64_t i_ = 1; i_ <= val ; ++i_) {
-    int64_t intermediate;
-    overflow = __builtin_smulll_overflow(fv, i_, &intermediate);
-    overflowed = overflowed ? overflowed : overflow;
-    fv = intermediate;
-    // fv = fv * i_;
-  }
+  mpz_t pf;
 
-  printf("%6" PRIu64 "!: %20" PRId64 " %s\n", val, fv, overflowed ? "*- overflow -*" : "");
+  mpz_init_set_ui(pf, 1);
+  gmp_mul_range(pf, 2, val, false);
+
+  int pc = gmp_printf("%6" PRIu64 "!: %20Zd\n", val, pf);
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+  mpz_clear(pf);
 
   return;
 }
 
-//  MARK: <--> 128-bit implementations
 /*
- *  MARK: fact_u128()
- *
- *  Calculate val! using unsigned 128-bit integers
+ *  MARK: fact_gmp_tree()
  *
- *  Uses an iterative method to calculate the factorial of the argument.
- *  assign factorial the value 1
- *  loop with iterator from 1 to argument
- *    catch any potential arithmentic overflow
- *    factorial = factorial * iterator
- *  print result
+ *  Calculate val! using GMP with a balanced product tree, checkpointed
+ *  when --checkpoint is given.
+ *  @see: factorial_gmp.c, factorial_checkpoint.c
  */
-void fact_u128(uint64_t val) {
+void fact_gmp_tree(uint64_t val) {
 
-  static size_t const nrstr_l = 41;
-  static size_t pwidth_max = 0;
+  mpz_t pf;
 
-  uint128_t fv;
-  bool overflow;
-  bool overflowed;
+  mpz_init(pf);
+  if (checkpoint_dir == NULL || !checkpoint_fact(pf, val, checkpoint_dir, CHECKPOINT_TREE)) {
+    gmp_fact_tree(pf, val);
+  }
+  int pc = gmp_printf("%6" PRIu64 "!: %20Zd\n", val, pf);
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+  mpz_clear(pf);
 
-  fv = 1;
-  overflowed = false;;
+  return;
+}
 
-  for (uint64_t i_ = 1; i_ <= val ; ++i_) {
-    uint128_t intermediate;
-    overflow = umulj_overflow(fv, i_, &intermediate);
-    overflowed = overflowed ? overflowed : overflow;
-    fv = intermediate;
-  }
+/*
+ *  MARK: fact_gmp_swing()
+ *
+ *  Calculate val! using GMP's mpz_fac_ui() (prime swing).
+ */
+void fact_gmp_swing(uint64_t val) {
 
-  char * nrstr;
+  mpz_t pf;
 
-  nrstr = malloc(nrstr_l);
-  nrstr = uint128toa(fv, nrstr, nrstr_l);
-  printf_fact128str(val, &nrstr, overflowed, &pwidth_max);
-  free(nrstr);
+  mpz_init(pf);
+  gmp_fact_swing(pf, val);
+  int pc = gmp_printf("%6" PRIu64 "!: %20Zd\n", val, pf);
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+  mpz_clear(pf);
 
   return;
 }
 
 /*
- *  MARK: fact_s128()
+ *  MARK: fact_gmp_odd()
  *
- *  Calculate val! using signed 128-bit integers.
- *
- *  Uses an iterative method to calculate the factorial of the argument.
- *  assign factorial the value 1
- *  loop with iterator from 1 to argument
- *    catch any potential arithmentic overflow
- *    factorial = factorial * iterator
- *  print result
+ *  Calculate val! using GMP one odd part of a factor at a time and a final shift.
+ *  @see: factorial_gmp.c
  */
-void fact_s128(uint64_t val) {
-  
-  static size_t const nrstr_l = 41;
-  static size_t pwidth_max = 0;
+void fact_gmp_odd(uint64_t val) {
 
-  int128_t fv;
-  bool overflow;
-  bool overflowed;
+  mpz_t pf;
 
-  fv = 1;
-  overflowed = false;;
+  mpz_init(pf);
+  gmp_fact_odd_linear(pf, val);
+  int pc = gmp_printf("%6" PRIu64 "!: %20Zd\n", val, pf);
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+  mpz_clear(pf);
 
-  for (int64_t i_ = 1; i_ <= val ; ++i_) {
-    int128_t intermediate;
-    overflow = smulj_overflow(fv, i_, &intermediate);
-    overflowed = overflowed ? overflowed : overflow;
-    fv = intermediate;
-  }
+  return;
+}
+
+/*
+ *  MARK: fact_gmp_odd_tree()
+ *
+ *  Calculate val! using GMP with a balanced product tree of the odd parts and a final shift.
+ *  @see: factorial_gmp.c
+ */
+void fact_gmp_odd_tree(uint64_t val) {
 
-  char * nrstr;
+  mpz_t pf;
 
-  nrstr = malloc(nrstr_l);
-  nrstr = int128toa(fv, nrstr, nrstr_l);
-  printf_fact128str(val, &nrstr, overflowed, &pwidth_max);
-  free(nrstr);
+  mpz_init(pf);
+  gmp_fact_odd_tree(pf, val);
+  int pc = gmp_printf("%6" PRIu64 "!: %20Zd\n", val, pf);
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+  mpz_clear(pf);
 
   return;
 }
 
-//  MARK: <--> BigNum (multiple precision) implementations
 /*
- *  MARK: fact_gmp()
- *
- *  Calculate val! using GNU Multiple Precision Aritmetic Library (GMP)
- *  @see: https://gmplib.org/manual/index.html#Top
+ *  MARK: fact_gmp_procs()
  *
- *  Uses an iterative method to calculate the factorial of the argument.
- *  assign factorial the value 1
- *  loop with iterator from 1 to argument
- *    factorial = factorial * iterator
- *  print result
+ *  Calculate val! using GMP in --procs worker processes.
+ *  @see: factorial_procs.c
  */
-void fact_gmp(uint64_t val) {
+bool fact_gmp_procs(uint64_t val) {
 
   mpz_t pf;
 
-  mpz_init_set_ui(pf, 1);
-  for (size_t i_ = 1; i_ <= val; ++i_) {
-    mpz_mul_ui(pf, pf, i_);
+  mpz_init(pf);
+  bool computed = procs_fact(pf, val, procs_count);
+  if (computed) {
+    int pc = gmp_printf("%6" PRIu64 "!: %20Zd\n", val, pf);
+    STATS_COUNT(STATS_BYTES_FORMATTED, pc);
   }
-
-  gmp_printf("%6" PRIu64 "!: %20Zd\n", val, pf);
   mpz_clear(pf);
 
-  return;
+  return computed;
 }
 
 //  MARK: <--> floating point implementations
@@ -829,9 +1868,11 @@ void fact_float(uint64_t val) {
 
   for (uint64_t i_ = 1; i_ <= val ; ++i_) {
     fv = fv * i_;
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
   }
 
-  printf("%6" PRIu64 "!: %20.0f\n", val, fv);
+  int pc = printf("%6" PRIu64 "!: %20.0f\n", val, fv);
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
 
   return;
 }
@@ -851,9 +1892,11 @@ void fact_double(uint64_t val) {
 
   for (uint64_t i_ = 1; i_ <= val ; ++i_) {
     fv = fv * i_;
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
   }
 
-  printf("%6" PRIu64 "!: %20.0lf\n", val, fv);
+  int pc = printf("%6" PRIu64 "!: %20.0lf\n", val, fv);
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
 
   return;
 }
@@ -873,86 +1916,198 @@ void fact_longdouble(uint64_t val) {
 
   for (uint64_t i_ = 1; i_ <= val ; ++i_) {
     fv = fv * i_;
+    STATS_COUNT(STATS_MULTIPLICATIONS, 1);
   }
 
-  printf("%6" PRIu64 "!: %20.0Lf\n", val, fv);
+  int pc = printf("%6" PRIu64 "!: %20.0Lf\n", val, fv);
+  STATS_COUNT(STATS_BYTES_FORMATTED, pc);
 
   return;
 }
 
-//  MARK: - Utilities and Helper Functions -
 /*
- *  MARK: umulj_overflow()
+ *  MARK: fact_float_gamma()
  *
- *  Check overflow multiplication for unsigned 128-bit integers
+ *  Rows nbegin! to nend! in the format of fact_float(), each value Γ(n + 1) from
+ *  the batched gamma function instead of a product over 1 to n.
+ *  @see: factorial_gamma.c
+ */
+void fact_float_gamma(uint64_t nbegin, uint64_t nend) {
+
+  enum { BATCH = 256, };
+  float x[BATCH];
+  float fv[BATCH];
+
+  for (uint64_t nb = nbegin; nb <= nend && nb >= nbegin; nb += BATCH) {
+    size_t count = nend - nb < BATCH ? (size_t) (nend - nb + 1) : BATCH;
+    for (size_t i_ = 0; i_ < count; ++i_) {
+      x[i_] = (float) (nb + i_ + 1);
+    }
+    gamma_tgammaf_batch(x, fv, count);
+    for (size_t i_ = 0; i_ < count; ++i_) {
+      memprof_row(nb + i_);
+      int pc = printf("%6" PRIu64 "!: %20.0f\n", nb + i_, fv[i_]);
+      STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: fact_double_gamma()
  *
- *  Basic algorithm:
- *  get product as multiplication of multiplicand with multiplier
- *  get quotient as division of product with multiplicand
- *  compare quotient to multiplier - if not equal, overflow occured!
- *  return outcome of comparison
+ *  Rows nbegin! to nend! in the format of fact_double(), each value Γ(n + 1) from
+ *  the batched gamma function instead of a product over 1 to n.
+ *  @see: factorial_gamma.c
  */
-bool umulj_overflow(uint128_t multiplicand, uint128_t multiplier, uint128_t * product) {
-
-  /*
-   *  TODO: Formal terms used in equations:
-   *  addition:       augend        + addend      = sum
-   *  subtraction:    subtrahend    - minuend     = differnce
-   *  multiplication: multiplicand  x multiplier  = product
-   *  division:       dividend      ÷ divisor     = quotient
-   */
-  bool overflow;
-  if (product != NULL) {
-    uint128_t _product;  // TODO: debugging
-    uint128_t quotient;
-    *product = _product = multiplicand * multiplier;
-    quotient = _product / multiplicand;
-    overflow = (multiplicand != 0 && quotient != multiplier) ? true : false;
+void fact_double_gamma(uint64_t nbegin, uint64_t nend) {
+
+  enum { BATCH = 256, };
+  double x[BATCH];
+  double fv[BATCH];
+
+  for (uint64_t nb = nbegin; nb <= nend && nb >= nbegin; nb += BATCH) {
+    size_t count = nend - nb < BATCH ? (size_t) (nend - nb + 1) : BATCH;
+    for (size_t i_ = 0; i_ < count; ++i_) {
+      x[i_] = (double) (nb + i_ + 1);
+    }
+    gamma_tgamma_batch(x, fv, count);
+    for (size_t i_ = 0; i_ < count; ++i_) {
+      memprof_row(nb + i_);
+      int pc = printf("%6" PRIu64 "!: %20.0lf\n", nb + i_, fv[i_]);
+      STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+    }
+  }
+
+  return;
+}
+
+//  MARK: <--> Fused rows
+/*
+ *  MARK: row_fixed()
+ *
+ *  The row of the native width engine "bits", is_signed for val!: from the fused
+ *  sweep when it holds val, else by fact().
+ *  @see: factorial_fused.c
+ */
+void row_fixed(void (* fact)(uint64_t), unsigned bits, bool is_signed, uint64_t val) {
+
+  fused_row const * row = fused_lookup(val);
+
+  if (row == NULL) {
+    fact(val);
   }
   else {
-    //  TODO: better reporting of NULL pointer
-    overflow = true;
+    fact_fixed_row(bits, is_signed, val, row->wrapped, row->bits > (is_signed ? bits - 1 : bits));
   }
 
-  return overflow;
+  return;
 }
 
 /*
- *  MARK: smulj_overflow()
+ *  MARK: row_u64_small()
  *
- *  Check overflow multiplication for signed 128-bit integers
+ *  The row of fact_u64_unrolled() and fact_u64_tabular(), which hold 1! to 20!,
+ *  for val!: from the fused sweep when it holds val, else by fact().
+ */
+void row_u64_small(void (* fact)(uint64_t), uint64_t val) {
+
+  fused_row const * row = fused_lookup(val);
+
+  if (row == NULL) {
+    fact(val);
+  }
+  else {
+    bool held = val >= 1 && val <= U64_EXACT_MAX;
+    int pc = printf("%6" PRIu64 "!: %20" PRIu64 " %s\n", val, held ? (uint64_t) row->wrapped : 0, held ? "" : "*- overflow -*");
+    STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: row_exact()
  *
- *  Basic algorithm:
- *  get product as multiplication of multiplicand with multiplier
- *  get quotient as division of product with multiplicand
- *  compare quotient to multiplier - if not equal, overflow occured!
- *  return outcome of comparison
+ *  The row of fact_gmp() and gfg_factorial() for val!: from the fused sweep when it
+ *  holds val, else by fact().
  */
-bool smulj_overflow(int128_t  multiplicand, int128_t  multiplier, int128_t * product) {
-
-  /*
-   *  TODO: Formal terms used in equations:
-   *  addition:       augend        + addend      = sum
-   *  subtraction:    subtrahend    - minuend     = differnce
-   *  multiplication: multiplicand  x multiplier  = product
-   *  division:       dividend      ÷ divisor     = quotient
-   */
-  bool overflow;
-  if (product != NULL) {
-    int128_t _product;   // TODO: debugging
-    int128_t quotient;
-    *product = _product = multiplicand * multiplier;
-    quotient = _product / multiplicand;
-    overflow = (multiplicand != 0 && quotient != multiplier) ? true : false;
+void row_exact(void (* fact)(uint64_t), uint64_t val) {
+
+  mpz_srcptr exact = fused_exact(val);
+
+  if (exact == NULL) {
+    fact(val);
+  }
+  else {
+    int pc = gmp_printf("%6" PRIu64 "!: %20Zd\n", val, exact);
+    STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: row_float() ... row_longdouble()
+ *
+ *  The row of fact_float() ... fact_longdouble() for val!: from the fused sweep when
+ *  it holds val, else by the iterative method. The fused row shows val! correctly
+ *  rounded, followed by the iterative product where rounding at each step made it
+ *  differ.
+ */
+void row_float(uint64_t val) {
+
+  fused_row const * row = fused_lookup(val);
+
+  if (row == NULL) {
+    fact_float(val);
+  }
+  else {
+    int pc = printf("%6" PRIu64 "!: %20.0f", val, row->flt);
+    pc += row->flt_iterative != row->flt ? printf(" *- iterative %.0f -*", row->flt_iterative) : 0;
+    pc += printf("\n");
+    STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+  }
+
+  return;
+}
+
+void row_double(uint64_t val) {
+
+  fused_row const * row = fused_lookup(val);
+
+  if (row == NULL) {
+    fact_double(val);
   }
   else {
-    //  TODO: better reporting of NULL pointer
-    overflow = true;
+    int pc = printf("%6" PRIu64 "!: %20.0lf", val, row->dbl);
+    pc += row->dbl_iterative != row->dbl ? printf(" *- iterative %.0lf -*", row->dbl_iterative) : 0;
+    pc += printf("\n");
+    STATS_COUNT(STATS_BYTES_FORMATTED, pc);
   }
 
-  return overflow;
+  return;
+}
+
+void row_longdouble(uint64_t val) {
+
+  fused_row const * row = fused_lookup(val);
+
+  if (row == NULL) {
+    fact_longdouble(val);
+  }
+  else {
+    int pc = printf("%6" PRIu64 "!: %20.0Lf", val, row->ldbl);
+    pc += row->ldbl_iterative != row->ldbl ? printf(" *- iterative %.0Lf -*", row->ldbl_iterative) : 0;
+    pc += printf("\n");
+    STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+  }
+
+  return;
 }
 
+//  MARK: - Utilities and Helper Functions -
 /*
  *  MARK: uint128toa()
  *
@@ -981,7 +2136,7 @@ char * uint128toa(uint128_t big, char * buffp, size_t const buff_len) {
       buffp[1] = '\0';
     }
     else {
-      char * str = malloc(buff_len * sizeof(char));
+      char * str = memprof_malloc(buff_len * sizeof(char));
       memset(str, 0, buff_len);
       char * next = str + buff_len - 1; // start at right most char.
       while (big != 0) {
@@ -989,7 +2144,7 @@ char * uint128toa(uint128_t big, char * buffp, size_t const buff_len) {
         big /= 10;                    // remove last digit
       }
       strncpy(buffp, next, buff_len);
-      free(str);
+      memprof_free(str);
     }
   }
 
@@ -1026,7 +2181,7 @@ char * int128toa(int128_t big, char * buffp, size_t const buff_len) {
       buffp[1] = '\0';
     }
     else {
-      char * str = malloc(buff_len * sizeof(char));
+      char * str = memprof_malloc(buff_len * sizeof(char));
       memset(str, 0, buff_len);
       char * next = str + buff_len - 1; // start at right most char.
       bgr.ui128 = big >= 0 ? big : ~big + 1;
@@ -1038,7 +2193,7 @@ char * int128toa(int128_t big, char * buffp, size_t const buff_len) {
         *--next = '-';
       }
       strncpy(buffp, next, buff_len);
-      free(str);
+      memprof_free(str);
     }
   }
 
@@ -1046,43 +2201,99 @@ char * int128toa(int128_t big, char * buffp, size_t const buff_len) {
 }
 
 /*
- *  MARK: printf_fact128str()
+ *  MARK: find_driver()
+ *
+ *  Look an engine up in the registry by name, with or without the "factorial_" prefix.
  */
-int printf_fact128str(uint64_t val, char ** pnrstr, bool overflowed, size_t * ppw_max) {
+driver const * find_driver(char const * name) {
+
+  static char const prefix[] = "factorial_";
+  driver const * found = NULL;
+
+  for (size_t d_ = 0; d_ < drivers_c && found == NULL; ++d_) {
+    char const * dname = drivers[d_].name;
+    if (strcmp(dname, name) == 0 || strcmp(dname + sizeof(prefix) - 1, name) == 0) {
+      found = &drivers[d_];
+    }
+  }
 
-  static size_t const nrstr_l = 41;
+  return found;
+}
+
+/*
+ *  MARK: list_drivers()
+ */
+void list_drivers(FILE * out) {
 
-  int pc;
-  char * nrstr;
-  size_t pwidth_max;
-  size_t pwidth_next;
+  fprintf(out, "Engines:\n");
+  for (size_t d_ = 0; d_ < drivers_c; ++d_) {
+    if (drivers[d_].standard) {
+      fprintf(out, "  %-28s (default run)\n", drivers[d_].name);
+    }
+    else {
+      fprintf(out, "  %s\n", drivers[d_].name);
+    }
+  }
 
-  nrstr = *pnrstr;
-  if (nrstr != NULL) {
-    pwidth_max = *ppw_max;
-      pwidth_next = strlen(nrstr);
+  return;
+}
 
-      if (pwidth_next < pwidth_max) {
-        char * strwork;
-        char * here;
+/*
+ *  MARK: select_drivers()
+ *
+ *  Fill "selected" from a comma separated list of engine names, in the order given.
+ *  A NULL spec selects the standard drivers.
+ *  Returns the number of drivers selected, 0 on error.
+ */
+size_t select_drivers(char const * spec, driver const ** selected, size_t selected_l) {
 
-        strwork = calloc(nrstr_l, sizeof(char));
-        here = strwork;
-        for (size_t n_ = 0; n_ < pwidth_max - pwidth_next; ++n_) {
-          *here++ = ' ';
-        }
-        strcpy(here, nrstr);
-        free(nrstr);
+  size_t selected_c = 0;
 
-        *pnrstr = nrstr = strwork;
+  if (spec == NULL) {
+    for (size_t d_ = 0; d_ < drivers_c && selected_c < selected_l; ++d_) {
+      if (drivers[d_].standard) {
+        selected[selected_c++] = &drivers[d_];
+      }
+    }
+  }
+  else {
+    char * names = strdup(spec);
+    char * save = NULL;
+    bool ok = names != NULL;
+
+    for (char * name = strtok_r(names, ",", &save); ok && name != NULL; name = strtok_r(NULL, ",", &save)) {
+      driver const * found = find_driver(name);
+      if (found == NULL) {
+        fprintf(stderr, "unknown engine \"%s\" (--engine list shows the engines)\n", name);
+        ok = false;
       }
-      *ppw_max = strlen(nrstr);
-      pc = printf("%6" PRIu64 "!: %20s %s\n",
-                  val, nrstr, overflowed ? "*- overflow -*" : "");
+      else if (selected_c < selected_l) {
+        selected[selected_c++] = found;
+      }
+    }
+    free(names);
+    selected_c = ok ? selected_c : 0;
+  }
+
+  return selected_c;
+}
+
+/*
+ *  MARK: gmp_fact_from_scratch()
+ *
+ *  val! by the GMP engine the crossovers select for it.
+ */
+void gmp_fact_from_scratch(mpz_t result, uint64_t val) {
+
+  if (val < auto_crossovers.linear_to_tree) {
+    gmp_fact_linear(result, val);
+  }
+  else if (val < auto_crossovers.tree_to_swing) {
+    gmp_fact_tree(result, val);
   }
   else {
-    pc = printf("%6" PRIu64 "!: %20s %s\n", val, "NullPointerException", "");
+    gmp_fact_swing(result, val);
   }
-  
-  return pc;
+
+  return;
 }
@@ -0,0 +1,394 @@
+//
+//  factorial_stats.c
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://man7.org/linux/man-pages/man2/perf_event_open.2.html
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "factorial_stats.h"
+
+//  MARK: - Definition of typedef, union, structure, etc.
+enum stats_hw_counter {
+  STATS_HW_CYCLES = 0,
+  STATS_HW_INSTRUCTIONS,
+  STATS_HW_CACHE_MISSES,
+  STATS_HW_BRANCH_MISSES,
+  STATS_HW_COUNTER_COUNT,
+};
+
+//  MARK: struct stats_record
+struct stats_record {
+  char const * engine;
+  uint64_t     nbegin;
+  uint64_t     nend;
+  uint64_t     wall_ns;
+  unsigned     workers;
+  bool         hw_valid[STATS_HW_COUNTER_COUNT];
+  uint64_t     hw[STATS_HW_COUNTER_COUNT];
+  uint64_t     sw[STATS_COUNTER_COUNT];
+};
+typedef struct stats_record stats_record;
+
+//  MARK: - Static data
+#ifdef FACTORIAL_STATS
+uint64_t stats_counters[STATS_COUNTER_COUNT];
+#endif
+
+static char const * const hw_names[STATS_HW_COUNTER_COUNT] = {
+  "cycles", "instructions", "cache_misses", "branch_misses",
+};
+static char const * const sw_names[STATS_COUNTER_COUNT] = {
+  "multiplications", "limb_ops", "bytes_formatted",
+};
+
+static bool stats_on = false;
+static unsigned stats_worker_count = 1;
+static FILE * stats_csv = NULL;
+static int hw_fd[STATS_HW_COUNTER_COUNT] = { -1, -1, -1, -1, };
+static uint64_t hw_base[STATS_HW_COUNTER_COUNT];
+static stats_record * records = NULL;
+static size_t records_c = 0;
+static stats_record current;
+static struct timespec current_start;
+
+//  MARK: - Prototypes
+static void hw_open(void);
+static void hw_start(void);
+static void hw_stop(stats_record * rec);
+
+//  MARK: - Implementation
+/*
+ *  MARK: stats_open()
+ *
+ *  Enable statistics collection.
+ *  If csv_path is not NULL each driver's record is also appended to that file
+ *  as a line of comma separated values.
+ */
+bool stats_open(char const * csv_path) {
+
+  bool ok = true;
+
+  stats_on = true;
+  hw_open();
+
+  if (csv_path != NULL) {
+    stats_csv = fopen(csv_path, "w");
+    if (stats_csv == NULL) {
+      perror(csv_path);
+      ok = false;
+    }
+    else {
+      fprintf(stats_csv, "engine,nbegin,nend,wall_ns");
+      for (size_t c_ = 0; c_ < STATS_HW_COUNTER_COUNT; ++c_) {
+        fprintf(stats_csv, ",%s", hw_names[c_]);
+      }
+      for (size_t c_ = 0; c_ < STATS_COUNTER_COUNT; ++c_) {
+        fprintf(stats_csv, ",%s", sw_names[c_]);
+      }
+      fprintf(stats_csv, ",workers\n");
+    }
+  }
+
+  return ok;
+}
+
+/*
+ *  MARK: stats_enabled()
+ */
+bool stats_enabled(void) {
+
+  return stats_on;
+}
+
+/*
+ *  MARK: stats_workers()
+ *
+ *  Record the number of worker processes or threads the following engines run on.
+ */
+void stats_workers(unsigned workers) {
+
+  stats_worker_count = workers;
+
+  return;
+}
+
+/*
+ *  MARK: stats_begin()
+ *
+ *  Reset the counters and start measuring the named engine.
+ */
+void stats_begin(char const * engine, uint64_t nbegin, uint64_t nend) {
+
+  if (stats_on) {
+    memset(&current, 0, sizeof(current));
+    current.engine = engine;
+    current.nbegin = nbegin;
+    current.nend = nend;
+    current.workers = stats_worker_count;
+#ifdef FACTORIAL_STATS
+    for (size_t c_ = 0; c_ < STATS_COUNTER_COUNT; ++c_) {
+      __atomic_store_n(&stats_counters[c_], 0, __ATOMIC_RELAXED);
+    }
+#endif
+    clock_gettime(CLOCK_MONOTONIC, &current_start);
+    hw_start();
+  }
+
+  return;
+}
+
+/*
+ *  MARK: stats_end()
+ *
+ *  Stop measuring, keep the record for the summary and emit it to the CSV file.
+ */
+void stats_end(void) {
+
+  if (stats_on) {
+    struct timespec stop;
+
+    hw_stop(&current);
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+    current.wall_ns = (uint64_t) (stop.tv_sec - current_start.tv_sec) * 1000000000ULL
+                    + (uint64_t) stop.tv_nsec - (uint64_t) current_start.tv_nsec;
+#ifdef FACTORIAL_STATS
+    for (size_t c_ = 0; c_ < STATS_COUNTER_COUNT; ++c_) {
+      current.sw[c_] = __atomic_load_n(&stats_counters[c_], __ATOMIC_RELAXED);
+    }
+#endif
+
+    stats_record * grown = realloc(records, (records_c + 1) * sizeof(*records));
+    if (grown != NULL) {
+      records = grown;
+      records[records_c++] = current;
+    }
+
+    if (stats_csv != NULL) {
+      fprintf(stats_csv, "%s,%" PRIu64 ",%" PRIu64 ",%" PRIu64,
+              current.engine, current.nbegin, current.nend, current.wall_ns);
+      for (size_t c_ = 0; c_ < STATS_HW_COUNTER_COUNT; ++c_) {
+        if (current.hw_valid[c_]) {
+          fprintf(stats_csv, ",%" PRIu64, current.hw[c_]);
+        }
+        else {
+          fputc(',', stats_csv);
+        }
+      }
+      for (size_t c_ = 0; c_ < STATS_COUNTER_COUNT; ++c_) {
+#ifdef FACTORIAL_STATS
+        fprintf(stats_csv, ",%" PRIu64, current.sw[c_]);
+#else
+        fputc(',', stats_csv);
+#endif
+      }
+      fprintf(stats_csv, ",%u\n", current.workers);
+      fflush(stats_csv);
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: stats_summary()
+ *
+ *  Display a table of the collected per-engine records.
+ *  Counters which are not available on this host (or not compiled in) show as "-".
+ */
+void stats_summary(FILE * out) {
+
+  if (!stats_on) {
+    return;
+  }
+
+  fprintf(out, "Engine statistics:\n\n");
+  fprintf(out, "%-24s %14s", "engine", "wall_ns");
+  for (size_t c_ = 0; c_ < STATS_HW_COUNTER_COUNT; ++c_) {
+    fprintf(out, " %14s", hw_names[c_]);
+  }
+  fprintf(out, " %10s", "IPC");
+  for (size_t c_ = 0; c_ < STATS_COUNTER_COUNT; ++c_) {
+    fprintf(out, " %16s", sw_names[c_]);
+  }
+  fputc('\n', out);
+
+  for (size_t r_ = 0; r_ < records_c; ++r_) {
+    stats_record const * rec = &records[r_];
+
+    fprintf(out, "%-24s %14" PRIu64, rec->engine, rec->wall_ns);
+    for (size_t c_ = 0; c_ < STATS_HW_COUNTER_COUNT; ++c_) {
+      if (rec->hw_valid[c_]) {
+        fprintf(out, " %14" PRIu64, rec->hw[c_]);
+      }
+      else {
+        fprintf(out, " %14s", "-");
+      }
+    }
+    if (rec->hw_valid[STATS_HW_CYCLES] && rec->hw_valid[STATS_HW_INSTRUCTIONS]
+        && rec->hw[STATS_HW_CYCLES] != 0) {
+      fprintf(out, " %10.3f", (double) rec->hw[STATS_HW_INSTRUCTIONS] / (double) rec->hw[STATS_HW_CYCLES]);
+    }
+    else {
+      fprintf(out, " %10s", "-");
+    }
+    for (size_t c_ = 0; c_ < STATS_COUNTER_COUNT; ++c_) {
+#ifdef FACTORIAL_STATS
+      fprintf(out, " %16" PRIu64, rec->sw[c_]);
+#else
+      fprintf(out, " %16s", "-");
+#endif
+    }
+    fputc('\n', out);
+  }
+  fputc('\n', out);
+
+  return;
+}
+
+/*
+ *  MARK: stats_close()
+ */
+void stats_close(void) {
+
+  if (stats_csv != NULL) {
+    fclose(stats_csv);
+    stats_csv = NULL;
+  }
+#if defined(__linux__)
+  for (size_t c_ = 0; c_ < STATS_HW_COUNTER_COUNT; ++c_) {
+    if (hw_fd[c_] >= 0) {
+      close(hw_fd[c_]);
+      hw_fd[c_] = -1;
+    }
+  }
+#endif
+  free(records);
+  records = NULL;
+  records_c = 0;
+  stats_on = false;
+
+  return;
+}
+
+/*
+ *  MARK: stats_seconds()
+ *
+ *  Seconds on the monotonic clock, for timing the stages of a run.
+ */
+double stats_seconds(void) {
+
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (double) ts.tv_sec + (double) ts.tv_nsec * 1.0e-9;
+}
+
+//  MARK: - Hardware counters
+/*
+ *  MARK: hw_open()
+ *
+ *  Open one perf event per hardware counter for this process (user space only).
+ *  Each counter is opened independently so that a counter the PMU or the
+ *  perf_event_paranoid setting refuses does not take the others with it.
+ *  The events are inherited, so that the threads and processes the drivers start
+ *  afterwards (--async, --procs, the pipeline, archive and digest workers) are
+ *  counted with the calling thread: stats_open() runs before any of them exists.
+ */
+static void hw_open(void) {
+
+#if defined(__linux__)
+  static uint64_t const configs[STATS_HW_COUNTER_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+  };
+
+  for (size_t c_ = 0; c_ < STATS_HW_COUNTER_COUNT; ++c_) {
+    struct perf_event_attr pea;
+
+    memset(&pea, 0, sizeof(pea));
+    pea.type = PERF_TYPE_HARDWARE;
+    pea.size = sizeof(pea);
+    pea.config = configs[c_];
+    pea.disabled = 1;
+    pea.exclude_kernel = 1;
+    pea.exclude_hv = 1;
+    pea.inherit = 1;
+    hw_fd[c_] = (int) syscall(SYS_perf_event_open, &pea, 0, -1, -1, 0);
+  }
+  if (hw_fd[STATS_HW_CYCLES] < 0) {
+    fprintf(stderr, "perf_event_open: hardware counters unavailable on this host\n");
+  }
+#endif
+
+  return;
+}
+
+/*
+ *  MARK: hw_start()
+ *
+ *  A reset does not clear what exited threads and processes have added to an
+ *  inherited event, so the value at the start is kept and subtracted at the end.
+ */
+static void hw_start(void) {
+
+#if defined(__linux__)
+  for (size_t c_ = 0; c_ < STATS_HW_COUNTER_COUNT; ++c_) {
+    if (hw_fd[c_] >= 0) {
+      ioctl(hw_fd[c_], PERF_EVENT_IOC_RESET, 0);
+      if (read(hw_fd[c_], &hw_base[c_], sizeof(hw_base[c_])) != sizeof(hw_base[c_])) {
+        hw_base[c_] = 0;
+      }
+      ioctl(hw_fd[c_], PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+
+  return;
+}
+
+/*
+ *  MARK: hw_stop()
+ */
+static void hw_stop(stats_record * rec) {
+
+#if defined(__linux__)
+  for (size_t c_ = 0; c_ < STATS_HW_COUNTER_COUNT; ++c_) {
+    if (hw_fd[c_] >= 0) {
+      uint64_t value;
+
+      ioctl(hw_fd[c_], PERF_EVENT_IOC_DISABLE, 0);
+      if (read(hw_fd[c_], &value, sizeof(value)) == sizeof(value)) {
+        rec->hw[c_] = value - hw_base[c_];
+        rec->hw_valid[c_] = true;
+      }
+    }
+  }
+#else
+  (void) rec;
+#endif
+
+  return;
+}
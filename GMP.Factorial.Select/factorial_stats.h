@@ -0,0 +1,63 @@
+//
+//  factorial_stats.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Opt-in per-engine statistics.
+//  Hardware counters (cycles, instructions, cache misses, branch misses) are read via
+//  Linux perf_event_open(2) around each driver when --stats is given on the command line.
+//  Software counters (multiplications, limb operations, bytes formatted) are only
+//  compiled in when FACTORIAL_STATS is defined; otherwise STATS_COUNT() evaluates the
+//  amount and discards it. Worker threads count too, so the additions are atomic
+//  (relaxed: only the totals matter, read once the workers are idle or joined).
+//
+
+#pragma once
+#ifndef factorial_stats_h
+#define factorial_stats_h
+
+#ifdef __cplusplus
+#include <cstdio>
+#include <cstdint>
+#else
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Software counters
+enum stats_counter {
+  STATS_MULTIPLICATIONS = 0,
+  STATS_LIMB_OPS,
+  STATS_BYTES_FORMATTED,
+  STATS_COUNTER_COUNT,
+};
+
+#ifdef FACTORIAL_STATS
+extern uint64_t stats_counters[STATS_COUNTER_COUNT];
+# define STATS_COUNT(counter, amount) ((void) __atomic_fetch_add(&stats_counters[(counter)], (uint64_t) (amount), __ATOMIC_RELAXED))
+#else
+# define STATS_COUNT(counter, amount) ((void) (amount))
+#endif
+
+//  MARK: - Prototypes
+bool stats_open(char const * csv_path);
+bool stats_enabled(void);
+void stats_workers(unsigned workers);
+void stats_begin(char const * engine, uint64_t nbegin, uint64_t nend);
+void stats_end(void);
+void stats_summary(FILE * out);
+void stats_close(void);
+double stats_seconds(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_stats_h */
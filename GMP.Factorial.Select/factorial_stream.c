@@ -0,0 +1,228 @@
+//
+//  factorial_stream.c
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://gmplib.org/manual/Radix-to-Binary (and Binary to Radix)
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <gmp.h>
+
+#include "factorial_stream.h"
+#include "factorial_gmp.h"
+#include "factorial_procs.h"
+#include "factorial_checkpoint.h"
+#include "factorial_stats.h"
+#include "factorial_memprof.h"
+
+//  Numbers below 10^SMALL_DIGITS are written by gmp_fprintf() with the %20Zd field of fact_gmp().
+#define SMALL_DIGITS 20
+
+//  MARK: - Prototypes
+static bool write_leaf(FILE * out, mpz_srcptr num, bool pad);
+static bool write_level(FILE * out, mpz_srcptr num, mpz_t const powers[], size_t level, bool pad);
+
+//  MARK: - Implementation
+/*
+ *  MARK: stream_mpz_decimal()
+ *
+ *  Write num (>= 0) in decimal to out, most significant digit first.
+ *
+ *  num is split by the largest power 10^(STREAM_LEAF_DIGITS * 2^k) at or below its square root;
+ *  the quotient is written (recursively), then the remainder zero-padded to
+ *  STREAM_LEAF_DIGITS * 2^k digits. Besides num itself the powers table and the quotients
+ *  and remainders along the current path are live, a few times the size of num in all,
+ *  instead of num plus its full decimal string.
+ */
+bool stream_mpz_decimal(FILE * out, mpz_srcptr num) {
+
+  bool written;
+  mpz_t powers[STREAM_POWERS_MAX];
+  size_t powers_c = stream_powers(powers, num);
+
+  if (powers_c == 0) {
+    written = write_leaf(out, num, false);
+  }
+  else {
+    written = write_level(out, num, (mpz_t const *) powers, powers_c - 1, false);
+  }
+  for (size_t p_ = 0; p_ < powers_c; ++p_) {
+    mpz_clear(powers[p_]);
+  }
+
+  return written;
+}
+
+/*
+ *  MARK: stream_factorials_gmp()
+ *
+ *  Write the factorials nbegin! to nend! to out, one row per n in the format of fact_gmp().
+ *  The first row is computed by "procs" worker processes when that is more than one,
+ *  by a checkpointed product tree when checkpoint_dir is given, and otherwise by
+ *  prime swing; the rest incrementally.
+ */
+bool stream_factorials_gmp(FILE * out, uint64_t nbegin, uint64_t nend, unsigned procs, char const * checkpoint_dir) {
+
+  bool written = true;
+  mpz_t pf;
+
+  mpz_init(pf);
+  for (uint64_t nb = nbegin; written && nb <= nend; ++nb) {
+    memprof_row(nb);
+    if (nb == nbegin && procs > 1) {
+      written = procs_fact(pf, nb, procs);
+    }
+    else if (nb == nbegin && checkpoint_dir != NULL) {
+      written = checkpoint_fact(pf, nb, checkpoint_dir, CHECKPOINT_TREE);
+    }
+    else if (nb == nbegin) {
+      gmp_fact_swing(pf, nb);
+    }
+    else {
+      mpz_mul_ui(pf, pf, nb);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      STATS_COUNT(STATS_LIMB_OPS, mpz_size(pf));
+    }
+
+    written = written && stream_factorial_row(out, nb, pf);
+  }
+  mpz_clear(pf);
+
+  return written;
+}
+
+/*
+ *  MARK: stream_factorial_row()
+ *
+ *  Write the row for val! = pf in the format of fact_gmp().
+ */
+bool stream_factorial_row(FILE * out, uint64_t val, mpz_srcptr pf) {
+
+  bool written;
+
+  if (mpz_sizeinbase(pf, 10) <= SMALL_DIGITS) {
+    int pc = gmp_fprintf(out, "%6" PRIu64 "!: %20Zd\n", val, pf);
+    STATS_COUNT(STATS_BYTES_FORMATTED, pc);
+    written = pc > 0;
+  }
+  else {
+    int pc = fprintf(out, "%6" PRIu64 "!: ", val);
+    STATS_COUNT(STATS_BYTES_FORMATTED, pc + mpz_sizeinbase(pf, 10) + 1);
+    written = pc > 0 && stream_mpz_decimal(out, pf) && putc('\n', out) != EOF;
+  }
+
+  return written;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: stream_powers()
+ *
+ *  Also used by the digests in factorial_digest.c.
+ *  powers[k] = 10^(STREAM_LEAF_DIGITS * 2^k) for every k with powers[k]^2 not far above num.
+ *  Returns the number of powers; num < powers[last]^2 always holds, and there are none
+ *  when num fits a single leaf.
+ */
+size_t stream_powers(mpz_t powers[], mpz_srcptr num) {
+
+  size_t powers_c = 0;
+  size_t num_bits = mpz_sizeinbase(num, 2);
+
+  if (mpz_sizeinbase(num, 10) > STREAM_LEAF_DIGITS) {
+    mpz_init(powers[0]);
+    mpz_ui_pow_ui(powers[0], 10, STREAM_LEAF_DIGITS);
+    powers_c = 1;
+    while (powers_c < STREAM_POWERS_MAX) {
+      mpz_srcptr last = powers[powers_c - 1];
+      if (num_bits <= 2 * (mpz_sizeinbase(last, 2) - 1)) {
+        break;
+      }
+      mpz_init(powers[powers_c]);
+      mpz_mul(powers[powers_c], last, last);
+      STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+      if (mpz_cmp(num, powers[powers_c]) < 0) {
+        mpz_clear(powers[powers_c]);
+        break;
+      }
+      ++powers_c;
+    }
+  }
+
+  return powers_c;
+}
+
+/*
+ *  MARK: write_leaf()
+ *
+ *  Write num (< 10^STREAM_LEAF_DIGITS), zero-padded to STREAM_LEAF_DIGITS digits if pad is set.
+ */
+static bool write_leaf(FILE * out, mpz_srcptr num, bool pad) {
+
+  static char buffer[STREAM_LEAF_DIGITS + 2];
+  bool written = true;
+
+  if (pad || mpz_sgn(num) != 0) {
+    mpz_get_str(buffer, 10, num);
+    size_t digits = strlen(buffer);
+    if (pad && mpz_sgn(num) == 0) {
+      digits = 0;
+    }
+    for (size_t z_ = digits; pad && z_ < STREAM_LEAF_DIGITS; ++z_) {
+      written = written && putc('0', out) != EOF;
+    }
+    written = written && fwrite(buffer, 1, digits, out) == digits;
+  }
+  else {
+    written = putc('0', out) != EOF;
+  }
+
+  return written;
+}
+
+/*
+ *  MARK: write_level()
+ *
+ *  Write num (< powers[level]^2), zero-padded to STREAM_LEAF_DIGITS * 2^(level + 1) digits
+ *  if pad is set. An unpadded number below powers[level] skips straight to the next level.
+ */
+static bool write_level(FILE * out, mpz_srcptr num, mpz_t const powers[], size_t level, bool pad) {
+
+  bool written;
+
+  if (!pad && mpz_cmp(num, powers[level]) < 0) {
+    written = level == 0 ? write_leaf(out, num, false) : write_level(out, num, powers, level - 1, false);
+  }
+  else {
+    mpz_t quotient;
+    mpz_t remainder;
+
+    mpz_init(quotient);
+    mpz_init(remainder);
+    mpz_tdiv_qr(quotient, remainder, num, powers[level]);
+    STATS_COUNT(STATS_LIMB_OPS, mpz_size(num));
+    if (level == 0) {
+      written = write_leaf(out, quotient, pad);
+      mpz_clear(quotient);
+      written = written && write_leaf(out, remainder, true);
+    }
+    else {
+      written = write_level(out, quotient, powers, level - 1, pad);
+      mpz_clear(quotient);
+      written = written && write_level(out, remainder, powers, level - 1, true);
+    }
+    mpz_clear(remainder);
+  }
+
+  return written;
+}
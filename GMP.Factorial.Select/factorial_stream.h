@@ -0,0 +1,44 @@
+//
+//  factorial_stream.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Bounded-memory decimal output of very large factorials.
+//  The decimal expansion is written most significant digits first, straight to
+//  a stream, by divide-and-conquer on powers of ten; the whole string is never
+//  held in memory.
+//
+
+#pragma once
+#ifndef factorial_stream_h
+#define factorial_stream_h
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+//  Decimal digits converted by each mpz_get_str() at the leaves of the recursion.
+#define STREAM_LEAF_DIGITS 4096
+//  Enough powers 10^(STREAM_LEAF_DIGITS * 2^k) for numbers of 2^64 digits.
+#define STREAM_POWERS_MAX 64
+
+//  MARK: - Prototypes
+size_t stream_powers(mpz_t powers[], mpz_srcptr num);
+bool stream_mpz_decimal(FILE * out, mpz_srcptr num);
+bool stream_factorial_row(FILE * out, uint64_t val, mpz_srcptr pf);
+bool stream_factorials_gmp(FILE * out, uint64_t nbegin, uint64_t nend, unsigned procs, char const * checkpoint_dir);
+bool stream_factorials_gfg(FILE * out, uint64_t nbegin, uint64_t nend);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_stream_h */
@@ -0,0 +1,303 @@
+//
+//  factorial_verify.c
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  The primes are drawn afresh from /dev/urandom for every run, so an engine cannot be
+//  wrong in a way that happens to agree with them. n! mod p comes from
+//  modtable_mul_range(), the candidate from mpn_mod_1() over its limbs or from
+//  modtable_horner_decimal() over its digits as they are read; neither is ever
+//  converted. Decimal files hold rows in the format of fact_gmp() and --output,
+//  "n!: digits" one to a line, with the leading spaces of either.
+//
+
+//  MARK: - Definitions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <gmp.h>
+
+#include "factorial_verify.h"
+#include "factorial_modtable.h"
+#include "factorial_stats.h"
+
+//  Bytes read from a decimal file at a time.
+#define VERIFY_BUFFER (1 << 20)
+
+//  MARK: - Prototypes
+static void factorial_residues(verifier * vf, uint64_t n);
+static bool check_residues(verifier * vf, FILE * out, uint64_t n, uint64_t const residues[]);
+
+// MARK: - Implementation
+/*
+ *  MARK: verify_init()
+ *
+ *  Draw VERIFY_PRIMES distinct random primes of VERIFY_PRIME_BITS bits.
+ *  Returns false, having reported why, if there is no source of randomness.
+ */
+bool verify_init(verifier * vf) {
+
+  FILE * urandom = fopen("/dev/urandom", "rb");
+
+  memset(vf, 0, sizeof(*vf));
+  if (urandom == NULL) {
+    perror("/dev/urandom");
+    return false;
+  }
+  for (unsigned k_ = 0; k_ < VERIFY_PRIMES; ) {
+    uint64_t draw;
+    if (fread(&draw, sizeof(draw), 1, urandom) != 1) {
+      perror("/dev/urandom");
+      fclose(urandom);
+      return false;
+    }
+    uint64_t candidate = (draw & ((UINT64_C(1) << VERIFY_PRIME_BITS) - 1)) | (UINT64_C(1) << (VERIFY_PRIME_BITS - 1)) | 1;
+    bool fresh = modtable_is_prime(candidate);
+    for (unsigned j_ = 0; fresh && j_ < k_; ++j_) {
+      fresh = vf->primes[j_] != candidate;
+    }
+    if (fresh) {
+      vf->primes[k_++] = candidate;
+    }
+  }
+  fclose(urandom);
+
+  vf->n = 0;
+  for (unsigned k_ = 0; k_ < VERIFY_PRIMES; ++k_) {
+    vf->fact[k_] = 1;
+  }
+
+  return true;
+}
+
+/*
+ *  MARK: verify_mpz()
+ *
+ *  Check candidate against n!, and display the row for it on out.
+ */
+bool verify_mpz(verifier * vf, FILE * out, uint64_t n, mpz_srcptr candidate) {
+
+  uint64_t residues[VERIFY_PRIMES];
+
+  for (unsigned k_ = 0; k_ < VERIFY_PRIMES; ++k_) {
+    residues[k_] = mpz_fdiv_ui(candidate, vf->primes[k_]);
+  }
+  STATS_COUNT(STATS_LIMB_OPS, VERIFY_PRIMES * mpz_size(candidate));
+
+  return check_residues(vf, out, n, residues);
+}
+
+/*
+ *  MARK: verify_limbs_file()
+ *
+ *  Check the file at path, native limbs least significant first as written by
+ *  --output --limbs, against n!.
+ */
+bool verify_limbs_file(verifier * vf, FILE * out, uint64_t n, char const * path) {
+
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  uint64_t residues[VERIFY_PRIMES] = { 0, };
+
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    perror(path);
+    if (fd >= 0) {
+      close(fd);
+    }
+    return false;
+  }
+  if (st.st_size == 0 || st.st_size % (off_t) sizeof(mp_limb_t) != 0) {
+    fprintf(stderr, "%s: %lld bytes is not a whole number of limbs\n", path, (long long) st.st_size);
+    close(fd);
+    return false;
+  }
+
+  size_t limbs = (size_t) st.st_size / sizeof(mp_limb_t);
+  void * map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    perror(path);
+    return false;
+  }
+  for (unsigned k_ = 0; k_ < VERIFY_PRIMES; ++k_) {
+    residues[k_] = mpn_mod_1((mp_limb_t const *) map, (mp_size_t) limbs, vf->primes[k_]);
+  }
+  STATS_COUNT(STATS_LIMB_OPS, VERIFY_PRIMES * limbs);
+  munmap(map, (size_t) st.st_size);
+
+  return check_residues(vf, out, n, residues);
+}
+
+/*
+ *  MARK: verify_decimal_file()
+ *
+ *  Check every row "n!: digits" of the file at path ("-" for standard input) against
+ *  n!. Returns false if a row differs, if there is none or if the file is not rows.
+ */
+bool verify_decimal_file(verifier * vf, FILE * out, char const * path) {
+
+  enum { ROW_START, ROW_N, ROW_COLON, ROW_GAP, ROW_DIGITS, } state = ROW_START;
+  FILE * in = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+  char * buffer = malloc(VERIFY_BUFFER);
+  uint64_t residues[VERIFY_PRIMES];
+  uint64_t n = 0;
+  uint64_t line = 1;
+  bool matched = true;
+  bool malformed = false;
+  size_t got;
+
+  if (in == NULL || buffer == NULL) {
+    perror(path);
+    if (in != NULL && in != stdin) {
+      fclose(in);
+    }
+    free(buffer);
+    return false;
+  }
+
+  while (!malformed && (got = fread(buffer, 1, VERIFY_BUFFER, in)) > 0) {
+    for (size_t b_ = 0; !malformed && b_ < got; ) {
+      char ch = buffer[b_];
+      switch (state) {
+        case ROW_START:
+          if (ch >= '0' && ch <= '9') {
+            n = 0;
+            state = ROW_N;
+          }
+          else {
+            malformed = ch != ' ' && ch != '\n';
+            line += ch == '\n';
+            ++b_;
+          }
+          break;
+
+        case ROW_N:
+          if (ch >= '0' && ch <= '9') {
+            n = n * 10 + (uint64_t) (ch - '0');
+            ++b_;
+          }
+          else {
+            malformed = ch != '!';
+            state = ROW_COLON;
+            ++b_;
+          }
+          break;
+
+        case ROW_COLON:
+          malformed = ch != ':';
+          memset(residues, 0, sizeof(residues));
+          state = ROW_GAP;
+          ++b_;
+          break;
+
+        case ROW_GAP:
+          if (ch == ' ') {
+            ++b_;
+          }
+          else {
+            malformed = ch < '0' || ch > '9';
+            state = ROW_DIGITS;
+          }
+          break;
+
+        case ROW_DIGITS: {
+          size_t run = b_;
+          while (run < got && buffer[run] >= '0' && buffer[run] <= '9') {
+            ++run;
+          }
+          modtable_horner_decimal(buffer + b_, run - b_, vf->primes, VERIFY_PRIMES, residues);
+          b_ = run;
+          if (b_ < got) {
+            malformed = buffer[b_] != '\n';
+            if (!malformed) {
+              matched = check_residues(vf, out, n, residues) && matched;
+              state = ROW_START;
+              ++line;
+              ++b_;
+            }
+          }
+          break;
+        }
+      }
+    }
+  }
+  //  The last row may have no newline.
+  if (!malformed && state == ROW_DIGITS) {
+    matched = check_residues(vf, out, n, residues) && matched;
+  }
+  else if (!malformed && state != ROW_START) {
+    malformed = true;
+  }
+  if (malformed) {
+    fprintf(stderr, "%s:%" PRIu64 ": not a row \"n!: digits\"\n", path, line);
+  }
+  if (ferror(in)) {
+    perror(path);
+    malformed = true;
+  }
+  if (in != stdin) {
+    fclose(in);
+  }
+  free(buffer);
+
+  return matched && !malformed && vf->rows > 0;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: factorial_residues()
+ *
+ *  vf->fact = n! mod the primes, extending the last n checked when n is not below it.
+ */
+static void factorial_residues(verifier * vf, uint64_t n) {
+
+  if (n < vf->n) {
+    vf->n = 0;
+    for (unsigned k_ = 0; k_ < VERIFY_PRIMES; ++k_) {
+      vf->fact[k_] = 1;
+    }
+  }
+  if (n > vf->n) {
+    modtable_mul_range(vf->n + 1, n, vf->primes, VERIFY_PRIMES, vf->fact);
+    vf->n = n;
+  }
+
+  return;
+}
+
+/*
+ *  MARK: check_residues()
+ */
+static bool check_residues(verifier * vf, FILE * out, uint64_t n, uint64_t const residues[]) {
+
+  bool matched = true;
+
+  factorial_residues(vf, n);
+  for (unsigned k_ = 0; k_ < VERIFY_PRIMES; ++k_) {
+    matched = matched && residues[k_] == vf->fact[k_];
+  }
+  ++vf->rows;
+  if (matched) {
+    fprintf(out, "%6" PRIu64 "!: verified\n", n);
+  }
+  else {
+    ++vf->mismatches;
+    fprintf(out, "%6" PRIu64 "!: *- mismatch -*", n);
+    for (unsigned k_ = 0; k_ < VERIFY_PRIMES; ++k_) {
+      fprintf(out, " %20" PRIu64 " %20" PRIu64, residues[k_], vf->fact[k_]);
+    }
+    fputc('\n', out);
+  }
+
+  return matched;
+}
@@ -0,0 +1,57 @@
+//
+//  factorial_verify.h
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Modular fingerprints of computed factorials.
+//  A candidate for n! is reduced mod a few random 61-bit primes and compared with n!
+//  mod the same primes, which costs n Montgomery multiplications per prime and one
+//  pass over the candidate: its limbs, or its decimal digits 19 at a time. A wrong
+//  candidate c passes only if every prime divides c - n!, which has fewer than
+//  log2(c - n!) / 60 prime factors of 61 bits among the ~2^55 such primes.
+//
+
+#pragma once
+#ifndef factorial_verify_h
+#define factorial_verify_h
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <gmp.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//  MARK: - Definitions
+#define VERIFY_PRIMES     4
+#define VERIFY_PRIME_BITS 61
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct verifier
+//  The primes, and n! mod each of them for the last n checked (so that ascending rows
+//  extend it instead of starting again).
+struct verifier {
+  uint64_t primes[VERIFY_PRIMES];
+  uint64_t n;
+  uint64_t fact[VERIFY_PRIMES];
+  uint64_t rows;
+  uint64_t mismatches;
+};
+typedef struct verifier verifier;
+
+//  MARK: - Prototypes
+bool verify_init(verifier * vf);
+bool verify_mpz(verifier * vf, FILE * out, uint64_t n, mpz_srcptr candidate);
+bool verify_limbs_file(verifier * vf, FILE * out, uint64_t n, char const * path);
+bool verify_decimal_file(verifier * vf, FILE * out, char const * path);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* factorial_verify_h */
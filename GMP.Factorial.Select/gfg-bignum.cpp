@@ -0,0 +1,624 @@
+//
+//  gfg-bignum.cpp
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://en.wikipedia.org/wiki/Karatsuba_algorithm
+//  @see: https://en.wikipedia.org/wiki/Toom–Cook_multiplication
+//  @see: M. Bodrato, "Towards Optimal Toom-Cook Multiplication for Univariate and
+//        Multivariate Polynomials in Characteristic 2 and 0", WAIFI 2007.
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Multiplication is schoolbook below KARATSUBA_THRESHOLD limbs, Karatsuba below
+//  TOOM3_THRESHOLD limbs, Toom-3 (evaluation points 0, 1, -1, -2, infinity) below
+//  NTT_THRESHOLD limbs and a three-prime NTT (gfg-ntt.cpp) above.
+//  Unbalanced operands are cut into pieces the size of the shorter one first.
+//  range_product() builds a balanced product tree so that the large multiplications
+//  are always between operands of similar size.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cinttypes>
+
+#include "gfg-bignum.hpp"
+#include "factorial_stats.h"
+
+namespace gfg {
+
+//  MARK: - Definition of typedef, union, structure, etc.
+//  MARK: struct snum
+//  Signed magnitude number used for the Toom-3 evaluation and interpolation.
+struct snum {
+  bool   neg;
+  bignum mag;
+};
+
+//  MARK: - Prototypes
+static void trim(bignum & num);
+static int compare(bignum const & lhs, bignum const & rhs);
+static bignum add(bignum const & lhs, bignum const & rhs);
+static void sub_in_place(bignum & lhs, bignum const & rhs);
+static void add_at(bignum & acc, bignum const & addend, size_t offset);
+static bignum slice(bignum const & num, size_t from, size_t count);
+static bignum mul_schoolbook(bignum const & lhs, bignum const & rhs);
+static bignum mul_karatsuba(bignum const & lhs, bignum const & rhs);
+static bignum mul_toom3(bignum const & lhs, bignum const & rhs);
+static bignum mul_unbalanced(bignum const & lhs, bignum const & rhs);
+static void mul_packed(bignum & product, uint64_t & word, uint64_t factor);
+static bignum coprime10_range_product(uint64_t lo, uint64_t hi, uint64_t & twos);
+static uint64_t legendre(uint64_t n_fact, uint64_t prime);
+static snum s_add(snum const & lhs, snum const & rhs);
+static snum s_sub(snum const & lhs, snum const & rhs);
+static snum s_mul(snum const & lhs, snum const & rhs);
+static void s_div_small(snum & num, uint32_t divisor);
+
+//  MARK: - Implementation
+/*
+ *  MARK: from_u64()
+ */
+bignum from_u64(uint64_t value) {
+
+  bignum num;
+  do {
+    num.push_back((uint32_t) (value % LIMB_BASE));
+    value /= LIMB_BASE;
+  } while (value != 0);
+
+  return num;
+}
+
+/*
+ *  MARK: mul_small()
+ *
+ *  num = num * multiplier, in place, for multiplier <= MUL_SMALL_MAX.
+ *  carry < multiplier, so limb * multiplier + carry < 10^9 * multiplier which fits in 64 bits.
+ */
+void mul_small(bignum & num, uint64_t multiplier) {
+
+  uint64_t carry = 0;
+
+  STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+  STATS_COUNT(STATS_LIMB_OPS, num.size());
+  for (size_t i_ = 0; i_ < num.size(); ++i_) {
+    uint64_t prod = (uint64_t) num[i_] * multiplier + carry;
+    num[i_] = (uint32_t) (prod % LIMB_BASE);
+    carry = prod / LIMB_BASE;
+  }
+  while (carry != 0) {
+    num.push_back((uint32_t) (carry % LIMB_BASE));
+    carry /= LIMB_BASE;
+  }
+  trim(num);
+
+  return;
+}
+
+/*
+ *  MARK: mul()
+ *
+ *  Multiply two numbers choosing the algorithm by operand size.
+ */
+bignum mul(bignum const & lhs, bignum const & rhs) {
+
+  bignum product;
+  size_t const small = std::min(lhs.size(), rhs.size());
+  size_t const large = std::max(lhs.size(), rhs.size());
+
+  if (small < KARATSUBA_THRESHOLD) {
+    product = mul_schoolbook(lhs, rhs);
+  }
+  else if (2 * small < large) {
+    product = mul_unbalanced(lhs, rhs);
+  }
+  else if (small < TOOM3_THRESHOLD) {
+    product = mul_karatsuba(lhs, rhs);
+  }
+  else if (small < NTT_THRESHOLD) {
+    product = mul_toom3(lhs, rhs);
+  }
+  else {
+    product = mul_ntt(lhs, rhs);
+  }
+
+  return product;
+}
+
+/*
+ *  MARK: range_product()
+ *
+ *  Product of the integers lo .. hi (1 for an empty range) via a balanced product tree.
+ */
+bignum range_product(uint64_t lo, uint64_t hi) {
+
+  static uint64_t const leaf_span = 16;
+  bignum product;
+
+  if (lo > hi) {
+    product = from_u64(1);
+  }
+  else if (hi - lo < leaf_span) {
+    uint64_t word = 1;
+    product = from_u64(1);
+    for (uint64_t i_ = lo; i_ <= hi; ++i_) {
+      mul_packed(product, word, i_);
+    }
+    if (word != 1) {
+      mul_small(product, word);
+    }
+  }
+  else {
+    uint64_t mid = lo + (hi - lo) / 2;
+    product = mul(range_product(lo, mid), range_product(mid + 1, hi));
+  }
+
+  return product;
+}
+
+/*
+ *  MARK: factorial()
+ */
+bignum factorial(uint64_t n_fact) {
+
+  return range_product(2, n_fact);
+}
+
+/*
+ *  MARK: factorial_stripped()
+ *
+ *  n_fact! without its trailing decimal zeros, which are returned in "zeros" to be
+ *  appended when formatting. There are as many zeros as factors 5 (Legendre's
+ *  formula), so every factor 5 and as many factors 2 are left out of the product.
+ */
+bignum factorial_stripped(uint64_t n_fact, uint64_t & zeros) {
+
+  zeros = legendre(n_fact, 5);
+  uint64_t twos = zeros;
+
+  return coprime10_range_product(2, n_fact, twos);
+}
+
+/*
+ *  MARK: decimal_digits()
+ */
+size_t decimal_digits(bignum const & num) {
+
+  size_t digits = (num.size() - 1) * LIMB_DIGITS;
+  uint32_t top = num.back();
+  do {
+    ++digits;
+    top /= 10;
+  } while (top != 0);
+
+  return digits;
+}
+
+/*
+ *  MARK: to_decimal()
+ *
+ *  Write the decimal representation of num to buffp, which must hold
+ *  decimal_digits(num) + 1 characters.
+ */
+char * to_decimal(bignum const & num, char * buffp) {
+
+  char * next = buffp + sprintf(buffp, "%" PRIu32, num.back());
+  for (size_t i_ = num.size() - 1; i_ > 0; --i_) {
+    uint32_t limb = num[i_ - 1];
+    for (size_t d_ = LIMB_DIGITS; d_ > 0; --d_) {
+      next[d_ - 1] = (char) ('0' + limb % 10);
+      limb /= 10;
+    }
+    next += LIMB_DIGITS;
+  }
+  *next = '\0';
+
+  return buffp;
+}
+
+//  MARK: - Helpers
+/*
+ *  MARK: trim()
+ *
+ *  Remove high order zero limbs, keeping at least one limb.
+ */
+static void trim(bignum & num) {
+
+  while (num.size() > 1 && num.back() == 0) {
+    num.pop_back();
+  }
+  if (num.empty()) {
+    num.push_back(0);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: compare()
+ */
+static int compare(bignum const & lhs, bignum const & rhs) {
+
+  if (lhs.size() != rhs.size()) {
+    return lhs.size() < rhs.size() ? -1 : 1;
+  }
+  for (size_t i_ = lhs.size(); i_ > 0; --i_) {
+    if (lhs[i_ - 1] != rhs[i_ - 1]) {
+      return lhs[i_ - 1] < rhs[i_ - 1] ? -1 : 1;
+    }
+  }
+
+  return 0;
+}
+
+/*
+ *  MARK: add()
+ */
+static bignum add(bignum const & lhs, bignum const & rhs) {
+
+  bignum sum(lhs);
+  add_at(sum, rhs, 0);
+
+  return sum;
+}
+
+/*
+ *  MARK: sub_in_place()
+ *
+ *  lhs = lhs - rhs, requires lhs >= rhs.
+ */
+static void sub_in_place(bignum & lhs, bignum const & rhs) {
+
+  int64_t borrow = 0;
+  for (size_t i_ = 0; i_ < lhs.size() && (i_ < rhs.size() || borrow != 0); ++i_) {
+    int64_t diff = (int64_t) lhs[i_] - (i_ < rhs.size() ? rhs[i_] : 0) - borrow;
+    borrow = diff < 0 ? 1 : 0;
+    lhs[i_] = (uint32_t) (diff + borrow * LIMB_BASE);
+  }
+  trim(lhs);
+
+  return;
+}
+
+/*
+ *  MARK: add_at()
+ *
+ *  acc = acc + addend * BASE^offset, in place.
+ */
+static void add_at(bignum & acc, bignum const & addend, size_t offset) {
+
+  if (acc.size() < offset + addend.size()) {
+    acc.resize(offset + addend.size(), 0);
+  }
+  uint32_t carry = 0;
+  size_t i_ = 0;
+  for (; i_ < addend.size(); ++i_) {
+    uint32_t sum = acc[offset + i_] + addend[i_] + carry;
+    carry = sum >= LIMB_BASE ? 1 : 0;
+    acc[offset + i_] = sum - carry * LIMB_BASE;
+  }
+  for (i_ += offset; carry != 0; ++i_) {
+    if (i_ == acc.size()) {
+      acc.push_back(0);
+    }
+    uint32_t sum = acc[i_] + carry;
+    carry = sum >= LIMB_BASE ? 1 : 0;
+    acc[i_] = sum - carry * LIMB_BASE;
+  }
+  trim(acc);
+
+  return;
+}
+
+/*
+ *  MARK: slice()
+ *
+ *  Limbs [from, from + count) of num, clipped to its size and trimmed.
+ */
+static bignum slice(bignum const & num, size_t from, size_t count) {
+
+  bignum part;
+  if (from < num.size()) {
+    size_t to = std::min(num.size(), from + count);
+    part.assign(num.begin() + from, num.begin() + to);
+  }
+  trim(part);
+
+  return part;
+}
+
+/*
+ *  MARK: mul_schoolbook()
+ *
+ *  Each step is at most (10^9 - 1)^2 + 2 * 10^9 which fits in 64 bits.
+ */
+static bignum mul_schoolbook(bignum const & lhs, bignum const & rhs) {
+
+  bignum product(lhs.size() + rhs.size(), 0);
+
+  STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+  STATS_COUNT(STATS_LIMB_OPS, lhs.size() * rhs.size());
+  for (size_t i_ = 0; i_ < lhs.size(); ++i_) {
+    uint64_t carry = 0;
+    uint64_t const multiplicand = lhs[i_];
+    if (multiplicand == 0) {
+      continue;
+    }
+    for (size_t j_ = 0; j_ < rhs.size(); ++j_) {
+      uint64_t prod = multiplicand * rhs[j_] + product[i_ + j_] + carry;
+      product[i_ + j_] = (uint32_t) (prod % LIMB_BASE);
+      carry = prod / LIMB_BASE;
+    }
+    product[i_ + rhs.size()] = (uint32_t) carry;
+  }
+  trim(product);
+
+  return product;
+}
+
+/*
+ *  MARK: mul_karatsuba()
+ *
+ *  (a1 B + a0)(b1 B + b0) = z2 B^2 + ((a0 + a1)(b0 + b1) - z2 - z0) B + z0
+ */
+static bignum mul_karatsuba(bignum const & lhs, bignum const & rhs) {
+
+  size_t const half = (std::max(lhs.size(), rhs.size()) + 1) / 2;
+  bignum a0 = slice(lhs, 0, half);
+  bignum a1 = slice(lhs, half, lhs.size());
+  bignum b0 = slice(rhs, 0, half);
+  bignum b1 = slice(rhs, half, rhs.size());
+
+  bignum z0 = mul(a0, b0);
+  bignum z2 = mul(a1, b1);
+  bignum z1 = mul(add(a0, a1), add(b0, b1));
+  sub_in_place(z1, z0);
+  sub_in_place(z1, z2);
+
+  bignum product(z0);
+  add_at(product, z1, half);
+  add_at(product, z2, 2 * half);
+
+  return product;
+}
+
+/*
+ *  MARK: mul_toom3()
+ *
+ *  Split each operand in three, evaluate at 0, 1, -1, -2 and infinity,
+ *  multiply pointwise and interpolate with Bodrato's sequence.
+ */
+static bignum mul_toom3(bignum const & lhs, bignum const & rhs) {
+
+  size_t const third = (std::max(lhs.size(), rhs.size()) + 2) / 3;
+  snum a[3];
+  snum b[3];
+  for (size_t i_ = 0; i_ < 3; ++i_) {
+    a[i_] = snum { false, slice(lhs, i_ * third, third), };
+    b[i_] = snum { false, slice(rhs, i_ * third, third), };
+  }
+
+  //  evaluation
+  snum pa = s_add(a[0], a[2]);
+  snum pb = s_add(b[0], b[2]);
+  snum a_p1 = s_add(pa, a[1]);
+  snum b_p1 = s_add(pb, b[1]);
+  snum a_m1 = s_sub(pa, a[1]);
+  snum b_m1 = s_sub(pb, b[1]);
+  snum a_m2 = s_sub(s_add(s_add(a_m1, a[2]), s_add(a_m1, a[2])), a[0]);
+  snum b_m2 = s_sub(s_add(s_add(b_m1, b[2]), s_add(b_m1, b[2])), b[0]);
+
+  //  pointwise multiplication
+  snum r0   = s_mul(a[0], b[0]);
+  snum r1   = s_mul(a_p1, b_p1);
+  snum r_m1 = s_mul(a_m1, b_m1);
+  snum r_m2 = s_mul(a_m2, b_m2);
+  snum rinf = s_mul(a[2], b[2]);
+
+  //  interpolation
+  snum r3 = s_sub(r_m2, r1);
+  s_div_small(r3, 3);
+  r1 = s_sub(r1, r_m1);
+  s_div_small(r1, 2);
+  snum r2 = s_sub(r_m1, r0);
+  r3 = s_sub(r2, r3);
+  s_div_small(r3, 2);
+  r3 = s_add(r3, s_add(rinf, rinf));
+  r2 = s_sub(s_add(r2, r1), rinf);
+  r1 = s_sub(r1, r3);
+
+  bignum product(r0.mag);
+  add_at(product, r1.mag, third);
+  add_at(product, r2.mag, 2 * third);
+  add_at(product, r3.mag, 3 * third);
+  add_at(product, rinf.mag, 4 * third);
+
+  return product;
+}
+
+/*
+ *  MARK: mul_unbalanced()
+ *
+ *  Cut the longer operand into pieces the size of the shorter one so that
+ *  every partial product is balanced.
+ */
+static bignum mul_unbalanced(bignum const & lhs, bignum const & rhs) {
+
+  bignum const & longer  = lhs.size() >= rhs.size() ? lhs : rhs;
+  bignum const & shorter = lhs.size() >= rhs.size() ? rhs : lhs;
+  size_t const piece = shorter.size();
+  bignum product(1, 0);
+
+  for (size_t from = 0; from < longer.size(); from += piece) {
+    add_at(product, mul(slice(longer, from, piece), shorter), from);
+  }
+
+  return product;
+}
+
+/*
+ *  MARK: mul_packed()
+ *
+ *  Multiply "factor" into the pending word, first flushing the word into product
+ *  when the two would exceed MUL_SMALL_MAX, so that each pass over product absorbs
+ *  as many factors as fit. The caller flushes the last word with mul_small().
+ */
+static void mul_packed(bignum & product, uint64_t & word, uint64_t factor) {
+
+  uint64_t packed;
+
+  if (factor > MUL_SMALL_MAX) {
+    product = mul(product, from_u64(factor));
+  }
+  else if (__builtin_mul_overflow(word, factor, &packed) || packed > MUL_SMALL_MAX) {
+    mul_small(product, word);
+    word = factor;
+  }
+  else {
+    word = packed;
+  }
+
+  return;
+}
+
+/*
+ *  MARK: coprime10_range_product()
+ *
+ *  Product of lo .. hi with the factors 5 removed from each, as range_product().
+ *  Factors 2 are removed too, in order from lo, until "twos" of them have been.
+ */
+static bignum coprime10_range_product(uint64_t lo, uint64_t hi, uint64_t & twos) {
+
+  static uint64_t const leaf_span = 16;
+  bignum product;
+
+  if (lo > hi) {
+    product = from_u64(1);
+  }
+  else if (hi - lo < leaf_span) {
+    uint64_t word = 1;
+    product = from_u64(1);
+    for (uint64_t i_ = lo; i_ <= hi; ++i_) {
+      uint64_t factor = i_;
+      while (factor % 5 == 0) {
+        factor /= 5;
+      }
+      uint64_t shift = std::min<uint64_t>(twos, (uint64_t) __builtin_ctzll(factor));
+      factor >>= shift;
+      twos -= shift;
+      mul_packed(product, word, factor);
+    }
+    if (word != 1) {
+      mul_small(product, word);
+    }
+  }
+  else {
+    uint64_t mid = lo + (hi - lo) / 2;
+    bignum lower = coprime10_range_product(lo, mid, twos);
+    product = mul(lower, coprime10_range_product(mid + 1, hi, twos));
+  }
+
+  return product;
+}
+
+/*
+ *  MARK: legendre()
+ *
+ *  Exponent of "prime" in n_fact! by Legendre's formula.
+ */
+static uint64_t legendre(uint64_t n_fact, uint64_t prime) {
+
+  uint64_t exponent = 0;
+  for (uint64_t quot = n_fact / prime; quot != 0; quot /= prime) {
+    exponent += quot;
+  }
+
+  return exponent;
+}
+
+//  MARK: - Signed helpers
+/*
+ *  MARK: s_add()
+ */
+static snum s_add(snum const & lhs, snum const & rhs) {
+
+  snum sum;
+  if (lhs.neg == rhs.neg) {
+    sum = snum { lhs.neg, add(lhs.mag, rhs.mag), };
+  }
+  else if (compare(lhs.mag, rhs.mag) >= 0) {
+    sum = lhs;
+    sub_in_place(sum.mag, rhs.mag);
+  }
+  else {
+    sum = rhs;
+    sub_in_place(sum.mag, lhs.mag);
+  }
+  if (sum.mag.size() == 1 && sum.mag[0] == 0) {
+    sum.neg = false;
+  }
+
+  return sum;
+}
+
+/*
+ *  MARK: s_sub()
+ */
+static snum s_sub(snum const & lhs, snum const & rhs) {
+
+  snum negated = rhs;
+  negated.neg = !rhs.neg;
+
+  return s_add(lhs, negated);
+}
+
+/*
+ *  MARK: s_mul()
+ */
+static snum s_mul(snum const & lhs, snum const & rhs) {
+
+  snum product = { lhs.neg != rhs.neg, mul(lhs.mag, rhs.mag), };
+  if (product.mag.size() == 1 && product.mag[0] == 0) {
+    product.neg = false;
+  }
+
+  return product;
+}
+
+/*
+ *  MARK: s_div_small()
+ *
+ *  Exact division by a small divisor, in place.
+ */
+static void s_div_small(snum & num, uint32_t divisor) {
+
+  uint64_t rem = 0;
+  for (size_t i_ = num.mag.size(); i_ > 0; --i_) {
+    uint64_t cur = rem * LIMB_BASE + num.mag[i_ - 1];
+    num.mag[i_ - 1] = (uint32_t) (cur / divisor);
+    rem = cur % divisor;
+  }
+  trim(num.mag);
+
+  return;
+}
+
+/*
+ *  MARK: write_decimal()
+ *
+ *  Write num in decimal to out a limb at a time, most significant first,
+ *  without building the string.
+ */
+bool write_decimal(bignum const & num, FILE * out) {
+
+  bool written = fprintf(out, "%" PRIu32, num.back()) > 0;
+  for (size_t i_ = num.size() - 1; written && i_ > 0; --i_) {
+    written = fprintf(out, "%09" PRIu32, num[i_ - 1]) == (int) LIMB_DIGITS;
+  }
+
+  return written;
+}
+
+} /* namespace gfg */
@@ -0,0 +1,52 @@
+//
+//  gfg-bignum.hpp
+//  GMP.Factorial.Select
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Self-contained multiple precision arithmetic for the GMP-free engine.
+//  Numbers are held as little-endian limbs in base 10^9 so that the decimal
+//  representation falls straight out of the limbs without a base conversion.
+//
+
+#pragma once
+#ifndef gfg_bignum_hpp
+#define gfg_bignum_hpp
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+
+namespace gfg {
+
+//  MARK: - Definitions
+typedef std::vector<uint32_t> bignum;
+
+static uint32_t const LIMB_BASE = 1000000000U;
+static size_t const LIMB_DIGITS = 9;
+//  Largest multiplier for mul_small(): limb * multiplier + carry must fit in 64 bits.
+static uint64_t const MUL_SMALL_MAX = UINT64_MAX / LIMB_BASE;
+
+//  Operand sizes (in limbs) above which the faster multiplications take over.
+static size_t const KARATSUBA_THRESHOLD = 40;
+static size_t const TOOM3_THRESHOLD = 160;
+static size_t const NTT_THRESHOLD = 4000;
+
+//  MARK: - Prototypes
+bignum from_u64(uint64_t value);
+void mul_small(bignum & num, uint64_t multiplier);
+bignum mul(bignum const & lhs, bignum const & rhs);
+bignum mul_ntt(bignum const & lhs, bignum const & rhs);
+bignum range_product(uint64_t lo, uint64_t hi);
+bignum factorial(uint64_t n_fact);
+bignum factorial_stripped(uint64_t n_fact, uint64_t & zeros);
+size_t decimal_digits(bignum const & num);
+char * to_decimal(bignum const & num, char * buffp);
+bool write_decimal(bignum const & num, FILE * out);
+
+} /* namespace gfg */
+
+#endif /* gfg_bignum_hpp */
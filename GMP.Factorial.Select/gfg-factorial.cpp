@@ -89,9 +89,24 @@
  *
  * The above approach can be optimized in many ways. We will soon be discussing optimized
  * solution for same.
+ *
+ * get_factorial() no longer uses multiply(), and gfg_multiply(), its implementation, is
+ * gone: each step there passed over every digit of the result to absorb a single small
+ * factor, which made a factorial quadratic in its length. Instead the factors are multiplied in a balanced product tree of base 10^9
+ * bignums (gfg-bignum.cpp): schoolbook multiplication for small merges, Karatsuba and
+ * Toom-3 above their thresholds, and a three-prime NTT (gfg-ntt.cpp) for the largest.
+ *
+ * The original NEED_MAIN driver is gone: these functions now report to the stats,
+ * memprof and digest modules, so they only link as part of the program. The same
+ * output is "GMP.Factorial.Select --engine factorial_gfg 100 100".
  */
 
 #include "gfg-factorial.hpp"
+#include "gfg-bignum.hpp"
+#include "factorial_stats.h"
+#include "factorial_memprof.h"
+#include "factorial_stream.h"
+#include "factorial_digest.h"
 
 // C++ program to compute factorial of big numbers
 
@@ -99,13 +114,6 @@
 extern "C" {
 #endif
 
-// Maximum number of digits in output
-#ifdef NEED_MAX
-#define MAX NEED_MAX
-#else
-#define MAX 5000
-#endif
-
 /*
  *  MARK: gfg_factorial()
  *
@@ -116,84 +124,130 @@ void gfg_factorial(uint64_t n_fact) {
   char * szfactorial;
 
   szfactorial = get_factorial(n_fact);
-  std::string factorial(szfactorial);
-  std::cout << std::setw(6) << n_fact << "!: " << std::setw(20) << factorial << std::endl;
+  std::cout << std::setw(6) << n_fact << "!: " << std::setw(20) << szfactorial << std::endl;
+  STATS_COUNT(STATS_BYTES_FORMATTED, 6 + 3 + std::max<size_t>(20, strlen(szfactorial)) + 1);
 
-  free(szfactorial);
+  memprof_free(szfactorial);
 
   return;
 }
 
 /*
- *  MARK: get_factorial()
+ *  MARK: gfg_factorial_stripped()
+ *
+ *  As gfg_factorial(), but the product is formed without its trailing zeros, which
+ *  are appended to the digits only when formatting.
  */
-char * get_factorial(uint64_t n_fact) {
-  uint8_t res[MAX] = { 0, };
+void gfg_factorial_stripped(uint64_t n_fact) {
 
-  // Initialize result
-  res[0] = 1;
-  size_t res_size = 1;
+  uint64_t zeros;
+  gfg::bignum factorial = gfg::factorial_stripped(n_fact, zeros);
+  size_t digits = gfg::decimal_digits(factorial);
 
-  // Apply simple factorial formula n! = 1 * 2 * 3 * 4...*n
-  for (uint64_t x_ = 2; x_ <= n_fact; x_++) {
-    res_size = gfg_multiply(x_, res, res_size);
-  }
-
-  std::string factorial;
-  for (size_t i_ = res_size; i_ > 0; i_--) {
-    char c_to_insert;
-    c_to_insert = res[i_ - 1] + '0';
-    factorial += (c_to_insert);
-  }
+  char * szfactorial = (char *) memprof_malloc(digits + zeros + 1);
+  gfg::to_decimal(factorial, szfactorial);
+  memset(szfactorial + digits, '0', zeros);
+  szfactorial[digits + zeros] = '\0';
+  std::cout << std::setw(6) << n_fact << "!: " << std::setw(20) << szfactorial << std::endl;
+  STATS_COUNT(STATS_BYTES_FORMATTED, 6 + 3 + std::max<size_t>(20, digits + zeros) + 1);
 
-  size_t factorial_len = factorial.size() + 1;
-  char * fact_string = (char *) malloc(factorial_len);
-  strncpy(fact_string, factorial.c_str(), factorial_len);
+  memprof_free(szfactorial);
 
-  return fact_string;
+  return;
 }
 
 /*
- *  MARK: gfg_multiply()
+ *  MARK: get_factorial()
  *
- *  This function multiplies x with the number represented by res[].
- *  res_size is size of res[] or number of digits in the number represented by res[].
- *  This function uses simple school mathematics for multiplication.
- *  This function may value of res_size and returns the new value of res_size
+ *  Return the decimal representation of n_fact! in a string allocated with malloc().
  */
-size_t gfg_multiply(uint64_t x_multiplicand, uint8_t res[], size_t res_size) {
-  uint8_t carry = 0; // Initialize carry
+char * get_factorial(uint64_t n_fact) {
 
-  // One by one multiply n with individual digits of res[]
-  for (size_t i_ = 0; i_ < res_size; i_++) {
-    uint64_t prod = res[i_] * x_multiplicand + carry;
+  gfg::bignum factorial = gfg::factorial(n_fact);
 
-    // Store last digit of 'prod' in res[]
-    res[i_] = (prod % 10);
+  char * fact_string = (char *) memprof_malloc(gfg::decimal_digits(factorial) + 1);
+  gfg::to_decimal(factorial, fact_string);
 
-    // Put rest in carry
-    carry = prod / 10;
-  }
+  return fact_string;
+}
 
-  // Put carry in res and increase result size
-  while (carry) {
-    res[res_size] = (carry % 10);
-    carry = carry / 10;
-    res_size++;
+/*
+ *  MARK: stream_factorials_gfg()
+ *
+ *  Write the factorials nbegin! to nend! to out, one row per n in the format of gfg_factorial().
+ *  Each row after the first costs one small multiplication, and the limbs are written
+ *  directly, so no decimal string is built.
+ */
+bool stream_factorials_gfg(FILE * out, uint64_t nbegin, uint64_t nend) {
+
+  bool written = true;
+  gfg::bignum factorial;
+
+  for (uint64_t nb = nbegin; written && nb <= nend; ++nb) {
+    memprof_row(nb);
+    if (nb == nbegin) {
+      factorial = gfg::factorial(nb);
+    }
+    else if (nb <= gfg::MUL_SMALL_MAX) {
+      gfg::mul_small(factorial, nb);
+    }
+    else {
+      factorial = gfg::mul(factorial, gfg::from_u64(nb));
+    }
+
+    size_t digits = gfg::decimal_digits(factorial);
+    STATS_COUNT(STATS_BYTES_FORMATTED, 6 + 3 + std::max<size_t>(20, digits) + 1);
+    written = fprintf(out, "%6" PRIu64 "!: %*s", nb, (int) (digits < 20 ? 20 - digits : 0), "") > 0
+           && gfg::write_decimal(factorial, out)
+           && putc('\n', out) != EOF;
   }
 
-  return res_size;
+  return written;
 }
 
-#ifdef __cplusplus
+/*
+ *  MARK: digest_factorials_gfg()
+ *
+ *  Write a digest row for each of the factorials nbegin! to nend!, computed as by
+ *  stream_factorials_gfg(). The limbs are already decimal, so each is reduced as
+ *  its nine digits in turn, the top limb unpadded. Returns false if writing to out
+ *  failed.
+ */
+bool digest_factorials_gfg(FILE * out, uint64_t nbegin, uint64_t nend, unsigned fields) {
+
+  gfg::bignum factorial;
+
+  for (uint64_t nb = nbegin; !ferror(out) && nb <= nend; ++nb) {
+    memprof_row(nb);
+    if (nb == nbegin) {
+      factorial = gfg::factorial(nb);
+    }
+    else if (nb <= gfg::MUL_SMALL_MAX) {
+      gfg::mul_small(factorial, nb);
+    }
+    else {
+      factorial = gfg::mul(factorial, gfg::from_u64(nb));
+    }
+
+    digest dg;
+    char limb_digits[gfg::LIMB_DIGITS + 1];
+    digest_init(&dg, fields);
+    int top = snprintf(limb_digits, sizeof(limb_digits), "%" PRIu32, factorial.back());
+    digest_chars(&dg, limb_digits, (size_t) top);
+    for (size_t i_ = factorial.size() - 1; i_ > 0; --i_) {
+      uint32_t limb = factorial[i_ - 1];
+      for (size_t d_ = gfg::LIMB_DIGITS; d_ > 0; --d_) {
+        limb_digits[d_ - 1] = (char) ('0' + limb % 10);
+        limb /= 10;
+      }
+      digest_chars(&dg, limb_digits, gfg::LIMB_DIGITS);
+    }
+    digest_row(out, nb, &dg);
+  }
+
+  return !ferror(out);
 }
-#endif
 
-#ifdef NEED_MAIN
-// Driver program
-int main()
-{
-  gfg_factorial(100);
-  return 0;
+#ifdef __cplusplus
 }
 #endif
@@ -12,9 +12,11 @@
 
 #ifdef __cplusplus
 #include <iostream>
+#include <algorithm>
 #include <iomanip>
 #include <string>
 #include <cstdlib>
+#include <cstring>
 #include <cstdint>
 #include <cinttypes>
 #else
@@ -27,8 +29,8 @@
 extern "C" {
 #endif
 
-size_t gfg_multiply(uint64_t x_multiplicand, uint8_t res[], size_t res_size);
 void gfg_factorial(uint64_t n_fact);
+void gfg_factorial_stripped(uint64_t n_fact);
 char * get_factorial(uint64_t n_fact);
 
 #ifdef __cplusplus
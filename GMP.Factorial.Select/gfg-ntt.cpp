@@ -0,0 +1,393 @@
+//
+//  gfg-ntt.cpp
+//  GMP.Factorial.Select
+//
+//  MARK: - References
+//  @see: https://en.wikipedia.org/wiki/Schönhage–Strassen_algorithm
+//  @see: https://cp-algorithms.com/algebra/fft.html#number-theoretic-transform
+//  @see: P. L. Montgomery, "Modular Multiplication Without Trial Division",
+//        Mathematics of Computation 44 (1985).
+//  @see: H. L. Garner, "The Residue Number System", IRE Transactions EC-8 (1959).
+//
+//  Created by Alan Sampson on 10/18/26.
+//  Copyright © 2026 Alan @ FreeShell. All rights reserved.
+//
+//  Three-prime number theoretic transform multiplication for the largest merges
+//  of the GMP-free product tree.
+//
+//  Pairs of base 10^9 limbs are packed into base 10^18 coefficients (< 2^60).
+//  A convolution coefficient is then below N * 10^36 < 2^(120 + log2 N), which the
+//  three 62-bit primes (product > 2^185) recover exactly through Garner's CRT for any
+//  transform length the primes support (2^48).
+//
+//  The forward transform is decimation in frequency (natural order in, bit reversed
+//  out) and the inverse is decimation in time (bit reversed in, natural order out),
+//  so no permutation pass is needed. Twiddles are kept in one contiguous table per
+//  prime, roots[h + j] = w_2h^j, so every butterfly loop walks unit-stride arrays
+//  with no gathers. Stages whose span fits in NTT_BLOCK elements are run block by
+//  block, depth first, so the tail of the transform stays in cache.
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "gfg-bignum.hpp"
+#include "factorial_stats.h"
+
+namespace gfg {
+
+//  MARK: - Definitions
+typedef unsigned __int128 uint128_t;
+
+//  Elements per cache block: 2^14 * 8 bytes = 128 KiB, about the size of an L2 slice.
+static size_t const NTT_BLOCK = (size_t) 1 << 14;
+static uint64_t const COEFF_BASE = (uint64_t) LIMB_BASE * LIMB_BASE;
+
+//  MARK: struct ntt_prime
+//  p = c * 2^k + 1 with a primitive root g, and the Montgomery constants for R = 2^64.
+struct ntt_prime {
+  uint64_t p;
+  uint64_t g;
+  uint64_t pinv;    //  -p^-1 mod 2^64
+  uint64_t r2;      //  R^2 mod p
+};
+
+//  MARK: struct ntt_plan
+struct ntt_plan {
+  ntt_prime const * prime;
+  size_t n;
+  std::vector<uint64_t> roots;      //  Montgomery form, roots[h + j] = w_2h^j
+  std::vector<uint64_t> iroots;     //  Montgomery form, inverse roots
+};
+
+//  MARK: struct uint192
+struct uint192 {
+  uint64_t w[3];    //  little-endian words
+};
+
+//  MARK: - Prototypes
+static ntt_prime make_prime(uint64_t p, uint64_t g);
+static uint64_t pow_mod(uint64_t base, uint64_t exp, uint64_t p);
+static inline uint64_t mont_mul(uint64_t a, uint64_t b, ntt_prime const & pr);
+static inline uint64_t add_mod(uint64_t a, uint64_t b, uint64_t p);
+static inline uint64_t sub_mod(uint64_t a, uint64_t b, uint64_t p);
+static void make_plan(ntt_plan & plan, ntt_prime const * prime, size_t n);
+static void forward(ntt_plan const & plan, uint64_t * data);
+static void inverse(ntt_plan const & plan, uint64_t * data);
+static void transform(ntt_plan const & plan, std::vector<uint64_t> const & lhs,
+                      std::vector<uint64_t> const & rhs, std::vector<uint64_t> & out);
+static std::vector<uint64_t> pack(bignum const & num);
+
+//  MARK: - Static data
+static ntt_prime const primes[3] = {
+  make_prime(4601552919265804289ULL, 3),    //  4087 * 2^50 + 1
+  make_prime(4595360469778169857ULL, 5),    //  8163 * 2^49 + 1
+  make_prime(4585508845593296897ULL, 5),    // 16291 * 2^48 + 1
+};
+
+//  MARK: - Implementation
+/*
+ *  MARK: mul_ntt()
+ *
+ *  Multiply by three modular convolutions recombined with Garner's CRT.
+ */
+bignum mul_ntt(bignum const & lhs, bignum const & rhs) {
+
+  std::vector<uint64_t> a = pack(lhs);
+  std::vector<uint64_t> b = pack(rhs);
+  size_t const len = a.size() + b.size() - 1;
+  size_t n = 1;
+  while (n < len) {
+    n <<= 1;
+  }
+
+  STATS_COUNT(STATS_MULTIPLICATIONS, 1);
+  STATS_COUNT(STATS_LIMB_OPS, 3 * n);
+
+  std::vector<uint64_t> residue[3];
+  for (size_t p_ = 0; p_ < 3; ++p_) {
+    ntt_plan plan;
+    make_plan(plan, &primes[p_], n);
+    transform(plan, a, b, residue[p_]);
+  }
+
+  //  Garner: x = r0 + p0 * (t1 + p1 * t2)
+  uint64_t const p0 = primes[0].p;
+  uint64_t const p1 = primes[1].p;
+  uint64_t const p2 = primes[2].p;
+  uint64_t const inv_p0_p1 = pow_mod(p0 % p1, p1 - 2, p1);
+  uint64_t const inv_p0p1_p2 = pow_mod((uint64_t) ((uint128_t) p0 * p1 % p2), p2 - 2, p2);
+
+  bignum product(2 * len + 2, 0);
+  uint192 carry = { { 0, 0, 0, }, };
+  for (size_t i_ = 0; i_ < len || carry.w[0] != 0 || carry.w[1] != 0 || carry.w[2] != 0; ++i_) {
+    uint192 x = { { 0, 0, 0, }, };
+    if (i_ < len) {
+      uint64_t r0 = residue[0][i_];
+      uint64_t r1 = residue[1][i_];
+      uint64_t r2 = residue[2][i_];
+      uint64_t t1 = (uint64_t) ((uint128_t) sub_mod(r1, r0 % p1, p1) * inv_p0_p1 % p1);
+      uint64_t v  = (uint64_t) (((uint128_t) p0 % p2 * t1 + r0) % p2);
+      uint64_t t2 = (uint64_t) ((uint128_t) sub_mod(r2, v, p2) * inv_p0p1_p2 % p2);
+      uint128_t y = (uint128_t) p1 * t2 + t1;
+      uint128_t lo = (uint128_t) p0 * (uint64_t) y + r0;
+      uint128_t hi = (uint128_t) p0 * (uint64_t) (y >> 64) + (uint64_t) (lo >> 64);
+      x.w[0] = (uint64_t) lo;
+      x.w[1] = (uint64_t) hi;
+      x.w[2] = (uint64_t) (hi >> 64);
+    }
+
+    //  x += carry
+    uint128_t sum = 0;
+    for (size_t w_ = 0; w_ < 3; ++w_) {
+      sum += (uint128_t) x.w[w_] + carry.w[w_];
+      x.w[w_] = (uint64_t) sum;
+      sum >>= 64;
+    }
+
+    //  carry, coefficient = divmod(x, 10^18)
+    uint128_t rem = 0;
+    for (size_t w_ = 3; w_ > 0; --w_) {
+      uint128_t cur = (rem << 64) | x.w[w_ - 1];
+      carry.w[w_ - 1] = (uint64_t) (cur / COEFF_BASE);
+      rem = cur % COEFF_BASE;
+    }
+    if (2 * i_ + 1 >= product.size()) {
+      product.resize(2 * i_ + 2, 0);
+    }
+    product[2 * i_]     = (uint32_t) ((uint64_t) rem % LIMB_BASE);
+    product[2 * i_ + 1] = (uint32_t) ((uint64_t) rem / LIMB_BASE);
+  }
+  while (product.size() > 1 && product.back() == 0) {
+    product.pop_back();
+  }
+
+  return product;
+}
+
+//  MARK: - Modular arithmetic
+/*
+ *  MARK: make_prime()
+ */
+static ntt_prime make_prime(uint64_t p, uint64_t g) {
+
+  ntt_prime pr = { p, g, 0, 0, };
+
+  //  Newton iteration for p^-1 mod 2^64 (p odd: p * p = 1 mod 8 seeds 3 bits)
+  uint64_t inv = p;
+  for (size_t i_ = 0; i_ < 5; ++i_) {
+    inv *= 2 - p * inv;
+  }
+  pr.pinv = (uint64_t) 0 - inv;
+
+  uint128_t r = ((uint128_t) 1 << 64) % p;
+  pr.r2 = (uint64_t) (r * r % p);
+
+  return pr;
+}
+
+/*
+ *  MARK: pow_mod()
+ */
+static uint64_t pow_mod(uint64_t base, uint64_t exp, uint64_t p) {
+
+  uint64_t result = 1;
+  base %= p;
+  while (exp != 0) {
+    if (exp & 1) {
+      result = (uint64_t) ((uint128_t) result * base % p);
+    }
+    base = (uint64_t) ((uint128_t) base * base % p);
+    exp >>= 1;
+  }
+
+  return result;
+}
+
+/*
+ *  MARK: mont_mul()
+ *
+ *  a * b * R^-1 mod p, for a, b < p < 2^62.
+ */
+static inline uint64_t mont_mul(uint64_t a, uint64_t b, ntt_prime const & pr) {
+
+  uint128_t t = (uint128_t) a * b;
+  uint64_t m = (uint64_t) t * pr.pinv;
+  uint64_t u = (uint64_t) ((t + (uint128_t) m * pr.p) >> 64);
+
+  return u >= pr.p ? u - pr.p : u;
+}
+
+static inline uint64_t add_mod(uint64_t a, uint64_t b, uint64_t p) {
+
+  uint64_t s = a + b;
+  return s >= p ? s - p : s;
+}
+
+static inline uint64_t sub_mod(uint64_t a, uint64_t b, uint64_t p) {
+
+  return a >= b ? a - b : a + p - b;
+}
+
+//  MARK: - Transforms
+/*
+ *  MARK: make_plan()
+ */
+static void make_plan(ntt_plan & plan, ntt_prime const * prime, size_t n) {
+
+  uint64_t const p = prime->p;
+
+  plan.prime = prime;
+  plan.n = n;
+  plan.roots.assign(std::max<size_t>(n, 2), 0);
+  plan.iroots.assign(std::max<size_t>(n, 2), 0);
+  for (size_t h_ = 1; h_ < n; h_ <<= 1) {
+    uint64_t w = pow_mod(prime->g, (p - 1) / (2 * h_), p);
+    uint64_t iw = pow_mod(w, p - 2, p);
+    uint64_t wm = mont_mul(w, prime->r2, *prime);
+    uint64_t iwm = mont_mul(iw, prime->r2, *prime);
+    uint64_t cur = mont_mul(1, prime->r2, *prime);
+    uint64_t icur = cur;
+    for (size_t j_ = 0; j_ < h_; ++j_) {
+      plan.roots[h_ + j_] = cur;
+      plan.iroots[h_ + j_] = icur;
+      cur = mont_mul(cur, wm, *prime);
+      icur = mont_mul(icur, iwm, *prime);
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: forward()
+ *
+ *  Decimation in frequency. Large spans sweep the whole array, then each
+ *  cache block is finished on its own.
+ */
+static void forward(ntt_plan const & plan, uint64_t * data) {
+
+  ntt_prime const & pr = *plan.prime;
+  uint64_t const p = pr.p;
+  size_t const n = plan.n;
+  size_t const block = std::min(n, NTT_BLOCK);
+
+  auto stage = [&](uint64_t * base, size_t len, size_t h_) {
+    uint64_t const * w = &plan.roots[h_];
+    for (size_t s_ = 0; s_ < len; s_ += 2 * h_) {
+      uint64_t * lo = base + s_;
+      uint64_t * hi = lo + h_;
+      for (size_t j_ = 0; j_ < h_; ++j_) {
+        uint64_t u = lo[j_];
+        uint64_t v = hi[j_];
+        lo[j_] = add_mod(u, v, p);
+        hi[j_] = mont_mul(sub_mod(u, v, p), w[j_], pr);
+      }
+    }
+  };
+
+  size_t h_ = n / 2;
+  for (; h_ >= block / 2 && h_ > 0; h_ >>= 1) {
+    stage(data, n, h_);
+  }
+  for (size_t b_ = 0; b_ < n && h_ > 0; b_ += block) {
+    for (size_t hb = h_; hb > 0; hb >>= 1) {
+      stage(data + b_, block, hb);
+    }
+  }
+
+  return;
+}
+
+/*
+ *  MARK: inverse()
+ *
+ *  Decimation in time, the mirror image of forward(): small spans block by
+ *  block first, then the large spans over the whole array. Not scaled.
+ */
+static void inverse(ntt_plan const & plan, uint64_t * data) {
+
+  ntt_prime const & pr = *plan.prime;
+  uint64_t const p = pr.p;
+  size_t const n = plan.n;
+  size_t const block = std::min(n, NTT_BLOCK);
+
+  auto stage = [&](uint64_t * base, size_t len, size_t h_) {
+    uint64_t const * w = &plan.iroots[h_];
+    for (size_t s_ = 0; s_ < len; s_ += 2 * h_) {
+      uint64_t * lo = base + s_;
+      uint64_t * hi = lo + h_;
+      for (size_t j_ = 0; j_ < h_; ++j_) {
+        uint64_t u = lo[j_];
+        uint64_t v = mont_mul(hi[j_], w[j_], pr);
+        lo[j_] = add_mod(u, v, p);
+        hi[j_] = sub_mod(u, v, p);
+      }
+    }
+  };
+
+  for (size_t b_ = 0; b_ < n; b_ += block) {
+    for (size_t hb = 1; hb < block; hb <<= 1) {
+      stage(data + b_, block, hb);
+    }
+  }
+  for (size_t h_ = block; h_ < n; h_ <<= 1) {
+    stage(data, n, h_);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: transform()
+ *
+ *  out = lhs (*) rhs mod p, the cyclic convolution of length plan.n.
+ */
+static void transform(ntt_plan const & plan, std::vector<uint64_t> const & lhs,
+                      std::vector<uint64_t> const & rhs, std::vector<uint64_t> & out) {
+
+  ntt_prime const & pr = *plan.prime;
+  uint64_t const p = pr.p;
+  size_t const n = plan.n;
+  std::vector<uint64_t> fb(n, 0);
+
+  out.assign(n, 0);
+  for (size_t i_ = 0; i_ < lhs.size(); ++i_) {
+    out[i_] = lhs[i_] % p;
+  }
+  for (size_t i_ = 0; i_ < rhs.size(); ++i_) {
+    fb[i_] = rhs[i_] % p;
+  }
+  forward(plan, out.data());
+  forward(plan, fb.data());
+
+  //  pointwise product leaves a factor R^-1; the scale R^2 / n folds it and 1 / n out
+  for (size_t i_ = 0; i_ < n; ++i_) {
+    out[i_] = mont_mul(out[i_], fb[i_], pr);
+  }
+  inverse(plan, out.data());
+
+  uint64_t const scale = (uint64_t) ((uint128_t) pr.r2 * pow_mod(n % p, p - 2, p) % p);
+  for (size_t i_ = 0; i_ < n; ++i_) {
+    out[i_] = mont_mul(out[i_], scale, pr);
+  }
+
+  return;
+}
+
+/*
+ *  MARK: pack()
+ *
+ *  Base 10^9 limbs to base 10^18 coefficients.
+ */
+static std::vector<uint64_t> pack(bignum const & num) {
+
+  std::vector<uint64_t> coeffs((num.size() + 1) / 2, 0);
+  for (size_t i_ = 0; i_ < num.size(); ++i_) {
+    coeffs[i_ / 2] += (i_ & 1) ? (uint64_t) num[i_] * LIMB_BASE : num[i_];
+  }
+
+  return coeffs;
+}
+
+} /* namespace gfg */